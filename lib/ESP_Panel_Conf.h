@@ -223,7 +223,7 @@
 
 /* LCD Touch Other Settings */
 #define ESP_PANEL_LCD_TOUCH_IO_RST          (-1)
-#define ESP_PANEL_LCD_TOUCH_IO_INT          (-1)
+#define ESP_PANEL_LCD_TOUCH_IO_INT          (4)
 #define ESP_PANEL_LCD_TOUCH_RST_LEVEL       (0)
 #define ESP_PANEL_LCD_TOUCH_INT_LEVEL       (0)
 
@@ -60,10 +60,10 @@
     #endif
 
 #else       /*LV_MEM_CUSTOM*/
-    #define LV_MEM_CUSTOM_INCLUDE <stdlib.h>   /*Header for the dynamic memory function*/
-    #define LV_MEM_CUSTOM_ALLOC   malloc
-    #define LV_MEM_CUSTOM_FREE    free
-    #define LV_MEM_CUSTOM_REALLOC realloc
+    #define LV_MEM_CUSTOM_INCLUDE "src/lvgl_heap.h"   /*Size-class slabs in SRAM, large blocks in PSRAM (src/lvgl_heap.cpp)*/
+    #define LV_MEM_CUSTOM_ALLOC   lvgl_heap_alloc
+    #define LV_MEM_CUSTOM_FREE    lvgl_heap_free
+    #define LV_MEM_CUSTOM_REALLOC lvgl_heap_realloc
 #endif     /*LV_MEM_CUSTOM*/
 
 /*Number of the intermediate memory buffer used during rendering and other internal processing mechanisms.
@@ -0,0 +1,367 @@
+/*
+ * Per-AP detail screen implementation
+ *
+ * The screen is built once (lazily, like the other views) as a fixed grid of
+ * key/value labels and a sparkline; opening it for another BSSID only resets
+ * the model. Observations arrive over the UI bus from the scanner (full
+ * sweeps, and single-channel scans of just this BSSID while the screen is
+ * open, requested with a bus command once the AP's channel is known). In the
+ * LVGL task they only update the model and wake a timer running at the display
+ * refresh period, which copies the model into the value labels (touching only
+ * those whose text changed) and goes back to sleep. A burst of observations
+ * costs at most one redraw per frame and nothing is rebuilt.
+ */
+
+#include "ap_detail.h"
+#include "scan_snapshot.h"
+#include "ui_handlers.h"
+#include "ui_theme.h"
+#include "ui_bus.h"
+#include "config.h"
+#include <Arduino.h>
+#include <string.h>
+
+#define DETAIL_VALUE_TEXT_LEN 40
+#define DETAIL_ROW_HEIGHT 26
+#define DETAIL_KEY_WIDTH 150
+
+enum DetailField {
+    FIELD_BSSID,
+    FIELD_VENDOR,
+    FIELD_PHY,
+    FIELD_COUNTRY,
+    FIELD_CHANNEL,
+    FIELD_SECURITY,
+    FIELD_RSSI,
+    FIELD_RSSI_STATS,
+    FIELD_SAMPLES,
+    FIELD_LAST_SEEN,
+    FIELD_COUNT
+};
+
+static const char *field_names[FIELD_COUNT] = {
+    "BSSID", "Vendor", "PHY", "Country", "Channel", "Security",
+    "RSSI", "Min / Avg / Max", "Samples", "Last seen"
+};
+
+// Observations of the open BSSID
+struct ApDetailModel {
+    bool open;
+    uint8_t bssid[6];
+    SnapshotNetwork info;       // Latest record, described like the snapshot does
+    const char *vendor;
+    int8_t rssi_min;
+    int8_t rssi_max;
+    int32_t rssi_sum;
+    uint32_t samples;
+    uint32_t misses;            // Focused scans that did not hear the AP
+    uint32_t last_seen_ms;
+    bool dirty;                 // Model changed since the labels were last updated
+};
+
+static ApDetailModel model;
+static lv_coord_t spark_points[AP_DETAIL_SPARK_POINTS];
+static uint16_t spark_head = 0;
+static bool spark_dirty = false;
+
+static lv_obj_t *detail_container = NULL;
+static lv_obj_t *title_label = NULL;
+static lv_obj_t *value_labels[FIELD_COUNT];
+static char value_text[FIELD_COUNT][DETAIL_VALUE_TEXT_LEN];
+static char title_text[40];
+static lv_obj_t *spark_chart = NULL;
+static lv_chart_series_t *spark_series = NULL;
+static lv_timer_t *flush_timer = NULL;
+static uint8_t target_channel = 0;  // Channel last sent to the scanner for focused scans (0 = none)
+
+// Registered OUIs of common access point vendors (sorted for binary search)
+struct OuiEntry {
+    uint32_t oui;
+    const char *vendor;
+};
+
+static const OuiEntry oui_table[] = {
+    {0x00000C, "Cisco"},
+    {0x000393, "Apple"},
+    {0x00040E, "AVM"},
+    {0x00055D, "D-Link"},
+    {0x00095B, "Netgear"},
+    {0x000B86, "Aruba"},
+    {0x00146C, "Netgear"},
+    {0x0014BF, "Linksys"},
+    {0x00156D, "Ubiquiti"},
+    {0x00180A, "Cisco Meraki"},
+    {0x001882, "Huawei"},
+    {0x001A11, "Google"},
+    {0x001A1E, "Aruba"},
+    {0x001B11, "D-Link"},
+    {0x001B63, "Apple"},
+    {0x001D60, "ASUS"},
+    {0x002722, "Ubiquiti"},
+    {0x00E0FC, "Huawei"},
+    {0x0418D6, "Ubiquiti"},
+    {0x14CC20, "TP-Link"},
+    {0x1C7EE5, "D-Link"},
+    {0x240AC4, "Espressif"},
+    {0x246511, "AVM"},
+    {0x246F28, "Espressif"},
+    {0x24A43C, "Ubiquiti"},
+    {0x24DEC6, "Aruba"},
+    {0x2C56DC, "ASUS"},
+    {0x30AEA4, "Espressif"},
+    {0x3CA62F, "AVM"},
+    {0x50C7BF, "TP-Link"},
+    {0x640980, "Xiaomi"},
+    {0x802AA8, "Ubiquiti"},
+    {0x84F3EB, "Espressif"},
+    {0x881544, "Cisco Meraki"},
+    {0xA040A0, "Netgear"},
+    {0xA4CF12, "Espressif"},
+    {0xB827EB, "Raspberry Pi"},
+    {0xDCA632, "Raspberry Pi"},
+    {0xF09FC2, "Ubiquiti"},
+    {0xF4F5D8, "Google"},
+};
+
+// Vendor from the first three octets; randomized (locally administered) addresses have none
+static const char *lookupVendor(const uint8_t *bssid) {
+    if (bssid[0] & 0x02) return "Locally administered";
+    
+    uint32_t oui = ((uint32_t)bssid[0] << 16) | ((uint32_t)bssid[1] << 8) | bssid[2];
+    int lo = 0;
+    int hi = sizeof(oui_table) / sizeof(oui_table[0]) - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (oui_table[mid].oui == oui) return oui_table[mid].vendor;
+        if (oui_table[mid].oui < oui) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return "Unknown";
+}
+
+// Update one value label only if its text changed
+static void setValue(int field, const char *text) {
+    if (strcmp(value_text[field], text) == 0) return;
+    strncpy(value_text[field], text, DETAIL_VALUE_TEXT_LEN - 1);
+    value_text[field][DETAIL_VALUE_TEXT_LEN - 1] = '\0';
+    lv_label_set_text_static(value_labels[field], value_text[field]);
+}
+
+// Copy the model into the labels (at most once per display refresh), then sleep until the next observation
+static void flushTimerCb(lv_timer_t *timer) {
+    lv_timer_pause(timer);
+    if (detail_container == NULL || !model.open || !model.dirty) return;
+    model.dirty = false;
+    
+    char text[DETAIL_VALUE_TEXT_LEN];
+    
+    // Focused scans report misses too, so the age keeps moving while the AP is silent
+    if (model.samples > 0) {
+        snprintf(text, sizeof(text), "%lu s ago", (unsigned long)((millis() - model.last_seen_ms) / 1000));
+    } else {
+        snprintf(text, sizeof(text), "-");
+    }
+    setValue(FIELD_LAST_SEEN, text);
+    
+    const SnapshotNetwork *info = &model.info;
+    if (strcmp(title_text, info->ssid) != 0) {
+        snprintf(title_text, sizeof(title_text), "%s", info->ssid);
+        lv_label_set_text_static(title_label, title_text);
+    }
+    
+    snprintf(text, sizeof(text), "%02X:%02X:%02X:%02X:%02X:%02X",
+             model.bssid[0], model.bssid[1], model.bssid[2], model.bssid[3], model.bssid[4], model.bssid[5]);
+    setValue(FIELD_BSSID, text);
+    setValue(FIELD_VENDOR, model.vendor);
+    setValue(FIELD_PHY, info->phy_text[0] ? info->phy_text : "-");
+    setValue(FIELD_COUNTRY, info->country[0] ? info->country : "-");
+    
+    const char *secondary = "none";
+    if (info->second == WIFI_SECOND_CHAN_ABOVE) secondary = "above";
+    else if (info->second == WIFI_SECOND_CHAN_BELOW) secondary = "below";
+    snprintf(text, sizeof(text), "%s (%s, secondary %s)", info->channel_text, info->width_text, secondary);
+    setValue(FIELD_CHANNEL, text);
+    setValue(FIELD_SECURITY, info->security_text);
+    
+    if (model.samples > 0) {
+        snprintf(text, sizeof(text), "%s dBm", info->rssi_text);
+        setValue(FIELD_RSSI, text);
+        snprintf(text, sizeof(text), "%d / %ld / %d dBm", model.rssi_min,
+                 (long)(model.rssi_sum / (int32_t)model.samples), model.rssi_max);
+        setValue(FIELD_RSSI_STATS, text);
+    } else {
+        setValue(FIELD_RSSI, "-");
+        setValue(FIELD_RSSI_STATS, "-");
+    }
+    snprintf(text, sizeof(text), "%lu (%lu missed)", (unsigned long)model.samples, (unsigned long)model.misses);
+    setValue(FIELD_SAMPLES, text);
+    
+    // The sparkline reads its ring in place; redraw it once for however many samples arrived
+    if (spark_dirty && spark_chart) {
+        spark_dirty = false;
+        lv_chart_refresh(spark_chart);
+    }
+}
+
+// Create the label grid and sparkline (call with the LVGL lock held)
+lv_obj_t *apDetailViewCreate(lv_obj_t *parent) {
+    detail_container = lv_obj_create(parent);
+    lv_obj_add_style(detail_container, &ui_style_view, LV_PART_MAIN);
+    lv_obj_add_style(detail_container, &ui_style_page, LV_PART_MAIN);
+    lv_obj_clear_flag(detail_container, LV_OBJ_FLAG_SCROLLABLE);
+    
+    // Back to the table the screen was opened from
+    lv_obj_t *back_btn = lv_btn_create(detail_container);
+    lv_obj_add_style(back_btn, &ui_style_menu_btn, LV_PART_MAIN);
+    lv_obj_set_size(back_btn, 90, 32);
+    lv_obj_align(back_btn, LV_ALIGN_TOP_RIGHT, 0, 0);
+    lv_obj_t *back_label = lv_label_create(back_btn);
+    lv_label_set_text(back_label, LV_SYMBOL_LEFT " Back");
+    lv_obj_center(back_label);
+    lv_obj_add_event_cb(back_btn, switchToTableView, LV_EVENT_CLICKED, NULL);
+    
+    title_text[0] = '\0';
+    title_label = lv_label_create(detail_container);
+    lv_obj_add_style(title_label, &ui_style_title, LV_PART_MAIN);
+    lv_label_set_text_static(title_label, title_text);
+    lv_obj_align(title_label, LV_ALIGN_TOP_LEFT, 0, 6);
+    
+    for (int f = 0; f < FIELD_COUNT; f++) {
+        int y = 44 + f * DETAIL_ROW_HEIGHT;
+        
+        lv_obj_t *key = lv_label_create(detail_container);
+        lv_obj_add_style(key, &ui_style_caption, LV_PART_MAIN);
+        lv_label_set_text_static(key, field_names[f]);
+        lv_obj_set_pos(key, 0, y);
+        
+        value_text[f][0] = '\0';
+        value_labels[f] = lv_label_create(detail_container);
+        lv_obj_add_style(value_labels[f], &ui_style_table_cell, LV_PART_MAIN);
+        lv_label_set_long_mode(value_labels[f], LV_LABEL_LONG_CLIP);
+        lv_label_set_text_static(value_labels[f], value_text[f]);
+        lv_obj_set_width(value_labels[f], INFO_WINDOW_WIDTH - 40 - DETAIL_KEY_WIDTH);
+        lv_obj_set_pos(value_labels[f], DETAIL_KEY_WIDTH, y);
+    }
+    
+    // Sparkline: the last AP_DETAIL_SPARK_POINTS observations, read in place in circular mode
+    spark_chart = lv_chart_create(detail_container);
+    lv_obj_set_size(spark_chart, INFO_WINDOW_WIDTH - 40, INFO_WINDOW_HEIGHT - 40 - 50 - FIELD_COUNT * DETAIL_ROW_HEIGHT);
+    lv_obj_align(spark_chart, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+    lv_chart_set_type(spark_chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_update_mode(spark_chart, LV_CHART_UPDATE_MODE_CIRCULAR);
+    lv_chart_set_point_count(spark_chart, AP_DETAIL_SPARK_POINTS);
+    lv_chart_set_range(spark_chart, LV_CHART_AXIS_PRIMARY_Y, RSSI_MIN, RSSI_MAX);
+    lv_chart_set_div_line_count(spark_chart, 0, 0);
+    lv_obj_set_style_bg_color(spark_chart, lv_color_hex(0x000000), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(spark_chart, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_set_style_border_color(spark_chart, lv_color_hex(0x444444), LV_PART_MAIN);
+    lv_obj_set_style_line_width(spark_chart, 2, LV_PART_ITEMS);
+    lv_obj_set_style_size(spark_chart, 0, LV_PART_INDICATOR);  // No point markers
+    spark_series = lv_chart_add_series(spark_chart, lv_color_hex(0x4fc3f7), LV_CHART_AXIS_PRIMARY_Y);
+    lv_chart_set_ext_y_array(spark_chart, spark_series, spark_points);
+    
+    flush_timer = lv_timer_create(flushTimerCb, LV_DISP_DEF_REFR_PERIOD, NULL);
+    lv_timer_pause(flush_timer);
+    
+    // Initially hidden (graph is default view)
+    lv_obj_add_flag(detail_container, LV_OBJ_FLAG_HIDDEN);
+    
+    return detail_container;
+}
+
+// Forget the widgets before the view is deleted
+void apDetailViewDetach() {
+    if (flush_timer) lv_timer_del(flush_timer);
+    flush_timer = NULL;
+    detail_container = NULL;
+    title_label = NULL;
+    spark_chart = NULL;
+    spark_series = NULL;
+    for (int f = 0; f < FIELD_COUNT; f++) {
+        value_labels[f] = NULL;
+    }
+}
+
+// Ask the scanner for focused scans once the channel is known, and again if the AP moves
+static void sendTarget() {
+    if (!model.open || model.info.channel == 0 || model.info.channel == target_channel) return;
+    target_channel = model.info.channel;
+    uiBusSendCommand(SCAN_CMD_DETAIL_OPEN, target_channel, model.bssid);
+}
+
+// Start following a BSSID, seeded from the latest snapshot (call with the LVGL lock held)
+void apDetailOpen(const uint8_t *bssid) {
+    memset(&model, 0, sizeof(model));
+    memcpy(model.bssid, bssid, 6);
+    model.vendor = lookupVendor(bssid);
+    strcpy(model.info.channel_text, "-");
+    strcpy(model.info.rssi_text, "-");
+    model.info.width_text = "-";
+    model.info.security_text = "-";
+    
+    const ScanSnapshot *snapshot = scanSnapshotGet();
+    for (uint16_t i = 0; i < snapshot->count; i++) {
+        if (memcmp(snapshot->networks[i].bssid, bssid, 6) == 0) {
+            model.info = snapshot->networks[i];
+            break;
+        }
+    }
+    
+    for (int i = 0; i < AP_DETAIL_SPARK_POINTS; i++) {
+        spark_points[i] = LV_CHART_POINT_NONE;
+    }
+    spark_head = 0;
+    spark_dirty = true;
+    
+    model.dirty = true;
+    model.open = true;
+    target_channel = 0;
+    sendTarget();
+    if (flush_timer) {
+        lv_timer_resume(flush_timer);
+        lv_timer_ready(flush_timer);  // Fill the labels on the next handler run
+    }
+}
+
+// Stop following (the screen was hidden); focused scans stop with it
+void apDetailClose() {
+    if (model.open) uiBusSendCommand(SCAN_CMD_DETAIL_CLOSE, 0, NULL);
+    model.open = false;
+    target_channel = 0;
+    if (flush_timer) lv_timer_pause(flush_timer);
+}
+
+// Record one observation per scan: the AP's record, or a miss if it was not heard (LVGL task)
+void apDetailObserve(const wifi_ap_record_t *ap_records, uint16_t ap_count) {
+    if (!model.open) return;
+    
+    const wifi_ap_record_t *rec = NULL;
+    for (uint16_t i = 0; i < ap_count; i++) {
+        if (memcmp(ap_records[i].bssid, model.bssid, 6) == 0) {
+            rec = &ap_records[i];
+            break;
+        }
+    }
+    
+    if (rec) {
+        scanSnapshotDescribe(rec, &model.info);
+        if (model.samples == 0 || rec->rssi < model.rssi_min) model.rssi_min = rec->rssi;
+        if (model.samples == 0 || rec->rssi > model.rssi_max) model.rssi_max = rec->rssi;
+        model.rssi_sum += rec->rssi;
+        model.samples++;
+        model.last_seen_ms = millis();
+    } else {
+        model.misses++;
+    }
+    
+    // Sample (or gap) at the head, gap after it marks "now"
+    spark_points[spark_head] = rec ? rec->rssi : LV_CHART_POINT_NONE;
+    spark_head = (spark_head + 1) % AP_DETAIL_SPARK_POINTS;
+    spark_points[spark_head] = LV_CHART_POINT_NONE;
+    spark_dirty = true;
+    model.dirty = true;
+    if (flush_timer) lv_timer_resume(flush_timer);
+    
+    // The first sighting tells the scanner which channel to sample
+    sendTarget();
+}
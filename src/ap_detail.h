@@ -0,0 +1,18 @@
+/*
+ * Per-AP detail screen (opened by tapping a table row)
+ */
+
+#ifndef AP_DETAIL_H
+#define AP_DETAIL_H
+
+#include <lvgl.h>
+#include "esp_wifi.h"
+
+// Functions
+lv_obj_t *apDetailViewCreate(lv_obj_t *parent);
+void apDetailViewDetach();
+void apDetailOpen(const uint8_t *bssid);
+void apDetailClose();
+void apDetailObserve(const wifi_ap_record_t *ap_records, uint16_t ap_count);
+
+#endif // AP_DETAIL_H
@@ -0,0 +1,91 @@
+/*
+ * Boot timeline trace implementation
+ *
+ * Until the first frame is on screen, events are only recorded (printing from
+ * setup() would itself slow the boot down); the whole timeline is printed at
+ * once by bootTraceDump(). After that every event is printed as it happens,
+ * which covers views being created on first navigation and destroyed after
+ * being hidden for a while. Each event carries the free heap so the resident
+ * cost of what was built can be read off the same line.
+ */
+
+#include "boot_trace.h"
+#include "config.h"
+#include <Arduino.h>
+#include "esp_heap_caps.h"
+
+#if BOOT_TRACE
+struct BootTraceEvent {
+    const char *event;
+    uint32_t us;          // Time since boot
+    uint32_t span_us;     // Duration for spans, 0 for marks
+    size_t free_heap;
+    long heap_delta;      // Heap consumed by a span (negative = released)
+};
+
+static BootTraceEvent trace_events[BOOT_TRACE_MAX_EVENTS];
+static uint16_t trace_count = 0;
+static uint16_t trace_dropped = 0;
+static bool trace_live = false;  // Boot timeline printed, print events as they happen
+
+static size_t freeHeap() {
+    return heap_caps_get_free_size(MALLOC_CAP_8BIT);
+}
+
+static void printEvent(const BootTraceEvent *ev) {
+    if (ev->span_us > 0 || ev->heap_delta != 0) {
+        printf("Trace %9lu us  heap %7u  %-24s %7lu us, %+ld bytes\r\n", (unsigned long)ev->us,
+               (unsigned)ev->free_heap, ev->event, (unsigned long)ev->span_us, ev->heap_delta);
+    } else {
+        printf("Trace %9lu us  heap %7u  %s\r\n", (unsigned long)ev->us, (unsigned)ev->free_heap, ev->event);
+    }
+}
+
+static void record(const char *event, uint32_t span_us, long heap_delta) {
+    BootTraceEvent ev = {event, micros(), span_us, freeHeap(), heap_delta};
+    if (trace_live) {
+        printEvent(&ev);
+    } else if (trace_count < BOOT_TRACE_MAX_EVENTS) {
+        trace_events[trace_count++] = ev;
+    } else {
+        trace_dropped++;
+    }
+}
+#endif
+
+// Record a point in the timeline
+void bootTraceMark(const char *event) {
+#if BOOT_TRACE
+    record(event, 0, 0);
+#endif
+}
+
+void bootTraceBegin(BootTraceSpan *span) {
+#if BOOT_TRACE
+    span->start_us = micros();
+    span->start_heap = freeHeap();
+#endif
+}
+
+// Record a span started with bootTraceBegin (duration and heap it consumed)
+void bootTraceEnd(const char *event, const BootTraceSpan *span) {
+#if BOOT_TRACE
+    record(event, micros() - span->start_us, (long)span->start_heap - (long)freeHeap());
+#endif
+}
+
+// Print the recorded boot timeline; later events are printed immediately
+void bootTraceDump() {
+#if BOOT_TRACE
+    if (trace_live) return;
+    printf("---- Boot timeline ----\r\n");
+    for (uint16_t i = 0; i < trace_count; i++) {
+        printEvent(&trace_events[i]);
+    }
+    if (trace_dropped > 0) {
+        printf("(%u events dropped, raise BOOT_TRACE_MAX_EVENTS)\r\n", trace_dropped);
+    }
+    printf("-----------------------\r\n");
+    trace_live = true;
+#endif
+}
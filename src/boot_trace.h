@@ -0,0 +1,23 @@
+/*
+ * Boot timeline trace (time and free heap at named points)
+ */
+
+#ifndef BOOT_TRACE_H
+#define BOOT_TRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Start of a measured span (e.g. creating a view)
+struct BootTraceSpan {
+    uint32_t start_us;
+    size_t start_heap;
+};
+
+// Functions
+void bootTraceMark(const char *event);
+void bootTraceBegin(BootTraceSpan *span);
+void bootTraceEnd(const char *event, const BootTraceSpan *span);
+void bootTraceDump();
+
+#endif // BOOT_TRACE_H
@@ -22,17 +22,83 @@
 
 // LVGL porting configurations
 #define LVGL_TICK_PERIOD_MS     (2)
-#define LVGL_TASK_MAX_DELAY_MS  (500)
+#define LVGL_TASK_MAX_DELAY_MS  (1000)   // Longest sleep without an event (safety net for timers started outside the LVGL task)
 #define LVGL_TASK_MIN_DELAY_MS  (1)
 #define LVGL_TASK_STACK_SIZE    (4 * 1024)
 #define LVGL_TASK_PRIORITY      (2)
-#define LVGL_BUF_SIZE           (ESP_PANEL_LCD_H_RES * 20)
+#define LVGL_BUF_LINES          (20)    // Lines per partial draw buffer
+#define LVGL_BUF_SIZE           (ESP_PANEL_LCD_H_RES * LVGL_BUF_LINES)
+#define LVGL_BUF_DOUBLE         (1)     // 1: two internal-RAM buffers, render next strip while the previous one is flushed
+#define LVGL_FLUSH_TASK_STACK_SIZE (3 * 1024)
+#define LVGL_FLUSH_TASK_PRIORITY   (LVGL_TASK_PRIORITY + 1)
+#define LVGL_FLUSH_QUEUE_LEN    (2)
+#define LVGL_FLUSH_TIMEOUT_MS   (100)   // Longest wait for a strip to reach the panel before LVGL re-checks
+#define LVGL_BUF_BENCHMARK      (0)     // 1: measure frame time for several buffer sizes at boot
+#define LVGL_BENCHMARK_FRAMES   (10)    // Full-screen redraws averaged per benchmark configuration
+
+// Scanner <-> UI message queues (the scanner never takes the LVGL lock)
+#define UI_BUS_EVENT_QUEUE_LEN      4       // Scan results waiting for the LVGL task
+#define UI_BUS_COMMAND_QUEUE_LEN    8       // AP detail open/close commands waiting for the scanner (settings are coalesced)
+#define UI_BUS_RECORDS_WAIT_MS      2000    // Longest wait for the UI to finish with the previous results
+
+// LVGL heap (LV_MEM_CUSTOM in lib/lv_conf.h): small size classes from SRAM slabs, larger blocks from PSRAM
+#define LVGL_HEAP_SLABS             1       // 0: every block from the large-block path
+#define LVGL_HEAP_SLAB_SIZE         4096    // Bytes per slab (power of two, slabs are aligned to it)
+#define LVGL_HEAP_SRAM_BUDGET       (64 * 1024) // Internal SRAM for slabs; spare empty slabs are reclaimed before small blocks go to the large path
+#define LVGL_HEAP_LARGE_IN_PSRAM    1       // 0: large blocks from internal SRAM as well
+#ifndef LVGL_HEAP_TRACE
+#define LVGL_HEAP_TRACE             0       // 1: allocation trace recording and soak test (set by the native build)
+#endif
+#define LVGL_HEAP_SOAK_DAYS         7       // Simulated uptime of the host soak test
+#define LVGL_HEAP_SOAK_SWEEP_MS     17000   // Sweep length it assumes (default dwell x 14 channels + SCAN_INTERVAL_MS)
+#define LVGL_HEAP_SOAK_MAX_GROWTH_KB 16     // Most the heap may hold at the end beyond what it held after day 1
+
+// LVGL lock profiler (wait and hold time per lvgl_port_lock() call site, "lock" on the serial console)
+#define LOCK_PROFILE                1       // 0: compile the profiler out
+#define LOCK_PROFILE_MAX_SITES      24      // Call sites tracked (the last entry collects any beyond that)
+
+// Performance monitor (render, flush, area, FPS, CPU and scan histograms, "perf" on the serial console)
+#define PERF_MONITOR                1       // 0: compile the monitor out
+#define PERF_WINDOW_MS              1000    // FPS and LVGL CPU share are measured over windows this long
+#define PERF_OVERLAY                0       // 1: show the on-screen overlay from boot ("perf overlay" toggles it)
+#define PERF_DUMP_PERIOD_MS         0       // Print the histograms this often (0 = on request only, "perf every N" changes it)
+
+// Latency probe (touch interrupt to the redrawn area on the panel, "latency on" on the serial console)
+#define LATENCY_PROBE               1       // 0: compile the probe out (it is off at runtime until enabled)
+#define LATENCY_PROBE_SAMPLES       64      // Percentiles are over the last this many presses and releases each
+#define LATENCY_PROBE_TIMEOUT_MS    1000    // A touch whose redraw has not reached the panel by then is dropped
+
+// Stack and heap telemetry ("telemetry" on the serial console, Diagnostics button in the settings view)
+#define TELEMETRY                   1       // 0: sample only when the "telemetry" command asks
+#define TELEMETRY_PERIOD_MS         5000    // Sampling period (each sample scans every task's stack)
+#define TELEMETRY_STACK_ALARM_BYTES 512     // Alarm when a task has come within this many bytes of its stack end
+#define TELEMETRY_MAX_TASKS         32      // Tasks a sample can list (none are sampled when more are running)
+#define TELEMETRY_INTERNAL_FREE_ALARM  (24 * 1024)  // Alarm when free internal RAM drops below this
+#define TELEMETRY_INTERNAL_BLOCK_ALARM (8 * 1024)   // ... or its largest free block does
+#define TELEMETRY_PSRAM_FREE_ALARM     (256 * 1024) // Alarm when free PSRAM drops below this
+
+// Serial console (type "help" in the serial monitor)
+#define SERIAL_CONSOLE_LINE_LEN     64      // Longest command line
+#define SERIAL_CONSOLE_POLL_MS      50      // How often input is checked
+#define SERIAL_CONSOLE_TASK_STACK_SIZE (4 * 1024)
+#define SERIAL_CONSOLE_TASK_PRIORITY   (1)
+
+// Idle governor (no touch for a while: slower refresh and scanning, dimmer backlight)
+#define IDLE_GOVERNOR               1       // 0: always run at full speed and brightness
+#define IDLE_THROTTLE_MS            30000   // Untouched this long: throttle and dim
+#define IDLE_OFF_MS                 300000  // Untouched this long: backlight off (0 = never)
+#define IDLE_REFR_PERIOD_MS         100     // Display refresh period while idle (LV_DISP_DEF_REFR_PERIOD when active)
+#define IDLE_TASK_MIN_DELAY_MS      50      // Shortest LVGL task sleep while idle (a touch still wakes it at once)
+#define IDLE_SCAN_INTERVAL_MS       30000   // Pause between sweeps while idle (SCAN_INTERVAL_MS when active, max 65535)
+#define IDLE_DIM_PERCENT            20      // Backlight while idle; needs a PWM backlight (the CH422G pin can only switch it)
+#define IDLE_MIN_CHECK_MS           100     // Shortest re-check period of the governor timer
 
 // UI Layout dimensions
 #define INFO_WINDOW_WIDTH 640     // Left region: information window
 #define INFO_WINDOW_HEIGHT 480
 #define MENU_BAR_WIDTH 160         // Right region: menu bar
 #define MENU_BAR_HEIGHT 480
+#define MENU_BUTTON_COUNT 8       // Buttons stacked in the menu bar
 
 // Graph dimensions (within info window)
 #define GRAPH_CANVAS_WIDTH INFO_WINDOW_WIDTH
@@ -47,6 +113,96 @@
 #define CHANNEL_MIN -1
 #define CHANNEL_MAX 15
 
+// Graph pinch-zoom and two-finger pan
+#define TOUCH_MAX_POINTS            5       // Touch points read per sample (GT911 reports up to five)
+#define TOUCH_IRQ_RELEASE_MS        100     // While pressed, re-read the GT911 after this long without an interrupt (lost release)
+#define GRAPH_MIN_CHANNEL_SPAN      2.0f    // Deepest horizontal zoom in channels
+#define GRAPH_MIN_RSSI_SPAN         10.0f   // Deepest vertical zoom in dB
+#define GESTURE_MIN_AXIS_PX         40      // Finger spread along an axis before that axis zooms
+#define GESTURE_SETTLE_MS           150     // Quiet time after a gesture before the background cache is re-rendered
+#define GESTURE_DOUBLE_TAP_MS       300     // Double-tap on the plot resets the zoom
+#define GESTURE_THROW_MIN_PX_S      150     // Pan speed at lift-off (touch filter velocity) that throws the view on
+#define GESTURE_THROW_STOP_PX_S     20      // A throw stops below this speed
+#define GESTURE_THROW_DECAY_PCT     8       // Speed a throw loses per step
+#define GESTURE_THROW_PERIOD_MS     20      // Step period of a throw
+
+// Touch filtering (one-euro low-pass on every point, applied in the touch driver)
+#define TOUCH_FILTER_ENABLE         1       // 0: pass raw controller coordinates through
+#define TOUCH_DEBOUNCE_READS        2       // Consecutive reads a new press must appear in before it is reported
+#define TOUCH_FILTER_MIN_CUTOFF_MHZ 1000    // Cutoff at rest in mHz (lower = steadier hold)
+#define TOUCH_FILTER_BETA           50      // Cutoff added per px/s of speed in mHz (higher = less lag when moving)
+#define TOUCH_FILTER_D_CUTOFF_MHZ   4000    // Cutoff of the velocity estimate in mHz
+#define TOUCH_FILTER_BENCHMARK      0       // 1: replay synthetic touch traces through the filter at boot
+
+// Graph transition animation (morph from the previous sweep to the new one)
+#define GRAPH_ANIM_DURATION_MS      400     // 0 = jump straight to the new geometry
+#define GRAPH_ANIM_MIN_PERIOD_MS    30      // Fastest animation frame period
+#define GRAPH_ANIM_MAX_PERIOD_MS    240     // Slowest animation frame period under load
+#define GRAPH_FRAME_BUDGET_US       20000   // Graph render time allowed per animation frame
+
+// Graph render quality tiers (full > outline + labels > outline > bars)
+#define QUALITY_FRAME_BUDGET_US     30000   // Rolling graph frame time above this drops one tier
+#define QUALITY_UPGRADE_US          8000    // ...and below this (sustained) restores one tier
+#define QUALITY_SETTLE_FRAMES       4       // Frames measured after a change before deciding again
+#define QUALITY_UPGRADE_FRAMES      30      // Consecutive fast frames needed to restore a tier
+#define QUALITY_FULL_MAX_NETWORKS   24      // Visible networks allowed per tier
+#define QUALITY_LABELS_MAX_NETWORKS 40
+#define QUALITY_OUTLINE_MAX_NETWORKS 56
+#define QUALITY_COUNT_HYSTERESIS    4       // Networks below a limit before the better tier returns
+
+// Waterfall view (time vertical, channel horizontal, shares the graph's plot area)
+#define WATERFALL_ROW_HEIGHT        4       // Pixel lines per sweep
+#define WATERFALL_ROWS              (GRAPH_HEIGHT / WATERFALL_ROW_HEIGHT)
+#define WATERFALL_SUM_POWER         0       // 0: strongest RSSI per channel bin, 1: summed power
+
+// Pre-rendered SSID label bitmaps (RGB565 + alpha, in PSRAM)
+#define LABEL_CACHE_ENTRIES         64      // Cached label bitmaps (LRU)
+#define LABEL_CACHE_MAX_WIDTH       200     // Widest cached label in pixels (wider labels are drawn directly)
+#define LABEL_CACHE_MAX_HEIGHT      16      // Tallest cached label in pixels
+
+// SSID label placement (collision grid over the graph)
+#define LABEL_GRID_CELL_WIDTH       64      // Bucket width in pixels
+#define LABEL_GRID_CELL_HEIGHT      16      // Bucket height in pixels
+#define LABEL_GRID_CELL_CAPACITY    8       // Labels tracked per bucket (a full bucket counts as occupied)
+#define LABEL_MAX_BADGES            16      // "+N" badges for labels that could not be placed
+#define LABEL_LAYOUT_BENCHMARK      0       // 1: time the layout pass for 256 synthetic networks at boot
+#define LABEL_LAYOUT_BUDGET_US      1000    // Longest layout pass the benchmark accepts for 256 networks
+
+// Shared UI styles
+#define UI_THEME_BENCHMARK          0       // 1: compare heap and redraw cost of local vs shared styles at boot
+
+// Dashboard (shorter graph above the strongest networks, both fed from the same scan snapshot)
+#define DASHBOARD_GRAPH_HEIGHT      280     // Graph height on the dashboard (the plot shrinks by the difference)
+#define DASHBOARD_TABLE_ROWS        6       // Networks listed under the graph
+#define DASHBOARD_ROW_HEIGHT        28      // Row pitch in pixels
+
+// Secondary views (table, waterfall, history, settings) are built on first navigation
+#define VIEW_DESTROY_AFTER_MS       120000  // Free a view hidden this long (0 = keep views once built)
+#define VIEW_REAPER_PERIOD_MS       5000    // How often hidden views are checked
+
+// Boot timeline trace (printed once the first frame is rendered)
+#define BOOT_TRACE                  1       // 0: compile the trace out
+#define BOOT_TRACE_MAX_EVENTS       32      // Events kept until the first frame
+
+// Virtualized table view (fixed pool of row widgets recycled while scrolling)
+#ifndef TABLE_MAX_ROWS
+#define TABLE_MAX_ROWS              64      // Networks the table can list (a sweep returns at most 64; the native build uses 512)
+#endif
+#define TABLE_ROW_HEIGHT            32      // Row pitch in pixels
+#define TABLE_OVERSCAN_ROWS         3       // Extra rows kept bound above and below the viewport
+#define TABLE_SCROLL_BUDGET_US      1000    // Longest one-row scroll step the table benchmark accepts
+#define TABLE_BENCHMARK_ROWS        500     // Rows the host table benchmark lists
+#define TABLE_POOL_ROWS             ((INFO_WINDOW_HEIGHT - 30) / TABLE_ROW_HEIGHT + 1 + 2 * TABLE_OVERSCAN_ROWS)
+
+// AP detail screen (tap a table row)
+#define AP_DETAIL_SCAN_TIME_MS      120     // Dwell of the single-channel scans of that AP while the screen is open
+#define AP_DETAIL_SPARK_POINTS      120     // Observations shown in the sparkline
+
+// RSSI history chart for pinned networks
+#define HISTORY_MAX_PINNED          8       // BSSIDs that can be pinned at once
+#define HISTORY_POINTS              240     // Samples kept per pinned BSSID (one per sweep)
+#define HISTORY_VISIBLE_POINTS      60      // Samples visible without scrolling
+
 #endif // CONFIG_H
 
 
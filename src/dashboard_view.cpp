@@ -0,0 +1,121 @@
+/*
+ * Compact top-N network list implementation
+ *
+ * The dashboard puts a shorter graph above the DASHBOARD_TABLE_ROWS strongest
+ * networks. Both halves read the same published scan snapshot, so the list
+ * only copies strings the snapshot has already formatted. Like the full
+ * table, every cell owns the buffer its label displays and is only touched
+ * when the text changes, so a quiet sweep costs a few string compares.
+ */
+
+#include "dashboard_view.h"
+#include "ui_theme.h"
+#include "config.h"
+#include <string.h>
+
+#define DASHBOARD_COLUMNS 4
+#define DASHBOARD_CELL_TEXT_LEN 34
+#define DASHBOARD_HEADER_HEIGHT 24
+
+static const lv_coord_t dashboard_col_widths[DASHBOARD_COLUMNS] = {300, 60, 80, 190};
+static const char *dashboard_col_titles[DASHBOARD_COLUMNS] = {"Strongest networks", "Ch", "RSSI", "Security"};
+
+// A row of labels and the text they currently display
+struct DashboardRow {
+    lv_obj_t *row;
+    lv_obj_t *cells[DASHBOARD_COLUMNS];
+    char text[DASHBOARD_COLUMNS][DASHBOARD_CELL_TEXT_LEN];
+};
+
+static lv_obj_t *dashboard_container = NULL;
+static DashboardRow dashboard_rows[DASHBOARD_TABLE_ROWS];
+
+// Update one cell only if its text changed
+static void setCell(DashboardRow *row, int col, const char *text) {
+    if (strcmp(row->text[col], text) == 0) return;
+    strncpy(row->text[col], text, DASHBOARD_CELL_TEXT_LEN - 1);
+    row->text[col][DASHBOARD_CELL_TEXT_LEN - 1] = '\0';
+    lv_label_set_text_static(row->cells[col], row->text[col]);
+}
+
+// Create the header and the fixed rows (call with the LVGL lock held)
+lv_obj_t *dashboardViewCreate(lv_obj_t *parent) {
+    dashboard_container = lv_obj_create(parent);
+    lv_obj_add_style(dashboard_container, &ui_style_view, LV_PART_MAIN);
+    lv_obj_clear_flag(dashboard_container, LV_OBJ_FLAG_SCROLLABLE);
+    
+    lv_obj_t *header = lv_obj_create(dashboard_container);
+    lv_obj_set_size(header, INFO_WINDOW_WIDTH, DASHBOARD_HEADER_HEIGHT);
+    lv_obj_align(header, LV_ALIGN_TOP_LEFT, 0, 0);
+    lv_obj_add_style(header, &ui_style_bar, LV_PART_MAIN);
+    lv_obj_set_style_pad_ver(header, 0, LV_PART_MAIN);
+    lv_obj_clear_flag(header, LV_OBJ_FLAG_SCROLLABLE);
+    
+    lv_coord_t x = 0;
+    for (int c = 0; c < DASHBOARD_COLUMNS; c++) {
+        lv_obj_t *label = lv_label_create(header);
+        lv_label_set_text_static(label, dashboard_col_titles[c]);
+        lv_obj_add_style(label, &ui_style_header_label, LV_PART_MAIN);
+        lv_obj_set_style_pad_ver(label, 2, LV_PART_MAIN);
+        lv_obj_set_width(label, dashboard_col_widths[c]);
+        lv_obj_align(label, LV_ALIGN_LEFT_MID, x, 0);
+        x += dashboard_col_widths[c];
+    }
+    
+    for (int r = 0; r < DASHBOARD_TABLE_ROWS; r++) {
+        DashboardRow *row = &dashboard_rows[r];
+        row->row = lv_obj_create(dashboard_container);
+        lv_obj_remove_style_all(row->row);
+        lv_obj_add_style(row->row, &ui_style_table_row, LV_PART_MAIN);
+        lv_obj_set_size(row->row, INFO_WINDOW_WIDTH, DASHBOARD_ROW_HEIGHT);
+        lv_obj_set_pos(row->row, 0, DASHBOARD_HEADER_HEIGHT + r * DASHBOARD_ROW_HEIGHT);
+        lv_obj_clear_flag(row->row, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_clear_flag(row->row, LV_OBJ_FLAG_CLICKABLE);
+        
+        x = 0;
+        for (int c = 0; c < DASHBOARD_COLUMNS; c++) {
+            row->text[c][0] = '\0';
+            row->cells[c] = lv_label_create(row->row);
+            lv_obj_add_style(row->cells[c], &ui_style_table_cell, LV_PART_MAIN);
+            lv_label_set_long_mode(row->cells[c], LV_LABEL_LONG_CLIP);
+            lv_label_set_text_static(row->cells[c], row->text[c]);
+            lv_obj_set_width(row->cells[c], dashboard_col_widths[c]);
+            lv_obj_align(row->cells[c], LV_ALIGN_LEFT_MID, x + 4, 0);
+            x += dashboard_col_widths[c];
+        }
+    }
+    
+    // Show the latest sweep straight away (the view can be built long after boot)
+    dashboardViewUpdate(scanSnapshotGet());
+    
+    return dashboard_container;
+}
+
+// Forget the widgets before the view is deleted
+void dashboardViewDetach() {
+    dashboard_container = NULL;
+    for (int r = 0; r < DASHBOARD_TABLE_ROWS; r++) {
+        dashboard_rows[r].row = NULL;
+    }
+}
+
+// Show the strongest networks of a published snapshot (call with the LVGL lock held)
+void dashboardViewUpdate(const ScanSnapshot *snapshot) {
+    if (dashboard_container == NULL) return;
+    
+    // The snapshot is already ordered strongest first
+    for (int r = 0; r < DASHBOARD_TABLE_ROWS; r++) {
+        DashboardRow *row = &dashboard_rows[r];
+        if (r >= snapshot->count) {
+            if (!lv_obj_has_flag(row->row, LV_OBJ_FLAG_HIDDEN)) lv_obj_add_flag(row->row, LV_OBJ_FLAG_HIDDEN);
+            continue;
+        }
+        if (lv_obj_has_flag(row->row, LV_OBJ_FLAG_HIDDEN)) lv_obj_clear_flag(row->row, LV_OBJ_FLAG_HIDDEN);
+        
+        const SnapshotNetwork *net = &snapshot->networks[r];
+        setCell(row, 0, net->ssid);
+        setCell(row, 1, net->channel_text);
+        setCell(row, 2, net->rssi_text);
+        setCell(row, 3, net->security_text);
+    }
+}
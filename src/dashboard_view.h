@@ -0,0 +1,16 @@
+/*
+ * Compact top-N network list shown under the graph on the dashboard
+ */
+
+#ifndef DASHBOARD_VIEW_H
+#define DASHBOARD_VIEW_H
+
+#include <lvgl.h>
+#include "scan_snapshot.h"
+
+// Functions
+lv_obj_t *dashboardViewCreate(lv_obj_t *parent);
+void dashboardViewDetach();
+void dashboardViewUpdate(const ScanSnapshot *snapshot);
+
+#endif // DASHBOARD_VIEW_H
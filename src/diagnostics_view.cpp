@@ -0,0 +1,180 @@
+/*
+ * Diagnostics screen implementation
+ *
+ * Shows the latest telemetry sample as two tables: the internal and PSRAM
+ * heaps (free, largest block, lowest free since boot, total) and every task's
+ * stack, tightest first, with the configured size and peak use for the tasks
+ * this firmware creates. Rows in alarm are drawn in red. A timer checks for a
+ * new sample once a second while the view is visible and the tables are only
+ * rewritten when one has arrived, so an open diagnostics screen redraws about
+ * once per TELEMETRY_PERIOD_MS.
+ */
+
+#include "diagnostics_view.h"
+#include "telemetry.h"
+#include "ui_theme.h"
+#include "config.h"
+#include <stdio.h>
+
+#define DIAG_COLUMNS 5
+#define DIAG_CHECK_MS 1000
+#define DIAG_ALARM_COLOR 0xe57373
+#define DIAG_ALARM_CTRL LV_TABLE_CELL_CTRL_CUSTOM_1     // Set on column 0 of a row in alarm
+
+// Both tables span the page (the view has ui_style_page padding on each side)
+static const lv_coord_t diag_col_width = (INFO_WINDOW_WIDTH - 40) / DIAG_COLUMNS;
+static const char *heap_titles[DIAG_COLUMNS] = {"Heap", "Free", "Largest block", "Lowest free", "Total"};
+static const char *task_titles[DIAG_COLUMNS] = {"Task", "Priority", "Stack", "Never used", "Peak use"};
+
+static lv_obj_t *diag_container = NULL;
+static lv_obj_t *diag_status = NULL;
+static lv_obj_t *heap_table = NULL;
+static lv_obj_t *task_table = NULL;
+static lv_timer_t *diag_timer = NULL;
+static uint32_t shown_sample = 0;
+
+// Header row in the bar colour, rows in alarm in red
+static void drawCellCb(lv_event_t *e) {
+    lv_obj_draw_part_dsc_t *dsc = lv_event_get_draw_part_dsc(e);
+    if (dsc->part != LV_PART_ITEMS) return;
+    lv_obj_t *table = lv_event_get_target(e);
+    uint16_t row = dsc->id / DIAG_COLUMNS;
+    if (row == 0) {
+        dsc->rect_dsc->bg_color = lv_color_hex(0x252526);
+    } else if (lv_table_has_cell_ctrl(table, row, 0, DIAG_ALARM_CTRL)) {
+        dsc->label_dsc->color = lv_color_hex(DIAG_ALARM_COLOR);
+    }
+}
+
+static lv_obj_t *createTable(lv_obj_t *parent, const char **titles) {
+    lv_obj_t *table = lv_table_create(parent);
+    lv_obj_add_style(table, &ui_style_view, LV_PART_MAIN);
+    lv_obj_add_style(table, &ui_style_table_row, LV_PART_ITEMS);
+    lv_obj_add_style(table, &ui_style_table_cell, LV_PART_ITEMS);
+    lv_obj_add_style(table, &ui_style_caption, LV_PART_ITEMS);
+    lv_obj_set_style_pad_ver(table, 4, LV_PART_ITEMS);
+    lv_obj_clear_flag(table, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(table, drawCellCb, LV_EVENT_DRAW_PART_BEGIN, NULL);
+    
+    lv_table_set_col_cnt(table, DIAG_COLUMNS);
+    for (int c = 0; c < DIAG_COLUMNS; c++) {
+        lv_table_set_col_width(table, c, diag_col_width);
+        lv_table_set_cell_value(table, 0, c, titles[c]);
+    }
+    return table;
+}
+
+static void setRowAlarm(lv_obj_t *table, uint16_t row, bool alarm) {
+    if (alarm) {
+        lv_table_add_cell_ctrl(table, row, 0, DIAG_ALARM_CTRL);
+    } else {
+        lv_table_clear_cell_ctrl(table, row, 0, DIAG_ALARM_CTRL);
+    }
+}
+
+static void setHeapRow(uint16_t row, const char *name, const TelemetryHeap *heap) {
+    lv_table_set_cell_value(heap_table, row, 0, name);
+    if (heap->total == 0) {
+        lv_table_set_cell_value(heap_table, row, 1, "not present");
+        for (int c = 2; c < DIAG_COLUMNS; c++) {
+            lv_table_set_cell_value(heap_table, row, c, "-");
+        }
+    } else {
+        lv_table_set_cell_value_fmt(heap_table, row, 1, "%lu KB", (unsigned long)(heap->free / 1024));
+        lv_table_set_cell_value_fmt(heap_table, row, 2, "%lu KB", (unsigned long)(heap->largest_block / 1024));
+        lv_table_set_cell_value_fmt(heap_table, row, 3, "%lu KB", (unsigned long)(heap->min_free / 1024));
+        lv_table_set_cell_value_fmt(heap_table, row, 4, "%lu KB", (unsigned long)(heap->total / 1024));
+    }
+    setRowAlarm(heap_table, row, heap->alarm);
+}
+
+static void setTaskRow(uint16_t row, const TelemetryTask *task) {
+    lv_table_set_cell_value(task_table, row, 0, task->name);
+    lv_table_set_cell_value_fmt(task_table, row, 1, "%u", task->priority);
+    lv_table_set_cell_value_fmt(task_table, row, 3, "%lu B", (unsigned long)task->stack_free_min);
+    if (task->stack_size > task->stack_free_min) {
+        lv_table_set_cell_value_fmt(task_table, row, 2, "%lu B", (unsigned long)task->stack_size);
+        lv_table_set_cell_value_fmt(task_table, row, 4, "%lu%%",
+                                    (unsigned long)((task->stack_size - task->stack_free_min) * 100 / task->stack_size));
+    } else {
+        lv_table_set_cell_value(task_table, row, 2, "-");
+        lv_table_set_cell_value(task_table, row, 4, "-");
+    }
+    setRowAlarm(task_table, row, task->alarm);
+}
+
+static void diagTimerCb(lv_timer_t *timer) {
+    if (diag_container == NULL || lv_obj_has_flag(diag_container, LV_OBJ_FLAG_HIDDEN)) return;
+    diagnosticsViewUpdate();
+}
+
+// Create the title, status line and both tables (call with the LVGL lock held)
+lv_obj_t *diagnosticsViewCreate(lv_obj_t *parent) {
+    diag_container = lv_obj_create(parent);
+    lv_obj_add_style(diag_container, &ui_style_view, LV_PART_MAIN);
+    lv_obj_add_style(diag_container, &ui_style_page, LV_PART_MAIN);
+    lv_obj_set_flex_flow(diag_container, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_style_pad_gap(diag_container, 10, LV_PART_MAIN);
+    lv_obj_clear_flag(diag_container, LV_OBJ_FLAG_SCROLLABLE);
+    
+    lv_obj_t *title_label = lv_label_create(diag_container);
+    lv_label_set_text(title_label, "Diagnostics");
+    lv_obj_add_style(title_label, &ui_style_title, LV_PART_MAIN);
+    
+    diag_status = lv_label_create(diag_container);
+    lv_obj_add_style(diag_status, &ui_style_axis_label, LV_PART_MAIN);
+    
+    heap_table = createTable(diag_container, heap_titles);
+    lv_table_set_row_cnt(heap_table, 3);
+    
+    // Task list takes the rest of the page and scrolls
+    task_table = createTable(diag_container, task_titles);
+    lv_obj_set_width(task_table, LV_PCT(100));
+    lv_obj_set_flex_grow(task_table, 1);
+    lv_obj_set_scroll_dir(task_table, LV_DIR_VER);
+    
+    shown_sample = UINT32_MAX;
+    diagnosticsViewUpdate();
+    diag_timer = lv_timer_create(diagTimerCb, DIAG_CHECK_MS, NULL);
+    
+    return diag_container;
+}
+
+// Forget the widgets before the view is deleted
+void diagnosticsViewDetach() {
+    if (diag_timer != NULL) lv_timer_del(diag_timer);
+    diag_timer = NULL;
+    diag_container = NULL;
+    diag_status = NULL;
+    heap_table = NULL;
+    task_table = NULL;
+}
+
+// Show the latest telemetry sample if it has not been shown yet (call with the LVGL lock held)
+void diagnosticsViewUpdate() {
+    if (diag_container == NULL) return;
+    const TelemetrySnapshot *snap = telemetryGet();
+    if (snap->sample == shown_sample) return;
+    shown_sample = snap->sample;
+    
+    if (snap->sample == 0) {
+        lv_label_set_text(diag_status, "Waiting for the first sample");
+        return;
+    }
+    if (snap->task_total > TELEMETRY_MAX_TASKS) {
+        lv_label_set_text_fmt(diag_status, "%u tasks, more than TELEMETRY_MAX_TASKS: stacks not sampled",
+                              snap->task_total);
+    } else {
+        lv_label_set_text_fmt(diag_status, "Sample %lu (every %d s), %lu in alarm (stack alarm below %d B never used)",
+                              (unsigned long)snap->sample, TELEMETRY_PERIOD_MS / 1000, (unsigned long)snap->alarms,
+                              TELEMETRY_STACK_ALARM_BYTES);
+    }
+    
+    setHeapRow(1, "Internal", &snap->internal);
+    setHeapRow(2, "PSRAM", &snap->psram);
+    
+    lv_table_set_row_cnt(task_table, snap->task_count + 1);
+    for (uint8_t i = 0; i < snap->task_count; i++) {
+        setTaskRow(i + 1, &snap->tasks[i]);
+    }
+}
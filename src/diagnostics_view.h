@@ -0,0 +1,15 @@
+/*
+ * Diagnostics screen (task stacks and heaps from the telemetry samples)
+ */
+
+#ifndef DIAGNOSTICS_VIEW_H
+#define DIAGNOSTICS_VIEW_H
+
+#include <lvgl.h>
+
+// Functions (LVGL lock held)
+lv_obj_t *diagnosticsViewCreate(lv_obj_t *parent);
+void diagnosticsViewDetach();
+void diagnosticsViewUpdate();
+
+#endif // DIAGNOSTICS_VIEW_H
@@ -0,0 +1,120 @@
+/*
+ * Graph transition animation implementation
+ *
+ * When a sweep lands, each network's oval morphs from its previous geometry to
+ * the new one. A frame-budget controller watches how long the graph takes to
+ * render and, when it runs over budget, first lowers the animation frame rate
+ * and then stops interpolating far-away (weak) networks, which snap instead.
+ */
+
+#include "graph_anim.h"
+#include "wifi_data.h"
+#include "config.h"
+#include <lvgl.h>
+
+// External UI objects (declared in ui_views.cpp)
+extern lv_obj_t *graph_obj;
+
+static lv_timer_t *anim_timer = NULL;
+static uint32_t anim_start_tick = 0;
+static uint32_t anim_period_ms = GRAPH_ANIM_MIN_PERIOD_MS;
+static int anim_rssi_cutoff = RSSI_MIN;  // Networks weaker than this are not interpolated
+static uint32_t frame_draw_us = 0;       // Graph draw time accumulated since the last step
+
+// Linear interpolation with t in 0..256
+static int lerp(int from, int to, int32_t t) {
+    return from + ((to - from) * t) / 256;
+}
+
+// Adapt frame rate and interpolation detail to the measured render time
+static void adjustFrameBudget(uint32_t draw_us) {
+    if (draw_us > GRAPH_FRAME_BUDGET_US) {
+        // Over budget: lower the frame rate first, then drop far-away networks
+        if (anim_period_ms < GRAPH_ANIM_MAX_PERIOD_MS) {
+            anim_period_ms *= 2;
+            if (anim_period_ms > GRAPH_ANIM_MAX_PERIOD_MS) anim_period_ms = GRAPH_ANIM_MAX_PERIOD_MS;
+        } else if (anim_rssi_cutoff < RSSI_MAX) {
+            anim_rssi_cutoff += 10;
+        }
+    } else if (draw_us < GRAPH_FRAME_BUDGET_US / 2) {
+        // Comfortably under budget: restore detail first, then frame rate
+        if (anim_rssi_cutoff > RSSI_MIN) {
+            anim_rssi_cutoff -= 10;
+        } else if (anim_period_ms > GRAPH_ANIM_MIN_PERIOD_MS) {
+            anim_period_ms /= 2;
+            if (anim_period_ms < GRAPH_ANIM_MIN_PERIOD_MS) anim_period_ms = GRAPH_ANIM_MIN_PERIOD_MS;
+        }
+    }
+}
+
+// Animation timer: advance every animating network and redraw
+static void graphAnimStep(lv_timer_t *timer) {
+    // The previous step's invalidation has been rendered by now
+    if (frame_draw_us > 0) {
+        adjustFrameBudget(frame_draw_us);
+        frame_draw_us = 0;
+    }
+    
+    uint32_t elapsed = lv_tick_elaps(anim_start_tick);
+    int32_t t = (elapsed >= GRAPH_ANIM_DURATION_MS) ? 256 : (int32_t)(elapsed * 256 / GRAPH_ANIM_DURATION_MS);
+    // Ease out: fast start, gentle landing
+    t = 256 - ((256 - t) * (256 - t)) / 256;
+    
+    for (uint16_t i = 0; i < wifi_network_count; i++) {
+        WiFiNetworkData *net = &wifi_networks[i];
+        if (!net->animating) continue;
+        net->y_top = lerp(net->y_top_from, net->y_top_target, t);
+        net->width_pixels = lerp(net->width_from, net->width_target, t);
+    }
+    
+    markGraphLabelsDirty();
+    if (graph_obj) lv_obj_invalidate(graph_obj);
+    
+    if (elapsed >= GRAPH_ANIM_DURATION_MS) {
+        lv_timer_del(timer);
+        anim_timer = NULL;
+    } else {
+        lv_timer_set_period(timer, anim_period_ms);
+    }
+}
+
+// Start a transition towards the targets stored by updateWiFiGraph (call with the LVGL lock held)
+void graphAnimStart() {
+    bool any_animating = false;
+    
+    for (uint16_t i = 0; i < wifi_network_count; i++) {
+        WiFiNetworkData *net = &wifi_networks[i];
+        bool changed = (net->y_top_from != net->y_top_target) || (net->width_from != net->width_target);
+        net->animating = (GRAPH_ANIM_DURATION_MS > 0) && changed && (net->rssi >= anim_rssi_cutoff);
+        if (net->animating) {
+            net->y_top = net->y_top_from;
+            net->width_pixels = net->width_from;
+            any_animating = true;
+        } else {
+            net->y_top = net->y_top_target;
+            net->width_pixels = net->width_target;
+        }
+    }
+    
+    if (!any_animating) {
+        if (anim_timer) {
+            lv_timer_del(anim_timer);
+            anim_timer = NULL;
+        }
+        return;
+    }
+    
+    anim_start_tick = lv_tick_get();
+    frame_draw_us = 0;
+    if (anim_timer == NULL) {
+        anim_timer = lv_timer_create(graphAnimStep, anim_period_ms, NULL);
+    } else {
+        lv_timer_set_period(anim_timer, anim_period_ms);
+        lv_timer_reset(anim_timer);
+    }
+}
+
+// Called from graph_draw_cb with the time spent drawing one area of the graph
+void graphAnimAddDrawTime(uint32_t draw_us) {
+    frame_draw_us += draw_us;
+}
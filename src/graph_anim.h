@@ -0,0 +1,14 @@
+/*
+ * Graph transition animation with frame-budget control
+ */
+
+#ifndef GRAPH_ANIM_H
+#define GRAPH_ANIM_H
+
+#include <stdint.h>
+
+// Functions
+void graphAnimStart();
+void graphAnimAddDrawTime(uint32_t draw_us);
+
+#endif // GRAPH_ANIM_H
@@ -0,0 +1,207 @@
+/*
+ * Cached static background of the graph implementation
+ *
+ * Axes, dashed grid and scale labels only change when the viewport moves, so
+ * they are rendered once into a PSRAM image (through a hidden canvas, like the
+ * label cache) and blitted on every frame. While a pinch or pan is in progress
+ * the viewport changes every frame; the cache is then stale and the background
+ * is drawn directly until the gesture settles and graphBackgroundRefresh()
+ * re-renders it.
+ */
+
+#include "graph_background.h"
+#include "graph_viewport.h"
+#include "config.h"
+#include <Arduino.h>
+#include "esp_heap_caps.h"
+#include <math.h>
+#include <string.h>
+
+// Draws either straight into the frame (draw_ctx) or into the cache canvas
+struct BgPainter {
+    lv_draw_ctx_t *draw_ctx;
+    lv_obj_t *canvas;
+};
+
+static lv_obj_t *cache_canvas = NULL;
+static bool cache_valid = false;
+static uint32_t cache_version = 0;
+
+static void paintRect(const BgPainter *p, const lv_area_t *area, const lv_draw_rect_dsc_t *dsc) {
+    if (p->canvas) {
+        lv_canvas_draw_rect(p->canvas, area->x1, area->y1, lv_area_get_width(area), lv_area_get_height(area), dsc);
+    } else {
+        lv_draw_rect(p->draw_ctx, dsc, area);
+    }
+}
+
+static void paintLine(const BgPainter *p, lv_point_t p1, lv_point_t p2, const lv_draw_line_dsc_t *dsc) {
+    if (p->canvas) {
+        lv_point_t points[2] = {p1, p2};
+        lv_canvas_draw_line(p->canvas, points, 2, dsc);
+    } else {
+        lv_draw_line(p->draw_ctx, dsc, &p1, &p2);
+    }
+}
+
+static void paintLabel(const BgPainter *p, const lv_area_t *area, lv_draw_label_dsc_t *dsc, const char *text) {
+    if (p->canvas) {
+        lv_canvas_draw_text(p->canvas, area->x1, area->y1, lv_area_get_width(area), dsc, text);
+    } else {
+        lv_draw_label(p->draw_ctx, dsc, area, text, NULL);
+    }
+}
+
+// Axes, grid and scale labels for the current viewport
+static void paintBackground(const BgPainter *p) {
+    const GraphViewport *vp = graphViewportGet();
+    int graph_y_offset = GRAPH_TOP_OFFSET;
+    int plot_height = graphPlotHeight();
+    
+    // Draw black background
+    lv_draw_rect_dsc_t bg_dsc;
+    lv_draw_rect_dsc_init(&bg_dsc);
+    bg_dsc.bg_opa = LV_OPA_COVER;
+    bg_dsc.bg_color = lv_color_hex(0x000000);
+    bg_dsc.border_width = 0;
+    lv_area_t bg_area = {0, 0, INFO_WINDOW_WIDTH - 1, INFO_WINDOW_HEIGHT - 1};
+    paintRect(p, &bg_area, &bg_dsc);
+    
+    // Initialize draw descriptors
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    lv_draw_line_dsc_t line_dsc;
+    lv_draw_line_dsc_init(&line_dsc);
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    
+    // Draw axes (bold lines)
+    rect_dsc.bg_color = lv_color_hex(0x444444);
+    rect_dsc.bg_opa = LV_OPA_COVER;
+    rect_dsc.border_width = 0;
+    
+    // Left axis (vertical)
+    lv_area_t left_axis = {GRAPH_LEFT_MARGIN - 1, graph_y_offset, GRAPH_LEFT_MARGIN, graph_y_offset + plot_height - 1};
+    paintRect(p, &left_axis, &rect_dsc);
+    
+    // Bottom axis (horizontal)
+    lv_area_t bottom_axis = {GRAPH_LEFT_MARGIN, graph_y_offset + plot_height, GRAPH_LEFT_MARGIN + GRAPH_WIDTH - 1, graph_y_offset + plot_height + 1};
+    paintRect(p, &bottom_axis, &rect_dsc);
+    
+    // Top border
+    lv_area_t top_axis = {GRAPH_LEFT_MARGIN, graph_y_offset, GRAPH_LEFT_MARGIN + GRAPH_WIDTH - 1, graph_y_offset + 1};
+    paintRect(p, &top_axis, &rect_dsc);
+    
+    // Right border
+    lv_area_t right_axis = {GRAPH_LEFT_MARGIN + GRAPH_WIDTH, graph_y_offset, GRAPH_LEFT_MARGIN + GRAPH_WIDTH + 1, graph_y_offset + plot_height - 1};
+    paintRect(p, &right_axis, &rect_dsc);
+    
+    // Finer RSSI steps once zoomed in
+    int rssi_step = (vp->rssi_max - vp->rssi_min > 30) ? 10 : 5;
+    int rssi_first = (int)ceilf(vp->rssi_min / rssi_step) * rssi_step;
+    int ch_first = (int)ceilf(vp->channel_min);
+    int ch_last = (int)floorf(vp->channel_max);
+    
+    // Draw RSSI scale labels on left
+    label_dsc.font = &lv_font_montserrat_10;
+    label_dsc.color = lv_color_hex(0x888888);
+    char rssi_label[8];
+    for (int rssi = rssi_first; rssi <= vp->rssi_max; rssi += rssi_step) {
+        snprintf(rssi_label, sizeof(rssi_label), "%d", rssi);
+        int y_pos = graphRssiToY(rssi);
+        lv_area_t label_area = {25, (lv_coord_t)(y_pos - 5), 75, (lv_coord_t)(y_pos + 5)};
+        paintLabel(p, &label_area, &label_dsc, rssi_label);
+    }
+    
+    // Draw channel labels on bottom
+    for (int ch = ch_first; ch <= ch_last; ch++) {
+        char ch_label[4];
+        snprintf(ch_label, sizeof(ch_label), "%d", ch);
+        int x_pos = graphChannelToX(ch);
+        
+        if ((ch >= 1 && ch <= 11) || ch == 13) {
+            label_dsc.color = lv_color_hex(0x888888);
+            int label_len = strlen(ch_label);
+            int estimated_text_width = label_len * 7;
+            if (estimated_text_width < 14) estimated_text_width = 14;
+            int text_x_start = x_pos - (estimated_text_width / 2);
+            lv_area_t label_area = {(lv_coord_t)text_x_start, (lv_coord_t)(graph_y_offset + plot_height + 5),
+                                    (lv_coord_t)(text_x_start + estimated_text_width - 1), (lv_coord_t)(graph_y_offset + plot_height + 20)};
+            paintLabel(p, &label_area, &label_dsc, ch_label);
+        }
+    }
+    
+    // Draw horizontal axis title "Wifi Channel"
+    label_dsc.color = lv_color_hex(0x888888);
+    label_dsc.font = &lv_font_montserrat_12;
+    const char* axis_title = "Wifi Channel";
+    int title_width = strlen(axis_title) * 8;
+    int horizontal_title_x = GRAPH_LEFT_MARGIN + (GRAPH_WIDTH / 2) - (title_width / 2);
+    lv_area_t title_area = {(lv_coord_t)horizontal_title_x, (lv_coord_t)(graph_y_offset + plot_height + 18),
+                            (lv_coord_t)(horizontal_title_x + title_width - 1), (lv_coord_t)(graph_y_offset + plot_height + 35)};
+    paintLabel(p, &title_area, &label_dsc, axis_title);
+    
+    // Draw gridlines using dashed lines (much more efficient!)
+    line_dsc.color = lv_color_hex(0x333333);
+    line_dsc.width = 1;
+    line_dsc.opa = LV_OPA_COVER;
+    line_dsc.dash_width = 2;  // 2 pixel dashes
+    line_dsc.dash_gap = 2;    // 2 pixel gaps
+    
+    // Draw vertical gridlines for channels 0-15
+    for (int ch = (ch_first < 0 ? 0 : ch_first); ch <= ch_last && ch <= 15; ch++) {
+        int x_pos = graphChannelToX(ch);
+        lv_point_t p1 = {(lv_coord_t)x_pos, (lv_coord_t)graph_y_offset};
+        lv_point_t p2 = {(lv_coord_t)x_pos, (lv_coord_t)(graph_y_offset + plot_height)};
+        paintLine(p, p1, p2, &line_dsc);
+    }
+    
+    // Draw horizontal gridlines at each RSSI step
+    for (int rssi = rssi_first; rssi <= vp->rssi_max; rssi += rssi_step) {
+        int y_pos = graphRssiToY(rssi);
+        lv_point_t p1 = {GRAPH_LEFT_MARGIN, (lv_coord_t)y_pos};
+        lv_point_t p2 = {GRAPH_LEFT_MARGIN + GRAPH_WIDTH, (lv_coord_t)y_pos};
+        paintLine(p, p1, p2, &line_dsc);
+    }
+}
+
+// Allocate the PSRAM image and render it for the initial viewport (call once with the LVGL lock held)
+bool graphBackgroundInit() {
+    size_t buf_size = LV_CANVAS_BUF_SIZE_TRUE_COLOR(INFO_WINDOW_WIDTH, INFO_WINDOW_HEIGHT);
+    uint8_t *buf = (uint8_t *)heap_caps_malloc(buf_size, MALLOC_CAP_SPIRAM);
+    if (buf == NULL) {
+        printf("Graph background: failed to allocate %u bytes in PSRAM, drawing live\r\n", (unsigned)buf_size);
+        return false;
+    }
+    
+    cache_canvas = lv_canvas_create(lv_layer_sys());
+    lv_canvas_set_buffer(cache_canvas, buf, INFO_WINDOW_WIDTH, INFO_WINDOW_HEIGHT, LV_IMG_CF_TRUE_COLOR);
+    lv_obj_add_flag(cache_canvas, LV_OBJ_FLAG_HIDDEN);
+    
+    graphBackgroundRefresh();
+    return true;
+}
+
+// Blit the cached background, or draw it live if the viewport moved since it was rendered
+void graphBackgroundDraw(lv_draw_ctx_t *draw_ctx) {
+    if (cache_valid && cache_version == graphViewportVersion()) {
+        lv_draw_img_dsc_t img_dsc;
+        lv_draw_img_dsc_init(&img_dsc);
+        lv_area_t coords = {0, 0, INFO_WINDOW_WIDTH - 1, INFO_WINDOW_HEIGHT - 1};
+        lv_draw_img(draw_ctx, &img_dsc, &coords, lv_canvas_get_img(cache_canvas));
+        return;
+    }
+    
+    BgPainter painter = {draw_ctx, NULL};
+    paintBackground(&painter);
+}
+
+// Re-render the cache for the current viewport (once a gesture has settled)
+void graphBackgroundRefresh() {
+    if (cache_canvas == NULL) return;
+    
+    BgPainter painter = {NULL, cache_canvas};
+    paintBackground(&painter);
+    cache_version = graphViewportVersion();
+    cache_valid = true;
+}
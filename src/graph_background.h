@@ -0,0 +1,15 @@
+/*
+ * Cached static background of the graph (axes, grid, scale labels)
+ */
+
+#ifndef GRAPH_BACKGROUND_H
+#define GRAPH_BACKGROUND_H
+
+#include <lvgl.h>
+
+// Functions
+bool graphBackgroundInit();
+void graphBackgroundDraw(lv_draw_ctx_t *draw_ctx);
+void graphBackgroundRefresh();
+
+#endif // GRAPH_BACKGROUND_H
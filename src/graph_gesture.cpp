@@ -0,0 +1,199 @@
+/*
+ * Graph gesture recognizer implementation
+ *
+ * LVGL 8 only tracks one pointer, so the touch read callback hands every
+ * sample here before passing the first point on. Two fingers on the plot start
+ * a gesture: the viewport captured at touch-down is scaled by how far the
+ * fingers spread along each axis (horizontal spread zooms channels, vertical
+ * spread zooms dB) and shifted so the value under the starting centroid stays
+ * under the current centroid, which also gives two-finger pan for free. The
+ * background cache is re-rendered once the viewport has been still for
+ * GESTURE_SETTLE_MS. Runs inside the LVGL indev read, so the lock is held.
+ *
+ * Lifting the fingers while panning throws the view on: the touch filter's
+ * velocity of the two points at the last two-finger sample gives the
+ * centroid's speed, and a timer keeps panning at that speed, losing
+ * GESTURE_THROW_DECAY_PCT per step, until it is slow, runs into the edge of
+ * the full range, or a new touch catches it.
+ */
+
+#include "graph_gesture.h"
+#include "graph_viewport.h"
+#include "graph_background.h"
+#include "touch_filter.h"
+#include "config.h"
+#include <math.h>
+
+// External UI objects (declared in ui_views.cpp)
+extern lv_obj_t *graph_obj;
+
+enum GestureState {
+    GESTURE_IDLE,
+    GESTURE_PINCH,
+    GESTURE_ENDED     // Fingers lifted one by one; wait for all of them
+};
+
+static GestureState state = GESTURE_IDLE;
+static uint8_t prev_count = 0;
+static GraphViewport start_viewport;
+static lv_point_t start_a, start_b;
+static uint32_t last_tap_tick = 0;
+static bool last_tap_valid = false;
+static lv_timer_t *settle_timer = NULL;
+static float pinch_vx = 0, pinch_vy = 0;    // Centroid velocity at the last two-finger sample, px/s
+static float throw_vx = 0, throw_vy = 0;
+static lv_timer_t *throw_timer = NULL;
+
+static bool graphVisible() {
+    return graph_obj != NULL && !lv_obj_has_flag(graph_obj, LV_OBJ_FLAG_HIDDEN);
+}
+
+static bool insidePlot(const lv_point_t *p) {
+    return p->x >= GRAPH_LEFT_MARGIN && p->x <= GRAPH_LEFT_MARGIN + GRAPH_WIDTH &&
+           p->y >= GRAPH_TOP_OFFSET && p->y <= GRAPH_TOP_OFFSET + graphPlotHeight();
+}
+
+static int spread(lv_coord_t a, lv_coord_t b) {
+    return (a > b) ? a - b : b - a;
+}
+
+// Viewport has been still long enough: render the background for it
+static void settleTimerCb(lv_timer_t *timer) {
+    settle_timer = NULL;  // One-shot, LVGL deletes it after this call
+    graphBackgroundRefresh();
+    if (graph_obj) lv_obj_invalidate(graph_obj);
+}
+
+// Redraw now and (re)arm the settle timer
+static void viewportChanged() {
+    if (graph_obj) lv_obj_invalidate(graph_obj);
+    if (settle_timer == NULL) {
+        settle_timer = lv_timer_create(settleTimerCb, GESTURE_SETTLE_MS, NULL);
+        lv_timer_set_repeat_count(settle_timer, 1);
+    } else {
+        lv_timer_reset(settle_timer);
+    }
+}
+
+static void stopThrow() {
+    if (throw_timer != NULL) lv_timer_del(throw_timer);
+    throw_timer = NULL;
+}
+
+// One throw step: pan by the current speed, then slow down
+static void throwTimerCb(lv_timer_t *timer) {
+    const GraphViewport *vp = graphViewportGet();
+    float dt = GESTURE_THROW_PERIOD_MS / 1000.0f;
+    float channel_shift = -throw_vx * dt / GRAPH_WIDTH * (vp->channel_max - vp->channel_min);
+    float rssi_shift = throw_vy * dt / graphPlotHeight() * (vp->rssi_max - vp->rssi_min);
+    GraphViewport next = *vp;
+    next.channel_min += channel_shift;
+    next.channel_max += channel_shift;
+    next.rssi_min += rssi_shift;
+    next.rssi_max += rssi_shift;
+    
+    throw_vx -= throw_vx * GESTURE_THROW_DECAY_PCT / 100;
+    throw_vy -= throw_vy * GESTURE_THROW_DECAY_PCT / 100;
+    bool moved = graphVisible() && graphViewportSet(&next);
+    if (moved) viewportChanged();
+    if (!moved || fmaxf(fabsf(throw_vx), fabsf(throw_vy)) < GESTURE_THROW_STOP_PX_S) stopThrow();
+}
+
+// Fingers lifted from a pan: keep going at the speed they had
+static void startThrow() {
+    if (fmaxf(fabsf(pinch_vx), fabsf(pinch_vy)) < GESTURE_THROW_MIN_PX_S) return;
+    throw_vx = pinch_vx;
+    throw_vy = pinch_vy;
+    if (throw_timer == NULL) throw_timer = lv_timer_create(throwTimerCb, GESTURE_THROW_PERIOD_MS, NULL);
+}
+
+// Remember how fast the centroid of the two filtered points moves (zero without the touch filter)
+static void samplePinchVelocity() {
+    int16_t ax, ay, bx, by;
+    if (touchFilterVelocity(0, &ax, &ay) && touchFilterVelocity(1, &bx, &by)) {
+        pinch_vx = (ax + bx) / 2.0f;
+        pinch_vy = (ay + by) / 2.0f;
+    } else {
+        pinch_vx = 0;
+        pinch_vy = 0;
+    }
+}
+
+// Recompute the viewport from the touch-down state and the current two points
+static void updatePinch(const lv_point_t *a, const lv_point_t *b) {
+    float c0x = (start_a.x + start_b.x) / 2.0f - GRAPH_LEFT_MARGIN;
+    float c0y = (start_a.y + start_b.y) / 2.0f - GRAPH_TOP_OFFSET;
+    float c1x = (a->x + b->x) / 2.0f - GRAPH_LEFT_MARGIN;
+    float c1y = (a->y + b->y) / 2.0f - GRAPH_TOP_OFFSET;
+    
+    // An axis only zooms once the fingers are spread along it, otherwise it just pans
+    float scale_x = 1.0f;
+    float scale_y = 1.0f;
+    int dx0 = spread(start_a.x, start_b.x), dx1 = spread(a->x, b->x);
+    int dy0 = spread(start_a.y, start_b.y), dy1 = spread(a->y, b->y);
+    if (dx0 >= GESTURE_MIN_AXIS_PX && dx1 >= GESTURE_MIN_AXIS_PX) scale_x = (float)dx0 / dx1;
+    if (dy0 >= GESTURE_MIN_AXIS_PX && dy1 >= GESTURE_MIN_AXIS_PX) scale_y = (float)dy0 / dy1;
+    
+    float ch_span0 = start_viewport.channel_max - start_viewport.channel_min;
+    float rssi_span0 = start_viewport.rssi_max - start_viewport.rssi_min;
+    float ch_anchor = start_viewport.channel_min + c0x / GRAPH_WIDTH * ch_span0;
+    float rssi_anchor = start_viewport.rssi_max - c0y / graphPlotHeight() * rssi_span0;
+    
+    GraphViewport next;
+    float ch_span = ch_span0 * scale_x;
+    float rssi_span = rssi_span0 * scale_y;
+    next.channel_min = ch_anchor - c1x / GRAPH_WIDTH * ch_span;
+    next.channel_max = next.channel_min + ch_span;
+    next.rssi_max = rssi_anchor + c1y / graphPlotHeight() * rssi_span;
+    next.rssi_min = next.rssi_max - rssi_span;
+    
+    if (graphViewportSet(&next)) viewportChanged();
+}
+
+// Feed one touch sample (screen coordinates, count 0 = released)
+void graphGestureFeed(const lv_point_t *points, uint8_t count) {
+    // A new touch catches a thrown view
+    if (count > 0 && prev_count == 0) stopThrow();
+    
+    switch (state) {
+        case GESTURE_IDLE:
+            if (count >= 2 && graphVisible() && insidePlot(&points[0]) && insidePlot(&points[1])) {
+                state = GESTURE_PINCH;
+                start_viewport = *graphViewportGet();
+                start_a = points[0];
+                start_b = points[1];
+                pinch_vx = 0;
+                pinch_vy = 0;
+                last_tap_valid = false;
+            } else if (count == 1 && prev_count == 0 && graphVisible() && insidePlot(&points[0])) {
+                // Second tap within the window resets the zoom
+                uint32_t now = lv_tick_get();
+                if (last_tap_valid && now - last_tap_tick <= GESTURE_DOUBLE_TAP_MS) {
+                    last_tap_valid = false;
+                    if (!graphViewportIsFull()) {
+                        graphViewportReset();
+                        viewportChanged();
+                    }
+                } else {
+                    last_tap_tick = now;
+                    last_tap_valid = true;
+                }
+            }
+            break;
+            
+        case GESTURE_PINCH:
+            if (count >= 2) {
+                updatePinch(&points[0], &points[1]);
+                samplePinchVelocity();
+            } else {
+                state = (count == 0) ? GESTURE_IDLE : GESTURE_ENDED;
+                startThrow();
+            }
+            break;
+            
+        case GESTURE_ENDED:
+            if (count == 0) state = GESTURE_IDLE;
+            break;
+    }
+    prev_count = count;
+}
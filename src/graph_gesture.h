@@ -0,0 +1,13 @@
+/*
+ * Pinch-zoom, two-finger pan (with a throw on release) and double-tap reset on the channel graph
+ */
+
+#ifndef GRAPH_GESTURE_H
+#define GRAPH_GESTURE_H
+
+#include <lvgl.h>
+
+// Functions
+void graphGestureFeed(const lv_point_t *points, uint8_t count);
+
+#endif // GRAPH_GESTURE_H
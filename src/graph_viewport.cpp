@@ -0,0 +1,84 @@
+/*
+ * Visible channel/RSSI window of the graph implementation
+ *
+ * Everything that maps model values to graph pixels goes through here. The
+ * version number changes whenever the window moves, so pixel geometry and the
+ * background cache can tell when they are stale and rebuild lazily. The plot
+ * height is part of the mapping too: the dashboard shows the same graph
+ * shorter, and changing it bumps the version like a pan would.
+ */
+
+#include "graph_viewport.h"
+#include "config.h"
+
+static GraphViewport viewport = {CHANNEL_MIN, CHANNEL_MAX, RSSI_MIN, RSSI_MAX};
+static uint32_t viewport_version = 0;
+static int plot_height = GRAPH_HEIGHT;
+
+// Keep a span within [min_span, full range] and inside the full range
+static void clampRange(float *lo, float *hi, float full_lo, float full_hi, float min_span) {
+    float span = *hi - *lo;
+    if (span < min_span) span = min_span;
+    if (span > full_hi - full_lo) span = full_hi - full_lo;
+    float centre = (*lo + *hi) / 2;
+    *lo = centre - span / 2;
+    if (*lo < full_lo) *lo = full_lo;
+    if (*lo + span > full_hi) *lo = full_hi - span;
+    *hi = *lo + span;
+}
+
+const GraphViewport *graphViewportGet() {
+    return &viewport;
+}
+
+// Move the window (clamped to the full range); returns true if it changed
+bool graphViewportSet(const GraphViewport *vp) {
+    GraphViewport next = *vp;
+    clampRange(&next.channel_min, &next.channel_max, CHANNEL_MIN, CHANNEL_MAX, GRAPH_MIN_CHANNEL_SPAN);
+    clampRange(&next.rssi_min, &next.rssi_max, RSSI_MIN, RSSI_MAX, GRAPH_MIN_RSSI_SPAN);
+    
+    if (next.channel_min == viewport.channel_min && next.channel_max == viewport.channel_max &&
+        next.rssi_min == viewport.rssi_min && next.rssi_max == viewport.rssi_max) {
+        return false;
+    }
+    viewport = next;
+    viewport_version++;
+    return true;
+}
+
+void graphViewportReset() {
+    GraphViewport full = {CHANNEL_MIN, CHANNEL_MAX, RSSI_MIN, RSSI_MAX};
+    graphViewportSet(&full);
+}
+
+bool graphViewportIsFull() {
+    return viewport.channel_min == CHANNEL_MIN && viewport.channel_max == CHANNEL_MAX &&
+           viewport.rssi_min == RSSI_MIN && viewport.rssi_max == RSSI_MAX;
+}
+
+uint32_t graphViewportVersion() {
+    return viewport_version;
+}
+
+// Pixel height of the plot area (GRAPH_HEIGHT full screen, less on the dashboard)
+void graphViewportSetPlotHeight(int height) {
+    if (height == plot_height) return;
+    plot_height = height;
+    viewport_version++;
+}
+
+int graphPlotHeight() {
+    return plot_height;
+}
+
+int graphChannelToX(float channel) {
+    return GRAPH_LEFT_MARGIN + (int)((channel - viewport.channel_min) * GRAPH_WIDTH / (viewport.channel_max - viewport.channel_min));
+}
+
+int graphRssiToY(float rssi) {
+    return GRAPH_TOP_OFFSET + plot_height - (int)((rssi - viewport.rssi_min) * plot_height / (viewport.rssi_max - viewport.rssi_min));
+}
+
+int graphChannelSpanToPixels(float channels) {
+    return (int)(channels * GRAPH_WIDTH / (viewport.channel_max - viewport.channel_min));
+}
@@ -0,0 +1,29 @@
+/*
+ * Visible channel/RSSI window of the graph
+ */
+
+#ifndef GRAPH_VIEWPORT_H
+#define GRAPH_VIEWPORT_H
+
+#include <stdint.h>
+
+struct GraphViewport {
+    float channel_min;
+    float channel_max;
+    float rssi_min;
+    float rssi_max;
+};
+
+// Functions
+const GraphViewport *graphViewportGet();
+bool graphViewportSet(const GraphViewport *vp);
+void graphViewportReset();
+bool graphViewportIsFull();
+uint32_t graphViewportVersion();
+void graphViewportSetPlotHeight(int height);
+int graphPlotHeight();
+int graphChannelToX(float channel);
+int graphRssiToY(float rssi);
+int graphChannelSpanToPixels(float channels);
+
+#endif // GRAPH_VIEWPORT_H
@@ -0,0 +1,125 @@
+/*
+ * LVGL porting layer for the host harness
+ *
+ * Replaces lvgl_port.cpp: strips are copied into a memory frame buffer instead
+ * of the RGB panel, and the lock only tracks nesting so the harness can catch
+ * unbalanced lock/unlock pairs.
+ */
+
+#include "lvgl_port.h"
+#include "host_platform.h"
+#include "config.h"
+#include <Arduino.h>
+#include <assert.h>
+
+// Global panel and mutex (unused on the host)
+ESP_Panel *panel = NULL;
+SemaphoreHandle_t lvgl_mux = NULL;
+
+static lv_color_t *host_framebuffer = NULL;
+static uint32_t host_flush_count = 0;
+static int host_lock_depth = 0;
+
+/* Display flushing - copy the strip into the memory frame buffer */
+void lvgl_port_disp_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p)
+{
+    int32_t width = lv_area_get_width(area);
+    for (int32_t y = area->y1; y <= area->y2; y++) {
+        memcpy(&host_framebuffer[y * ESP_PANEL_LCD_H_RES + area->x1], color_p, width * sizeof(lv_color_t));
+        color_p += width;
+    }
+    host_flush_count++;
+    lv_disp_flush_ready(disp);
+}
+
+/* Flush completion callback */
+bool notify_lvgl_flush_ready(void *user_ctx)
+{
+    lv_disp_flush_ready((lv_disp_drv_t *)user_ctx);
+    return false;
+}
+
+/* No touch input on the host */
+void lvgl_port_tp_read(lv_indev_drv_t *indev, lv_indev_data_t *data)
+{
+    data->state = LV_INDEV_STATE_REL;
+}
+
+void lvgl_port_lock_tagged(int timeout_ms, const char *tag)
+{
+    host_lock_depth++;
+}
+
+void lvgl_port_unlock(void)
+{
+    host_lock_depth--;
+}
+
+/* The harness drives lv_timer_handler() itself */
+void lvgl_port_task(void *arg)
+{
+}
+
+/* Nothing sleeps on the host */
+void lvgl_port_wake(void)
+{
+}
+
+void lvgl_port_wake_from_isr(void)
+{
+}
+
+void lvgl_port_get_wake_stats(lvgl_wake_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+}
+
+/* No task cadence or backlight on the host */
+void lvgl_port_set_min_delay(uint32_t ms)
+{
+}
+
+void lvgl_port_set_backlight(uint8_t percent)
+{
+}
+
+void lvgl_port_init(void)
+{
+    /* Initialize LVGL core */
+    lv_init();
+    
+    /* Same strip size as the device so timings are comparable */
+    static lv_disp_draw_buf_t draw_buf;
+    lv_color_t *buf = (lv_color_t *)calloc(LVGL_BUF_SIZE, sizeof(lv_color_t));
+    assert(buf);
+    lv_disp_draw_buf_init(&draw_buf, buf, NULL, LVGL_BUF_SIZE);
+    
+    host_framebuffer = (lv_color_t *)calloc(ESP_PANEL_LCD_H_RES * ESP_PANEL_LCD_V_RES, sizeof(lv_color_t));
+    assert(host_framebuffer);
+    
+    /* Initialize the display device */
+    static lv_disp_drv_t disp_drv;
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = ESP_PANEL_LCD_H_RES;
+    disp_drv.ver_res = ESP_PANEL_LCD_V_RES;
+    disp_drv.flush_cb = lvgl_port_disp_flush;
+    disp_drv.draw_buf = &draw_buf;
+    lv_disp_drv_register(&disp_drv);
+}
+
+void lvgl_port_benchmark(void)
+{
+    printf("Buffer benchmark: device only\r\n");
+}
+
+const lv_color_t *hostFramebuffer() {
+    return host_framebuffer;
+}
+
+uint32_t hostFlushCount() {
+    return host_flush_count;
+}
+
+int hostLockDepth() {
+    return host_lock_depth;
+}
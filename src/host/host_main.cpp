@@ -0,0 +1,406 @@
+/*
+ * Headless rendering harness
+ *
+ * Builds the same UI as the firmware on a memory-backed display, feeds canned
+ * scan fixtures through performWiFiScan() and the UI bus, and renders the graph (full and
+ * zoomed), dashboard, table, AP detail and waterfall views to PPM images. Images that have a golden in
+ * the golden directory are compared against it, so rendering changes can be regression-tested off-device;
+ * an image without one is reported as not compared. Per-frame timings are reported so optimizations
+ * can be measured. With --soak-heap the LVGL allocations of those passes are recorded and replayed for
+ * a simulated week through malloc and the LVGL heap.
+ *
+ * Usage: program [--record] [--verbose] [--golden DIR] [--out DIR] [--tolerance N] [--repeat N] [--quality TIER] [--bench-layout] [--bench-theme] [--bench-touch] [--test-touch] [--bench-table] [--test-sort] [--soak-heap]
+ */
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include "config.h"
+#include "host_platform.h"
+#include "scan_fixtures.h"
+#include "lvgl_port.h"
+#include "wifi_scanner.h"
+#include "ui_views.h"
+#include "ui_handlers.h"
+#include "label_cache.h"
+#include "label_layout.h"
+#include "touch_filter.h"
+#include "render_quality.h"
+#include "graph_viewport.h"
+#include "graph_background.h"
+#include "ui_theme.h"
+#include "waterfall.h"
+#include "table_view.h"
+#include "ui_bus.h"
+#include "lvgl_heap.h"
+
+// Harness options
+static bool record_goldens = false;
+static const char *golden_dir = "host_golden";
+static const char *out_dir = "host_out";
+static int tolerance = 0;                       // Allowed per-channel difference
+static int repeat_count = LVGL_BENCHMARK_FRAMES; // Full redraws averaged per view
+static bool bench_layout = false;               // Also time the SSID label layout pass
+static bool bench_theme = false;                // Also compare local style properties with the shared styles
+static bool bench_touch = false;                // Also replay touch traces through the touch filter
+static bool test_touch = false;                 // Also check the touch filter's debounce, release and bounds
+static bool bench_table = false;                // Also scroll the table through TABLE_BENCHMARK_ROWS networks
+static bool test_sort = false;                  // Also check the table's cached sort orders on random sweeps
+static bool soak_heap = false;                  // Also record LVGL allocations and replay them for a week
+
+// Frame timing for one run of lv_timer_handler() calls
+struct FrameStats {
+    uint32_t frames;
+    uint64_t total_us;
+    uint32_t max_us;
+};
+
+struct HarnessView {
+    const char *name;
+    void (*show)(lv_event_t *e);
+};
+
+// Graph at the full range
+static void showFullGraph(lv_event_t *e) {
+    graphViewportReset();
+    graphBackgroundRefresh();
+    switchToGraphView(e);
+}
+
+// Graph zoomed in on channels 3-9, -80..-30 dBm (as after a pinch has settled)
+static void showZoomedGraph(lv_event_t *e) {
+    GraphViewport zoom = {3.0f, 9.0f, -80.0f, -30.0f};
+    graphViewportSet(&zoom);
+    graphBackgroundRefresh();
+    switchToGraphView(e);
+}
+
+// Shortened graph with the top-N list below it
+static void showDashboard(lv_event_t *e) {
+    graphViewportReset();
+    graphBackgroundRefresh();
+    switchToDashboardView(e);
+}
+
+// Detail screen of the first table row (as after tapping it)
+static void showFirstApDetail(lv_event_t *e) {
+    uint8_t bssid[6];
+    char ssid[33];
+    if (getTableRowNetwork(0, bssid, ssid)) {
+        showApDetail(bssid);
+    } else {
+        switchToTableView(e);
+    }
+}
+
+static const HarnessView views[] = {
+    {"graph", showFullGraph},
+    {"graph_zoom", showZoomedGraph},
+    {"dashboard", showDashboard},
+    {"table", switchToTableView},
+    {"ap_detail", showFirstApDetail},
+    {"waterfall", switchToWaterfallView},
+};
+
+// Advance the virtual clock by one refresh period and let LVGL run
+static void runFrame(FrameStats *stats) {
+    hostClockAdvance(LV_DISP_DEF_REFR_PERIOD);
+    uiBusDrain();  // Scan results, as the device's LVGL task does before each handler run
+    uint32_t flushes = hostFlushCount();
+    uint32_t start = micros();
+    lv_timer_handler();
+    uint32_t elapsed = micros() - start;
+    
+    // Only count frames that actually rendered something
+    if (stats && hostFlushCount() != flushes) {
+        stats->frames++;
+        stats->total_us += elapsed;
+        if (elapsed > stats->max_us) stats->max_us = elapsed;
+    }
+}
+
+// Redraw the whole screen and return the time it took
+static uint32_t timeFullRedraw() {
+    lv_obj_invalidate(lv_scr_act());
+    uint32_t start = micros();
+    lv_refr_now(NULL);
+    return micros() - start;
+}
+
+static bool writePPM(const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f) return false;
+    
+    const lv_color_t *fb = hostFramebuffer();
+    fprintf(f, "P6\n%d %d\n255\n", ESP_PANEL_LCD_H_RES, ESP_PANEL_LCD_V_RES);
+    for (int i = 0; i < ESP_PANEL_LCD_H_RES * ESP_PANEL_LCD_V_RES; i++) {
+        lv_color32_t c;
+        c.full = lv_color_to32(fb[i]);
+        uint8_t rgb[3] = {c.ch.red, c.ch.green, c.ch.blue};
+        fwrite(rgb, 1, 3, f);
+    }
+    fclose(f);
+    return true;
+}
+
+// Load a PPM written by writePPM() (returns NULL if missing or a different size)
+static uint8_t *readPPM(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    
+    int width = 0, height = 0, max_value = 0;
+    uint8_t *data = NULL;
+    if (fscanf(f, "P6 %d %d %d", &width, &height, &max_value) == 3 && fgetc(f) != EOF &&
+        width == ESP_PANEL_LCD_H_RES && height == ESP_PANEL_LCD_V_RES && max_value == 255) {
+        size_t size = (size_t)width * height * 3;
+        data = (uint8_t *)malloc(size);
+        if (data && fread(data, 1, size, f) != size) {
+            free(data);
+            data = NULL;
+        }
+    }
+    fclose(f);
+    return data;
+}
+
+// Compare the frame buffer with the golden; writes a diff image (mismatches in red) on failure
+static uint32_t compareWithGolden(const char *golden_path, const char *diff_path) {
+    uint8_t *golden = readPPM(golden_path);
+    if (!golden) return UINT32_MAX;
+    
+    const lv_color_t *fb = hostFramebuffer();
+    uint32_t mismatches = 0;
+    for (int i = 0; i < ESP_PANEL_LCD_H_RES * ESP_PANEL_LCD_V_RES; i++) {
+        lv_color32_t c;
+        c.full = lv_color_to32(fb[i]);
+        uint8_t *g = &golden[i * 3];
+        bool differs = abs(c.ch.red - g[0]) > tolerance || abs(c.ch.green - g[1]) > tolerance ||
+                       abs(c.ch.blue - g[2]) > tolerance;
+        if (differs) mismatches++;
+        // Reuse the golden buffer for the diff: dimmed golden, mismatches in red
+        g[0] = differs ? 255 : g[0] / 4;
+        g[1] = differs ? 0 : g[1] / 4;
+        g[2] = differs ? 0 : g[2] / 4;
+    }
+    
+    if (mismatches > 0) {
+        FILE *f = fopen(diff_path, "wb");
+        if (f) {
+            fprintf(f, "P6\n%d %d\n255\n", ESP_PANEL_LCD_H_RES, ESP_PANEL_LCD_V_RES);
+            fwrite(golden, 1, ESP_PANEL_LCD_H_RES * ESP_PANEL_LCD_V_RES * 3, f);
+            fclose(f);
+        }
+    }
+    free(golden);
+    return mismatches;
+}
+
+static void makeDir(const char *path) {
+    if (mkdir(path, 0755) != 0 && errno != EEXIST) {
+        printf("Cannot create %s\r\n", path);
+        exit(2);
+    }
+}
+
+// Same screen as setup() in main.cpp
+static void createScreen() {
+    lvgl_port_lock(-1);
+    
+    labelCacheInit();
+    renderQualityInit();
+    graphBackgroundInit();
+    waterfallInit();
+    uiThemeInit();
+    initScanSettings();
+    
+    lv_obj_t *scr = lv_scr_act();
+    lv_obj_add_style(scr, &ui_style_view, LV_PART_MAIN);
+    
+    createGraphView(scr);
+    createMenuBar(scr);
+    switchToGraphView(NULL);
+    startViewReaper();
+    
+    lvgl_port_unlock();
+}
+
+static bool parseArgs(int argc, char **argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--record") == 0 || strcmp(argv[i], "--update") == 0) {
+            record_goldens = true;
+        } else if (strcmp(argv[i], "--verbose") == 0) {
+            hostSetVerbose(true);
+        } else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+            golden_dir = argv[++i];
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            out_dir = argv[++i];
+        } else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            tolerance = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat_count = atoi(argv[++i]);
+            if (repeat_count < 1) repeat_count = 1;
+        } else if (strcmp(argv[i], "--quality") == 0 && i + 1 < argc) {
+            renderQualityForce(atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--bench-layout") == 0) {
+            bench_layout = true;
+        } else if (strcmp(argv[i], "--bench-theme") == 0) {
+            bench_theme = true;
+        } else if (strcmp(argv[i], "--bench-touch") == 0) {
+            bench_touch = true;
+        } else if (strcmp(argv[i], "--test-touch") == 0) {
+            test_touch = true;
+        } else if (strcmp(argv[i], "--bench-table") == 0) {
+            bench_table = true;
+        } else if (strcmp(argv[i], "--test-sort") == 0) {
+            test_sort = true;
+        } else if (strcmp(argv[i], "--soak-heap") == 0) {
+            soak_heap = true;
+        } else {
+            printf("Usage: %s [--record] [--verbose] [--golden DIR] [--out DIR] [--tolerance N] [--repeat N] [--quality TIER] [--bench-layout] [--bench-theme] [--bench-touch] [--test-touch] [--bench-table] [--test-sort] [--soak-heap]\r\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    if (!parseArgs(argc, argv)) return 2;
+    
+    makeDir(out_dir);
+    makeDir(golden_dir);
+    
+    uiBusInit();
+    lvgl_port_init();
+    createScreen();
+    runFrame(NULL);
+    
+    const ScanFixture *fixtures;
+    uint16_t fixture_count = getScanFixtures(&fixtures);
+    int failures = 0;
+    int not_compared = 0;
+    
+    // Each fixture's scan and render pass is one sweep of the allocation trace
+    if (soak_heap) lvgl_heap_trace_start(1u << 21);
+    
+    printf("%-12s %-10s %10s %10s %10s %8s  %-14s %s\r\n", "fixture", "view", "redraw us", "anim avg", "anim max", "frames", "quality", "golden");
+    
+    for (uint16_t f = 0; f < fixture_count; f++) {
+        const ScanFixture *fixture = &fixtures[f];
+        lvgl_heap_trace_mark();
+        
+        // Scan with the graph visible, as on the device, and let the transition finish
+        showFullGraph(NULL);
+        hostSetScanFixture(fixture->records, fixture->count);
+        processScanCommands(0);  // View switches queue commands for the scanner, as on the device
+        performWiFiScan();
+        if (hostLockDepth() != 0) {
+            printf("%s: unbalanced lvgl_port_lock (depth %d)\r\n", fixture->name, hostLockDepth());
+            failures++;
+        }
+        
+        FrameStats anim = {0, 0, 0};
+        uint32_t anim_frames = (GRAPH_ANIM_DURATION_MS + GRAPH_ANIM_MAX_PERIOD_MS) / LV_DISP_DEF_REFR_PERIOD + 2;
+        for (uint32_t i = 0; i < anim_frames; i++) {
+            runFrame(&anim);
+        }
+        
+        for (size_t v = 0; v < sizeof(views) / sizeof(views[0]); v++) {
+            views[v].show(NULL);
+            runFrame(NULL);
+            
+            uint64_t redraw_total = 0;
+            for (int r = 0; r < repeat_count; r++) {
+                redraw_total += timeFullRedraw();
+            }
+            
+            char name[64], out_path[256], golden_path[256], diff_path[256];
+            snprintf(name, sizeof(name), "%s_%s", fixture->name, views[v].name);
+            snprintf(out_path, sizeof(out_path), "%s/%s.ppm", out_dir, name);
+            snprintf(golden_path, sizeof(golden_path), "%s/%s.ppm", golden_dir, name);
+            snprintf(diff_path, sizeof(diff_path), "%s/%s_diff.ppm", out_dir, name);
+            
+            writePPM(out_path);
+            const char *result;
+            char result_buf[32];
+            if (record_goldens) {
+                result = writePPM(golden_path) ? "recorded" : "write failed";
+            } else {
+                uint32_t mismatches = compareWithGolden(golden_path, diff_path);
+                if (mismatches == UINT32_MAX) {
+                    result = "not compared (no golden)";
+                    not_compared++;
+                } else if (mismatches > 0) {
+                    snprintf(result_buf, sizeof(result_buf), "FAIL %lu px", (unsigned long)mismatches);
+                    result = result_buf;
+                    failures++;
+                } else {
+                    result = "ok";
+                }
+            }
+            
+            // The transition timings belong to the graph row
+            bool graph_row = (v == 0);
+            printf("%-12s %-10s %10lu %10lu %10lu %8lu  %-14s %s\r\n", fixture->name, views[v].name,
+                   (unsigned long)(redraw_total / repeat_count),
+                   graph_row && anim.frames ? (unsigned long)(anim.total_us / anim.frames) : 0UL,
+                   graph_row ? (unsigned long)anim.max_us : 0UL,
+                   graph_row ? (unsigned long)anim.frames : 0UL,
+                   graph_row ? renderQualityName(renderQualityGet()) : "", result);
+        }
+    }
+    
+    lvgl_heap_trace_stop();
+    
+    LabelCacheStats cache_stats;
+    labelCacheGetStats(&cache_stats);
+    printf("Label cache: %lu hits, %lu misses, %lu evictions\r\n",
+           (unsigned long)cache_stats.hits, (unsigned long)cache_stats.misses, (unsigned long)cache_stats.evictions);
+    
+    if (bench_layout && !labelLayoutBenchmark(256, 100)) {
+        failures++;
+    }
+    
+    if (bench_theme) {
+        lvgl_port_lock(-1);
+        if (!uiThemeBenchmark()) failures++;
+        lvgl_port_unlock();
+    }
+    
+    if (bench_touch) {
+        touchFilterBenchmark();
+    }
+    
+    if (test_touch && !touchFilterTest()) {
+        failures++;
+    }
+    
+    if (bench_table) {
+        lvgl_port_lock(-1);
+        switchToTableView(NULL);
+        lv_obj_update_layout(lv_scr_act());
+        bool ok = tableViewBenchmark(TABLE_BENCHMARK_ROWS);
+        lvgl_port_unlock();
+        if (!ok) failures++;
+    }
+    
+    if (test_sort) {
+        lvgl_port_lock(-1);
+        bool ok = tableViewSortTest(300);
+        lvgl_port_unlock();
+        if (!ok) failures++;
+    }
+    
+    if (soak_heap && !lvgl_heap_soak(LVGL_HEAP_SOAK_DAYS)) {
+        failures++;
+    }
+    
+    if (not_compared > 0) {
+        printf("%d image(s) not compared: no golden in %s (record with --record)\r\n", not_compared, golden_dir);
+    }
+    if (failures > 0) {
+        printf("%d check(s) failed\r\n", failures);
+        return 1;
+    }
+    return 0;
+}
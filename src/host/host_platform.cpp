@@ -0,0 +1,144 @@
+/*
+ * Host platform layer implementation
+ *
+ * Stands in for the Arduino core and the ESP-IDF WiFi scan API. Time is split
+ * in two: millis() (and with it the LVGL tick) is a virtual clock the harness
+ * advances frame by frame, so animations render identically on every run,
+ * while micros() reads the real clock so draw timings stay meaningful.
+ * FreeRTOS queues are plain ring buffers, since the harness is one thread,
+ * and task introspection reports that one thread.
+ */
+
+#include "host_platform.h"
+#include <Arduino.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include <stdarg.h>
+#include <time.h>
+
+HardwareSerial Serial;
+
+static uint32_t virtual_millis = 0;
+static bool serial_verbose = false;
+
+// Scan results returned by the next esp_wifi_scan_get_ap_records()
+static const wifi_ap_record_t *fixture_records = NULL;
+static uint16_t fixture_count = 0;
+
+uint32_t millis(void) {
+    return virtual_millis;
+}
+
+uint32_t micros(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000);
+}
+
+void delay(uint32_t ms) {
+    virtual_millis += ms;
+}
+
+void hostClockAdvance(uint32_t ms) {
+    virtual_millis += ms;
+}
+
+void hostSetVerbose(bool verbose) {
+    serial_verbose = verbose;
+}
+
+int HardwareSerial::printf(const char *format, ...) {
+    if (!serial_verbose) return 0;
+    va_list args;
+    va_start(args, format);
+    int written = vprintf(format, args);
+    va_end(args);
+    return written;
+}
+
+size_t HardwareSerial::print(const char *text) {
+    if (!serial_verbose) return 0;
+    return fputs(text, stdout) < 0 ? 0 : strlen(text);
+}
+
+size_t HardwareSerial::println(const char *text) {
+    if (!serial_verbose) return 0;
+    return ::printf("%s\r\n", text);
+}
+
+void hostSetScanFixture(const wifi_ap_record_t *records, uint16_t count) {
+    fixture_records = records;
+    fixture_count = count;
+}
+
+esp_err_t esp_wifi_scan_start(const wifi_scan_config_t *config, bool block) {
+    (void)config;
+    (void)block;
+    return ESP_OK;
+}
+
+esp_err_t esp_wifi_scan_get_ap_records(uint16_t *number, wifi_ap_record_t *ap_records) {
+    uint16_t count = (fixture_count < *number) ? fixture_count : *number;
+    if (count > 0) memcpy(ap_records, fixture_records, count * sizeof(wifi_ap_record_t));
+    *number = count;
+    return ESP_OK;
+}
+
+// Ring buffer behind a FreeRTOS queue handle
+struct HostQueue {
+    uint8_t *items;
+    UBaseType_t length;
+    UBaseType_t item_size;
+    UBaseType_t head;
+    UBaseType_t count;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size) {
+    HostQueue *queue = (HostQueue *)calloc(1, sizeof(HostQueue));
+    queue->items = (uint8_t *)calloc(length, item_size);
+    queue->length = length;
+    queue->item_size = item_size;
+    return queue;
+}
+
+BaseType_t xQueueSend(QueueHandle_t handle, const void *item, TickType_t wait) {
+    (void)wait;
+    HostQueue *queue = (HostQueue *)handle;
+    if (queue->count == queue->length) return pdFALSE;
+    UBaseType_t tail = (queue->head + queue->count) % queue->length;
+    memcpy(queue->items + tail * queue->item_size, item, queue->item_size);
+    queue->count++;
+    return pdTRUE;
+}
+
+// Replace the item of a one-slot queue (mailbox)
+BaseType_t xQueueOverwrite(QueueHandle_t handle, const void *item) {
+    HostQueue *queue = (HostQueue *)handle;
+    queue->count = 0;
+    return xQueueSend(handle, item, 0);
+}
+
+BaseType_t xQueueReceive(QueueHandle_t handle, void *item, TickType_t wait) {
+    (void)wait;
+    HostQueue *queue = (HostQueue *)handle;
+    if (queue->count == 0) return pdFALSE;
+    memcpy(item, queue->items + queue->head * queue->item_size, queue->item_size);
+    queue->head = (queue->head + 1) % queue->length;
+    queue->count--;
+    return pdTRUE;
+}
+
+UBaseType_t uxTaskGetNumberOfTasks(void) {
+    return 1;
+}
+
+// The harness thread, with its stack treated as never used
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *status, UBaseType_t size, uint32_t *total_run_time) {
+    if (size < 1) return 0;
+    status[0].xHandle = NULL;
+    status[0].pcTaskName = "host";
+    status[0].uxCurrentPriority = 1;
+    status[0].usStackHighWaterMark = 8 * 1024;
+    if (total_run_time != NULL) *total_run_time = 0;
+    return 1;
+}
@@ -0,0 +1,19 @@
+/*
+ * Host platform layer for the headless rendering harness
+ */
+
+#ifndef HOST_PLATFORM_H
+#define HOST_PLATFORM_H
+
+#include <lvgl.h>
+#include "esp_wifi.h"
+
+// Functions
+void hostClockAdvance(uint32_t ms);
+void hostSetVerbose(bool verbose);
+void hostSetScanFixture(const wifi_ap_record_t *records, uint16_t count);
+const lv_color_t *hostFramebuffer();
+uint32_t hostFlushCount();
+int hostLockDepth();
+
+#endif // HOST_PLATFORM_H
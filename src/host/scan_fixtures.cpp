@@ -0,0 +1,77 @@
+/*
+ * Canned scan results implementation
+ *
+ * Fixtures run in order, so later ones also exercise the transition from the
+ * previous sweep (matched by BSSID).
+ */
+
+#include "scan_fixtures.h"
+#include <stdio.h>
+#include <string.h>
+
+// A typical apartment: a handful of networks, some 40 MHz, one hidden
+static const wifi_ap_record_t home_records[] = {
+    {{0x3c, 0x84, 0x6a, 0x10, 0x00, 0x01}, "HomeNet", 6, WIFI_SECOND_CHAN_NONE, -38, WIFI_AUTH_WPA2_PSK},
+    {{0x3c, 0x84, 0x6a, 0x10, 0x00, 0x02}, "HomeNet-Guest", 6, WIFI_SECOND_CHAN_NONE, -41, WIFI_AUTH_OPEN},
+    {{0xa4, 0x2b, 0xb0, 0x22, 0x10, 0x07}, "Neighbour 2.4", 1, WIFI_SECOND_CHAN_ABOVE, -63, WIFI_AUTH_WPA2_WPA3_PSK},
+    {{0xf0, 0x9f, 0xc2, 0x31, 0x7a, 0x11}, "PrinterSetup", 11, WIFI_SECOND_CHAN_NONE, -70, WIFI_AUTH_WPA_WPA2_PSK},
+    {{0x00, 0x1d, 0x7e, 0x45, 0x02, 0x33}, "", 11, WIFI_SECOND_CHAN_BELOW, -76, WIFI_AUTH_WPA2_PSK},
+    {{0x28, 0x6c, 0x07, 0x5a, 0x91, 0x02}, "CoffeeShop Free WiFi", 3, WIFI_SECOND_CHAN_NONE, -82, WIFI_AUTH_OPEN},
+    {{0x90, 0x72, 0x40, 0x08, 0x33, 0x5e}, "OfficeCorp", 13, WIFI_SECOND_CHAN_NONE, -88, WIFI_AUTH_WPA2_ENTERPRISE},
+};
+
+// The same apartment one sweep later: levels moved, one network gone, one new
+static const wifi_ap_record_t home_moved_records[] = {
+    {{0x3c, 0x84, 0x6a, 0x10, 0x00, 0x01}, "HomeNet", 6, WIFI_SECOND_CHAN_NONE, -45, WIFI_AUTH_WPA2_PSK},
+    {{0x3c, 0x84, 0x6a, 0x10, 0x00, 0x02}, "HomeNet-Guest", 6, WIFI_SECOND_CHAN_NONE, -47, WIFI_AUTH_OPEN},
+    {{0xa4, 0x2b, 0xb0, 0x22, 0x10, 0x07}, "Neighbour 2.4", 1, WIFI_SECOND_CHAN_ABOVE, -58, WIFI_AUTH_WPA2_WPA3_PSK},
+    {{0x00, 0x1d, 0x7e, 0x45, 0x02, 0x33}, "", 11, WIFI_SECOND_CHAN_BELOW, -80, WIFI_AUTH_WPA2_PSK},
+    {{0x28, 0x6c, 0x07, 0x5a, 0x91, 0x02}, "CoffeeShop Free WiFi", 3, WIFI_SECOND_CHAN_NONE, -74, WIFI_AUTH_OPEN},
+    {{0x90, 0x72, 0x40, 0x08, 0x33, 0x5e}, "OfficeCorp", 13, WIFI_SECOND_CHAN_NONE, -86, WIFI_AUTH_WPA2_ENTERPRISE},
+    {{0x5c, 0xe9, 0x31, 0x6d, 0x20, 0x44}, "DIRECT-7F-TV", 9, WIFI_SECOND_CHAN_NONE, -67, WIFI_AUTH_WPA2_PSK},
+};
+
+// Worst case: the full 64 networks crowded onto the common channels
+static wifi_ap_record_t crowded_records[64];
+
+static const ScanFixture fixtures[] = {
+    {"empty", NULL, 0},
+    {"home", home_records, sizeof(home_records) / sizeof(home_records[0])},
+    {"home_moved", home_moved_records, sizeof(home_moved_records) / sizeof(home_moved_records[0])},
+    {"crowded", crowded_records, 64},
+};
+
+// Fill the crowded fixture with a fixed pseudo-random sequence (identical on every run)
+static void buildCrowdedRecords() {
+    static const uint8_t channels[] = {1, 1, 6, 6, 6, 11, 11, 3, 9, 13};
+    static const wifi_auth_mode_t auth_modes[] = {WIFI_AUTH_WPA2_PSK, WIFI_AUTH_WPA2_WPA3_PSK, WIFI_AUTH_OPEN, WIFI_AUTH_WPA3_PSK};
+    uint32_t seed = 0x2545F491;
+    
+    for (int i = 0; i < 64; i++) {
+        wifi_ap_record_t *rec = &crowded_records[i];
+        memset(rec, 0, sizeof(*rec));
+        seed = seed * 1103515245 + 12345;
+        uint32_t r = seed >> 8;
+        
+        rec->bssid[0] = 0x02;  // Locally administered
+        rec->bssid[4] = (uint8_t)(r >> 8);
+        rec->bssid[5] = (uint8_t)i;
+        rec->primary = channels[r % sizeof(channels)];
+        rec->second = (r % 7 == 0) ? WIFI_SECOND_CHAN_ABOVE : WIFI_SECOND_CHAN_NONE;
+        rec->rssi = (int8_t)(-35 - (int)((r >> 4) % 60));
+        rec->authmode = auth_modes[(r >> 12) % 4];
+        if (i % 9 != 8) {
+            snprintf((char *)rec->ssid, sizeof(rec->ssid), "Flat-%02d-%04X", i, (unsigned)(r & 0xffff));
+        }
+    }
+}
+
+uint16_t getScanFixtures(const ScanFixture **out) {
+    static bool built = false;
+    if (!built) {
+        buildCrowdedRecords();
+        built = true;
+    }
+    *out = fixtures;
+    return sizeof(fixtures) / sizeof(fixtures[0]);
+}
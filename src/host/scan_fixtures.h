@@ -0,0 +1,19 @@
+/*
+ * Canned scan results for the host harness
+ */
+
+#ifndef SCAN_FIXTURES_H
+#define SCAN_FIXTURES_H
+
+#include "esp_wifi.h"
+
+struct ScanFixture {
+    const char *name;
+    const wifi_ap_record_t *records;
+    uint16_t count;
+};
+
+// Functions
+uint16_t getScanFixtures(const ScanFixture **fixtures);
+
+#endif // SCAN_FIXTURES_H
@@ -0,0 +1,41 @@
+/*
+ * Host stand-in for the Arduino core (headless rendering harness only)
+ *
+ * Also pulled into the LVGL C sources through LV_TICK_CUSTOM_INCLUDE, so the
+ * C++ parts are guarded.
+ */
+
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Functions
+uint32_t millis(void);   // Virtual clock, advanced by the harness
+uint32_t micros(void);   // Real monotonic clock, used for timing
+void delay(uint32_t ms);
+
+#ifdef __cplusplus
+}
+
+// Minimal Serial: output goes to stdout only when the harness runs verbose
+class HardwareSerial {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    int printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+    size_t print(const char *text);
+    size_t println(const char *text = "");
+};
+
+extern HardwareSerial Serial;
+#endif
+
+#endif // ARDUINO_H
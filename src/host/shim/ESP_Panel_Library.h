@@ -0,0 +1,12 @@
+/*
+ * Host stand-in for ESP32_Display_Panel (panel resolution only)
+ */
+
+#ifndef ESP_PANEL_LIBRARY_H
+#define ESP_PANEL_LIBRARY_H
+
+#include "ESP_Panel_Conf.h"
+
+class ESP_Panel;
+
+#endif // ESP_PANEL_LIBRARY_H
@@ -0,0 +1,44 @@
+/*
+ * Host stand-in for the Arduino Preferences library (in-memory, not persisted)
+ */
+
+#ifndef PREFERENCES_H
+#define PREFERENCES_H
+
+#include <stdint.h>
+#include <string.h>
+
+class Preferences {
+public:
+    bool begin(const char *name, bool read_only = false) { (void)name; (void)read_only; return true; }
+    void end() {}
+    
+    size_t putUChar(const char *key, uint8_t value) {
+        int slot = find(key, true);
+        if (slot < 0) return 0;
+        values[slot] = value;
+        return 1;
+    }
+    
+    uint8_t getUChar(const char *key, uint8_t default_value = 0) {
+        int slot = find(key, false);
+        return (slot < 0) ? default_value : values[slot];
+    }
+    
+private:
+    static const int MAX_KEYS = 16;
+    char keys[MAX_KEYS][16] = {};
+    uint8_t values[MAX_KEYS] = {};
+    int key_count = 0;
+    
+    int find(const char *key, bool create) {
+        for (int i = 0; i < key_count; i++) {
+            if (strncmp(keys[i], key, sizeof(keys[i]) - 1) == 0) return i;
+        }
+        if (!create || key_count >= MAX_KEYS) return -1;
+        strncpy(keys[key_count], key, sizeof(keys[key_count]) - 1);
+        return key_count++;
+    }
+};
+
+#endif // PREFERENCES_H
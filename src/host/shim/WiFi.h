@@ -0,0 +1,10 @@
+/*
+ * Host stand-in for the Arduino WiFi library
+ */
+
+#ifndef WIFI_H
+#define WIFI_H
+
+#include "esp_wifi.h"
+
+#endif // WIFI_H
@@ -0,0 +1,29 @@
+/*
+ * Host stand-in for the ESP-IDF capability-based heap
+ */
+
+#ifndef ESP_HEAP_CAPS_H
+#define ESP_HEAP_CAPS_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <malloc.h>
+
+#define MALLOC_CAP_8BIT     (1 << 2)
+#define MALLOC_CAP_DMA      (1 << 3)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+#define MALLOC_CAP_INTERNAL (1 << 11)
+
+// All capabilities map to the host heap
+static inline void *heap_caps_malloc(size_t size, uint32_t caps) { (void)caps; return malloc(size); }
+static inline void *heap_caps_calloc(size_t n, size_t size, uint32_t caps) { (void)caps; return calloc(n, size); }
+static inline void *heap_caps_aligned_alloc(size_t alignment, size_t size, uint32_t caps) { (void)caps; return aligned_alloc(alignment, size); }
+static inline void heap_caps_free(void *ptr) { free(ptr); }
+
+// Notional 8 MB heap minus what is allocated, so before/after differences are real
+static inline size_t heap_caps_get_free_size(uint32_t caps) { (void)caps; return (8u << 20) - mallinfo2().uordblks; }
+static inline size_t heap_caps_get_largest_free_block(uint32_t caps) { return heap_caps_get_free_size(caps); }
+static inline size_t heap_caps_get_minimum_free_size(uint32_t caps) { return heap_caps_get_free_size(caps); }
+static inline size_t heap_caps_get_total_size(uint32_t caps) { (void)caps; return 8u << 20; }
+
+#endif // ESP_HEAP_CAPS_H
@@ -0,0 +1,19 @@
+/*
+ * Host stand-in for FreeRTOS (types used by the LVGL port and UI bus headers)
+ */
+
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define portMAX_DELAY      ((TickType_t)0xffffffffUL)
+#define pdMS_TO_TICKS(ms)  ((TickType_t)(ms))
+#define pdFALSE            ((BaseType_t)0)
+#define pdTRUE             ((BaseType_t)1)
+
+#endif // FREERTOS_H
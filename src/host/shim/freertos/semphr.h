@@ -0,0 +1,12 @@
+/*
+ * Host stand-in for FreeRTOS semaphores
+ */
+
+#ifndef SEMPHR_H
+#define SEMPHR_H
+
+#include "FreeRTOS.h"
+
+typedef void *SemaphoreHandle_t;
+
+#endif // SEMPHR_H
@@ -0,0 +1,24 @@
+/*
+ * Host stand-in for FreeRTOS task introspection (the harness is one task)
+ */
+
+#ifndef TASK_H
+#define TASK_H
+
+#include "FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+
+// Fields the telemetry reads
+typedef struct {
+    TaskHandle_t xHandle;
+    const char *pcTaskName;
+    UBaseType_t uxCurrentPriority;
+    uint32_t usStackHighWaterMark;
+} TaskStatus_t;
+
+// Functions
+UBaseType_t uxTaskGetNumberOfTasks(void);
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *status, UBaseType_t size, uint32_t *total_run_time);
+
+#endif // TASK_H
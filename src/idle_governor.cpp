@@ -0,0 +1,99 @@
+/*
+ * Idle governor implementation
+ *
+ * A survey unit spends most of its time in a pocket or on a tripod, so once
+ * nobody has touched the screen for IDLE_THROTTLE_MS the governor stretches
+ * the display refresh period and the LVGL task's shortest sleep, asks the
+ * scanner for a longer pause between sweeps and dims the backlight; after
+ * IDLE_OFF_MS the backlight goes off. Inactivity is LVGL's own
+ * lv_disp_get_inactive_time(), and the check timer is set to fire exactly
+ * when the next step is due (and paused once the backlight is off), so the
+ * governor adds no periodic wakeups of its own. The touch driver calls
+ * idleGovernorTouch() on every read with a finger down, which restores full
+ * speed before LVGL processes the touch; the touch that lights a dark screen
+ * is not passed on, so it cannot press whatever was under the finger.
+ */
+
+#include "idle_governor.h"
+#include "lvgl_port.h"
+#include "ui_bus.h"
+#include "config.h"
+#include <Arduino.h>
+#include <lvgl.h>
+
+#if IDLE_GOVERNOR
+enum IdleState {
+    IDLE_ACTIVE,        // Full refresh rate, scan interval and brightness
+    IDLE_THROTTLED,     // Slower refresh and scanning, dimmed backlight
+    IDLE_OFF            // Backlight off as well
+};
+
+static IdleState idle_state = IDLE_ACTIVE;
+static lv_timer_t *idle_timer = NULL;
+
+static void applyState(IdleState state) {
+    if (state == idle_state) return;
+    bool slow = state != IDLE_ACTIVE;
+    
+    lv_timer_t *refr_timer = _lv_disp_get_refr_timer(lv_disp_get_default());
+    if (refr_timer != NULL) lv_timer_set_period(refr_timer, slow ? IDLE_REFR_PERIOD_MS : LV_DISP_DEF_REFR_PERIOD);
+    lvgl_port_set_min_delay(slow ? IDLE_TASK_MIN_DELAY_MS : LVGL_TASK_MIN_DELAY_MS);
+    if (slow != (idle_state != IDLE_ACTIVE)) {
+        uiBusSendCommand(SCAN_CMD_INTERVAL, slow ? IDLE_SCAN_INTERVAL_MS : SCAN_INTERVAL_MS, NULL);
+    }
+    lvgl_port_set_backlight(state == IDLE_OFF ? 0 : (slow ? IDLE_DIM_PERCENT : 100));
+    
+    static const char *names[] = {"active", "throttled", "display off"};
+    printf("Idle governor: %s\r\n", names[state]);
+    idle_state = state;
+}
+
+// Move to the state the inactivity calls for and sleep until the next step
+static void idleTimerCallback(lv_timer_t *timer) {
+    uint32_t inactive = lv_disp_get_inactive_time(NULL);
+    if (IDLE_OFF_MS > 0 && inactive >= IDLE_OFF_MS) {
+        applyState(IDLE_OFF);
+        lv_timer_pause(timer);      // Only a touch brings the screen back
+        return;
+    }
+    
+    uint32_t next_ms;
+    if (inactive >= IDLE_THROTTLE_MS) {
+        applyState(IDLE_THROTTLED);
+        next_ms = (IDLE_OFF_MS > 0) ? IDLE_OFF_MS - inactive : 0;
+    } else {
+        applyState(IDLE_ACTIVE);
+        next_ms = IDLE_THROTTLE_MS - inactive;
+    }
+    if (next_ms == 0) {
+        lv_timer_pause(timer);
+        return;
+    }
+    lv_timer_set_period(timer, next_ms < IDLE_MIN_CHECK_MS ? IDLE_MIN_CHECK_MS : next_ms);
+}
+#endif
+
+// Start watching for inactivity (LVGL lock held)
+void idleGovernorInit() {
+#if IDLE_GOVERNOR
+    idle_timer = lv_timer_create(idleTimerCallback, IDLE_THROTTLE_MS, NULL);
+#endif
+}
+
+// Touch driver, finger down: back to full speed at once. True if the screen was dark (swallow this touch)
+bool idleGovernorTouch() {
+#if IDLE_GOVERNOR
+    if (idle_state == IDLE_ACTIVE) return false;
+    bool was_off = idle_state == IDLE_OFF;
+    lv_disp_trig_activity(NULL);
+    applyState(IDLE_ACTIVE);
+    if (idle_timer != NULL) {
+        lv_timer_set_period(idle_timer, IDLE_THROTTLE_MS);
+        lv_timer_reset(idle_timer);
+        lv_timer_resume(idle_timer);
+    }
+    return was_off;
+#else
+    return false;
+#endif
+}
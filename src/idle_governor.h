@@ -0,0 +1,12 @@
+/*
+ * Idle governor (slower refresh and scanning, dimmed backlight while untouched)
+ */
+
+#ifndef IDLE_GOVERNOR_H
+#define IDLE_GOVERNOR_H
+
+// Functions (LVGL task or LVGL lock held)
+void idleGovernorInit();
+bool idleGovernorTouch();
+
+#endif // IDLE_GOVERNOR_H
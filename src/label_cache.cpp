@@ -0,0 +1,167 @@
+/*
+ * Pre-rendered label bitmap cache implementation
+ *
+ * Shaping and anti-aliasing glyphs is one of the most expensive parts of a
+ * graph frame, yet the SSID labels rarely change. Each label is rendered once
+ * into a PSRAM RGB565+alpha bitmap through a hidden canvas and then blitted on
+ * every frame. Entries are keyed by text, font and colour, so a change to any
+ * of them simply misses and the least recently used entry is reused.
+ *
+ * Rasterizing goes through the canvas, i.e. a nested draw, so it must not
+ * happen inside a draw callback. labelCachePrepare() renders missing labels
+ * when the data changes, outside refresh; labelCacheDraw() only looks them up
+ * and falls back to lv_draw_label for anything that was not prepared.
+ */
+
+#include "label_cache.h"
+#include "config.h"
+#include <Arduino.h>
+#include "esp_heap_caps.h"
+#include <string.h>
+
+// One cached bitmap
+struct LabelCacheEntry {
+    bool valid;
+    uint32_t hash;
+    const lv_font_t *font;
+    lv_color_t color;
+    char text[33];
+    uint32_t last_used;
+    uint8_t *buf;       // LV_CANVAS_BUF_SIZE_TRUE_COLOR_ALPHA(MAX_WIDTH, MAX_HEIGHT) bytes
+    lv_img_dsc_t img;   // Describes the used part of buf
+};
+
+static LabelCacheEntry cache_entries[LABEL_CACHE_ENTRIES];
+static lv_obj_t *render_canvas = NULL;  // Hidden canvas used to rasterize misses
+static uint32_t use_counter = 0;
+static LabelCacheStats cache_stats = {0, 0, 0};
+
+// FNV-1a hash of the label text
+static uint32_t hashText(const char *text) {
+    uint32_t h = 2166136261u;
+    while (*text) {
+        h ^= (uint8_t)*text++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Allocate the bitmap slots and the render canvas (call once with the LVGL lock held)
+bool labelCacheInit() {
+    size_t slot_size = LV_CANVAS_BUF_SIZE_TRUE_COLOR_ALPHA(LABEL_CACHE_MAX_WIDTH, LABEL_CACHE_MAX_HEIGHT);
+    uint8_t *pool = (uint8_t *)heap_caps_malloc(slot_size * LABEL_CACHE_ENTRIES, MALLOC_CAP_SPIRAM);
+    if (pool == NULL) {
+        printf("Label cache: failed to allocate %u bytes in PSRAM\r\n", (unsigned)(slot_size * LABEL_CACHE_ENTRIES));
+        return false;
+    }
+    for (int i = 0; i < LABEL_CACHE_ENTRIES; i++) {
+        cache_entries[i].valid = false;
+        cache_entries[i].buf = pool + i * slot_size;
+    }
+    
+    render_canvas = lv_canvas_create(lv_layer_sys());
+    lv_obj_add_flag(render_canvas, LV_OBJ_FLAG_HIDDEN);
+    return true;
+}
+
+// Find the entry for this label, or NULL (victim gets the slot to reuse on a miss)
+static LabelCacheEntry *find(const char *text, const lv_font_t *font, lv_color_t color, LabelCacheEntry **victim) {
+    uint32_t hash = hashText(text);
+    *victim = &cache_entries[0];
+    
+    for (int i = 0; i < LABEL_CACHE_ENTRIES; i++) {
+        LabelCacheEntry *entry = &cache_entries[i];
+        if (entry->valid && entry->hash == hash && entry->font == font &&
+            entry->color.full == color.full && strcmp(entry->text, text) == 0) {
+            return entry;
+        }
+        if (!entry->valid || ((*victim)->valid && entry->last_used < (*victim)->last_used)) {
+            *victim = entry;
+        }
+    }
+    return NULL;
+}
+
+// Rasterize a label into the LRU slot if it is not cached yet (LVGL lock held, not from a draw callback)
+void labelCachePrepare(const char *text, const lv_font_t *font, lv_color_t color) {
+    if (render_canvas == NULL || strlen(text) >= sizeof(cache_entries[0].text)) return;
+    LabelCacheEntry *victim;
+    LabelCacheEntry *entry = find(text, font, color, &victim);
+    if (entry != NULL) {
+        entry->last_used = ++use_counter;
+        return;
+    }
+    
+    // Miss: measure, then rasterize once into the victim slot
+    lv_point_t size;
+    lv_txt_get_size(&size, text, font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    if (size.x <= 0 || size.x > LABEL_CACHE_MAX_WIDTH || size.y > LABEL_CACHE_MAX_HEIGHT) {
+        return;
+    }
+    cache_stats.misses++;
+    if (victim->valid) cache_stats.evictions++;
+    
+    lv_canvas_set_buffer(render_canvas, victim->buf, size.x, size.y, LV_IMG_CF_TRUE_COLOR_ALPHA);
+    lv_canvas_fill_bg(render_canvas, color, LV_OPA_TRANSP);
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    label_dsc.font = font;
+    label_dsc.color = color;
+    lv_canvas_draw_text(render_canvas, 0, 0, size.x, &label_dsc, text);
+    
+    victim->valid = true;
+    victim->hash = hashText(text);
+    victim->font = font;
+    victim->color = color;
+    strncpy(victim->text, text, sizeof(victim->text) - 1);
+    victim->text[sizeof(victim->text) - 1] = '\0';
+    victim->last_used = ++use_counter;
+    victim->img.header.always_zero = 0;
+    victim->img.header.w = size.x;
+    victim->img.header.h = size.y;
+    victim->img.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    victim->img.data_size = LV_CANVAS_BUF_SIZE_TRUE_COLOR_ALPHA(size.x, size.y);
+    victim->img.data = victim->buf;
+}
+
+// Draw a label at the top-left of area, clipped to area (lookup only; falls back to lv_draw_label)
+void labelCacheDraw(lv_draw_ctx_t *draw_ctx, const lv_area_t *area, const char *text, const lv_font_t *font, lv_color_t color) {
+    LabelCacheEntry *entry = NULL;
+    if (render_canvas && strlen(text) < sizeof(entry->text)) {
+        LabelCacheEntry *victim;
+        entry = find(text, font, color, &victim);
+    }
+    
+    if (entry == NULL) {
+        lv_draw_label_dsc_t label_dsc;
+        lv_draw_label_dsc_init(&label_dsc);
+        label_dsc.font = font;
+        label_dsc.color = color;
+        lv_draw_label(draw_ctx, &label_dsc, area, text, NULL);
+        return;
+    }
+    
+    // A frame draws the label once per strip it spans: count the hit in the strip holding its first line
+    entry->last_used = ++use_counter;
+    if (area->y1 >= draw_ctx->clip_area->y1 && area->y1 <= draw_ctx->clip_area->y2) {
+        cache_stats.hits++;
+    }
+    
+    // Clip the blit to the requested area, like lv_draw_label would
+    lv_area_t clip;
+    if (!_lv_area_intersect(&clip, area, draw_ctx->clip_area)) return;
+    const lv_area_t *clip_ori = draw_ctx->clip_area;
+    draw_ctx->clip_area = &clip;
+    
+    lv_draw_img_dsc_t img_dsc;
+    lv_draw_img_dsc_init(&img_dsc);
+    lv_area_t img_area = {area->x1, area->y1,
+                          (lv_coord_t)(area->x1 + entry->img.header.w - 1), (lv_coord_t)(area->y1 + entry->img.header.h - 1)};
+    lv_draw_img(draw_ctx, &img_dsc, &img_area, &entry->img);
+    
+    draw_ctx->clip_area = clip_ori;
+}
+
+void labelCacheGetStats(LabelCacheStats *stats) {
+    *stats = cache_stats;
+}
@@ -0,0 +1,23 @@
+/*
+ * Pre-rendered label bitmap cache
+ */
+
+#ifndef LABEL_CACHE_H
+#define LABEL_CACHE_H
+
+#include <lvgl.h>
+
+// Cache counters (for tuning LABEL_CACHE_ENTRIES)
+struct LabelCacheStats {
+    uint32_t hits;          // Labels blitted from the cache, once per frame
+    uint32_t misses;        // Labels rasterized by labelCachePrepare()
+    uint32_t evictions;
+};
+
+// Functions
+bool labelCacheInit();
+void labelCachePrepare(const char *text, const lv_font_t *font, lv_color_t color);
+void labelCacheDraw(lv_draw_ctx_t *draw_ctx, const lv_area_t *area, const char *text, const lv_font_t *font, lv_color_t color);
+void labelCacheGetStats(LabelCacheStats *stats);
+
+#endif // LABEL_CACHE_H
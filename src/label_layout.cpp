@@ -0,0 +1,169 @@
+/*
+ * SSID label placement implementation
+ *
+ * Labels are placed greedily in priority order. Each candidate position is
+ * checked only against labels already registered in the spatial buckets it
+ * overlaps, so a pass stays linear in the number of labels. A label with no
+ * free candidate is counted into a "+N" badge for its column instead of being
+ * drawn on top of others.
+ */
+
+#include "label_layout.h"
+#include "config.h"
+#include <Arduino.h>
+#include <string.h>
+
+#define GRID_COLS ((INFO_WINDOW_WIDTH + LABEL_GRID_CELL_WIDTH - 1) / LABEL_GRID_CELL_WIDTH)
+#define GRID_ROWS ((INFO_WINDOW_HEIGHT + LABEL_GRID_CELL_HEIGHT - 1) / LABEL_GRID_CELL_HEIGHT)
+
+// Bucket grid of placed label indices
+static uint16_t grid_items[GRID_ROWS][GRID_COLS][LABEL_GRID_CELL_CAPACITY];
+static uint8_t grid_counts[GRID_ROWS][GRID_COLS];
+
+static inline int clampInt(int v, int lo, int hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+// Range of buckets covered by a box
+static inline void cellRange(int x, int y, int w, int h, int *c0, int *c1, int *r0, int *r1) {
+    *c0 = clampInt(x / LABEL_GRID_CELL_WIDTH, 0, GRID_COLS - 1);
+    *c1 = clampInt((x + w - 1) / LABEL_GRID_CELL_WIDTH, 0, GRID_COLS - 1);
+    *r0 = clampInt(y / LABEL_GRID_CELL_HEIGHT, 0, GRID_ROWS - 1);
+    *r1 = clampInt((y + h - 1) / LABEL_GRID_CELL_HEIGHT, 0, GRID_ROWS - 1);
+}
+
+// True if the box overlaps a placed label (or touches a full bucket)
+static bool collides(const LabelLayoutItem *items, int x, int y, int w, int h) {
+    int c0, c1, r0, r1;
+    cellRange(x, y, w, h, &c0, &c1, &r0, &r1);
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            uint8_t n = grid_counts[r][c];
+            if (n >= LABEL_GRID_CELL_CAPACITY) return true;
+            for (uint8_t k = 0; k < n; k++) {
+                const LabelLayoutItem *other = &items[grid_items[r][c][k]];
+                if (x < other->x + other->width && other->x < x + w &&
+                    y < other->y + other->height && other->y < y + h) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+static void registerLabel(uint16_t index, const LabelLayoutItem *item) {
+    int c0, c1, r0, r1;
+    cellRange(item->x, item->y, item->width, item->height, &c0, &c1, &r0, &r1);
+    for (int r = r0; r <= r1; r++) {
+        for (int c = c0; c <= c1; c++) {
+            if (grid_counts[r][c] < LABEL_GRID_CELL_CAPACITY) {
+                grid_items[r][c][grid_counts[r][c]++] = index;
+            }
+        }
+    }
+}
+
+// Place labels inside [min, max] and return the number of badges written
+uint16_t layoutLabels(LabelLayoutItem *items, uint16_t count,
+                      int16_t min_x, int16_t min_y, int16_t max_x, int16_t max_y,
+                      LabelBadge *badges, uint16_t max_badges) {
+    memset(grid_counts, 0, sizeof(grid_counts));
+    uint16_t badge_count = 0;
+    
+    for (uint16_t i = 0; i < count; i++) {
+        LabelLayoutItem *item = &items[i];
+        int w = item->width;
+        int h = item->height;
+        item->placed = false;
+        
+        // Candidates: centred above the oval, nudged left/right, then stacked higher
+        static const int8_t dx_steps[] = {0, -1, 1};
+        for (int level = 0; level < 3 && !item->placed; level++) {
+            for (int k = 0; k < 3; k++) {
+                int x = item->anchor_x - w / 2 + dx_steps[k] * (w / 2);
+                int y = item->anchor_y - h - level * h;
+                x = clampInt(x, min_x, max_x - w + 1);
+                y = clampInt(y, min_y, max_y - h + 1);
+                if (!collides(items, x, y, w, h)) {
+                    item->x = x;
+                    item->y = y;
+                    item->placed = true;
+                    registerLabel(i, item);
+                    break;
+                }
+            }
+        }
+        if (item->placed) continue;
+        
+        // Collapse into the badge for this column
+        int column = clampInt(item->anchor_x / LABEL_GRID_CELL_WIDTH, 0, GRID_COLS - 1);
+        uint16_t b = 0;
+        while (b < badge_count && badges[b].x / LABEL_GRID_CELL_WIDTH != column) b++;
+        if (b == badge_count) {
+            if (badge_count == max_badges) continue;
+            badges[b].x = column * LABEL_GRID_CELL_WIDTH + LABEL_GRID_CELL_WIDTH / 2 - 8;
+            badges[b].y = clampInt(item->anchor_y - h, min_y, max_y - h + 1);
+            badges[b].count = 0;
+            badge_count++;
+        }
+        badges[b].count++;
+    }
+    return badge_count;
+}
+
+// Time layoutLabels on a crowded synthetic scene; false if a pass is over
+// LABEL_LAYOUT_BUDGET_US or the result overlaps or leaves the plot
+bool labelLayoutBenchmark(uint16_t count, uint16_t iterations) {
+    static LabelLayoutItem items[256];
+    static LabelBadge badges[LABEL_MAX_BADGES];
+    if (count > 256) count = 256;
+    if (iterations == 0) iterations = 1;
+    const int16_t max_x = INFO_WINDOW_WIDTH - 1;
+    const int16_t max_y = GRAPH_TOP_OFFSET + GRAPH_HEIGHT;
+    
+    // Networks spread over the 2.4 GHz channels with clustered RSSI, like a busy office
+    uint32_t seed = 12345;
+    for (uint16_t i = 0; i < count; i++) {
+        seed = seed * 1103515245u + 12345u;
+        int channel = 1 + (seed >> 16) % 13;
+        seed = seed * 1103515245u + 12345u;
+        int rssi = RSSI_MIN + (seed >> 16) % (RSSI_MAX - RSSI_MIN);
+        items[i].anchor_x = GRAPH_LEFT_MARGIN + (channel - CHANNEL_MIN) * GRAPH_WIDTH / (CHANNEL_MAX - CHANNEL_MIN);
+        items[i].anchor_y = GRAPH_TOP_OFFSET + GRAPH_HEIGHT - (rssi - RSSI_MIN) * GRAPH_HEIGHT / (RSSI_MAX - RSSI_MIN);
+        items[i].width = 40 + (seed >> 8) % 80;
+        items[i].height = 12;
+    }
+    
+    uint16_t placed = 0;
+    uint16_t badge_count = 0;
+    uint32_t start = micros();
+    for (uint16_t it = 0; it < iterations; it++) {
+        badge_count = layoutLabels(items, count, 0, 0, max_x, max_y, badges, LABEL_MAX_BADGES);
+    }
+    uint32_t pass_us = (micros() - start) / iterations;
+    
+    // Every placed label inside the plot and clear of every other one
+    uint16_t bad = 0;
+    uint32_t badged = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        const LabelLayoutItem *a = &items[i];
+        if (!a->placed) continue;
+        placed++;
+        if (a->x < 0 || a->y < 0 || a->x + a->width - 1 > max_x || a->y + a->height - 1 > max_y) bad++;
+        for (uint16_t j = i + 1; j < count; j++) {
+            const LabelLayoutItem *b = &items[j];
+            if (b->placed && a->x < b->x + b->width && b->x < a->x + a->width &&
+                a->y < b->y + b->height && b->y < a->y + a->height) {
+                bad++;
+            }
+        }
+    }
+    for (uint16_t b = 0; b < badge_count; b++) badged += badges[b].count;
+    
+    bool ok = pass_us <= LABEL_LAYOUT_BUDGET_US && bad == 0 && placed > 0 && placed + badged <= count;
+    printf("Label layout: %u labels, %u placed, %u badges (%lu labels), %lu us/pass (budget %d), %u overlaps: %s\r\n",
+           count, placed, badge_count, (unsigned long)badged, (unsigned long)pass_us, LABEL_LAYOUT_BUDGET_US, bad,
+           ok ? "ok" : "FAIL");
+    return ok;
+}
@@ -0,0 +1,34 @@
+/*
+ * SSID label placement with collision avoidance
+ */
+
+#ifndef LABEL_LAYOUT_H
+#define LABEL_LAYOUT_H
+
+#include <stdint.h>
+
+// One label to place, in priority order (strongest network first)
+struct LabelLayoutItem {
+    int16_t anchor_x;   // Preferred horizontal centre
+    int16_t anchor_y;   // Preferred bottom edge (top of the network's oval)
+    int16_t width;      // Measured text size
+    int16_t height;
+    int16_t x;          // Placed top-left (valid if placed)
+    int16_t y;
+    bool placed;
+};
+
+// Collapsed labels that could not be placed near one spot
+struct LabelBadge {
+    int16_t x;          // Top-left of the "+N" text
+    int16_t y;
+    uint16_t count;
+};
+
+// Functions
+uint16_t layoutLabels(LabelLayoutItem *items, uint16_t count,
+                      int16_t min_x, int16_t min_y, int16_t max_x, int16_t max_y,
+                      LabelBadge *badges, uint16_t max_badges);
+bool labelLayoutBenchmark(uint16_t count, uint16_t iterations);
+
+#endif // LABEL_LAYOUT_H
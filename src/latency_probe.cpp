@@ -0,0 +1,204 @@
+/*
+ * Latency probe implementation
+ *
+ * While enabled, every touch press and release starts a probe. Its input time
+ * is the first GT911 interrupt of the press or release, or the I2C read when
+ * the controller is polled, so the debounce reads are included. The LVGL port
+ * then reports:
+ * - the read that delivered the change to LVGL
+ * - the indev feedback callback for the matching event (pressed for a press,
+ *   the last of released/short clicked/clicked for a release), which LVGL
+ *   calls just before the object's handlers
+ * - the invalidations that follow
+ * - the flushed strips of the next refresh
+ * The photon time is when the last strip overlapping the invalidated area has
+ * been copied to the panel. Invalidation can come before the dispatch: LVGL
+ * adds the pressed state and redraws it before sending the event.
+ *
+ * One probe is in flight at a time; the next touch ends an unfinished one
+ * (counted as "no redraw" when nothing was invalidated). The stages are
+ * recorded by the LVGL task and the flush task without a lock. A rare race
+ * between a new touch and the end of the previous refresh can lose a sample
+ * but cannot corrupt one. Percentiles are over the last
+ * LATENCY_PROBE_SAMPLES probes of each kind.
+ */
+
+#include "latency_probe.h"
+#include "config.h"
+#include <Arduino.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if LATENCY_PROBE
+enum ProbeKind { PROBE_PRESS, PROBE_RELEASE, PROBE_KINDS };
+
+enum ProbeStage {
+    STAGE_IDLE,
+    STAGE_INPUT,        // Waiting for the first invalidation
+    STAGE_RENDER,       // Invalidated; more invalidations join the area until its refresh is flushed
+    STAGE_FLUSH         // Strips of that refresh are being flushed
+};
+
+// Offsets from the input time, in us
+struct LatencySample {
+    uint32_t stages[4];     // read, dispatch, invalidate, photon
+};
+
+struct LatencyRing {
+    LatencySample samples[LATENCY_PROBE_SAMPLES];
+    uint32_t count;         // Samples recorded (the ring keeps the last LATENCY_PROBE_SAMPLES)
+    uint32_t no_redraw;     // Touches that invalidated nothing
+    uint32_t timeouts;      // Touches whose redraw did not reach the panel within LATENCY_PROBE_TIMEOUT_MS
+};
+
+static const char *kind_names[PROBE_KINDS] = {"press", "release"};
+static const char *stage_names[4] = {"read", "dispatch", "invalidate", "photon"};
+
+static volatile bool probe_enabled = false;
+static volatile ProbeStage stage = STAGE_IDLE;
+static ProbeKind kind = PROBE_PRESS;
+static uint32_t t_input = 0;
+static uint32_t t_read = 0;
+static uint32_t t_dispatch = 0;
+static uint32_t t_invalidate = 0;
+static uint32_t t_flush = 0;
+static lv_area_t inv_area;
+static LatencyRing rings[PROBE_KINDS];
+
+// Drop an unfinished probe, counting why
+static void abandonProbe() {
+    if (stage == STAGE_INPUT) {
+        rings[kind].no_redraw++;
+    } else if (stage != STAGE_IDLE) {
+        rings[kind].timeouts++;
+    }
+    stage = STAGE_IDLE;
+}
+
+static void recordSample() {
+    LatencyRing *ring = &rings[kind];
+    LatencySample *sample = &ring->samples[ring->count % LATENCY_PROBE_SAMPLES];
+    sample->stages[0] = t_read - t_input;
+    sample->stages[1] = t_dispatch ? t_dispatch - t_input : 0;
+    sample->stages[2] = t_invalidate - t_input;
+    sample->stages[3] = t_flush - t_input;
+    ring->count++;
+}
+
+static int compareU32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+#endif
+
+// Start or stop measuring (starting clears earlier samples)
+void latencyProbeEnable(bool enabled) {
+#if LATENCY_PROBE
+    if (enabled && !probe_enabled) latencyProbeReset();
+    probe_enabled = enabled;
+#endif
+}
+
+bool latencyProbeEnabled() {
+#if LATENCY_PROBE
+    return probe_enabled;
+#else
+    return false;
+#endif
+}
+
+// LVGL task, touch read: the finger went down or up (input_us = first interrupt, or the read when polling)
+void latencyProbeInput(bool pressed, uint32_t input_us) {
+#if LATENCY_PROBE
+    if (!probe_enabled) return;
+    abandonProbe();
+    kind = pressed ? PROBE_PRESS : PROBE_RELEASE;
+    t_input = input_us;
+    t_read = micros();
+    t_dispatch = 0;
+    t_flush = 0;
+    stage = STAGE_INPUT;
+#endif
+}
+
+// LVGL task, indev feedback: LVGL has sent event_code to the touched object
+void latencyProbeDispatch(uint8_t event_code) {
+#if LATENCY_PROBE
+    if (!probe_enabled || stage == STAGE_IDLE) return;
+    bool match = (kind == PROBE_PRESS) ? event_code == LV_EVENT_PRESSED
+                                       : (event_code == LV_EVENT_RELEASED || event_code == LV_EVENT_SHORT_CLICKED ||
+                                          event_code == LV_EVENT_CLICKED);
+    // A release sends several events; keep the last, whose handler does the work
+    if (match) t_dispatch = micros();
+#endif
+}
+
+// LVGL task, invalidation hook: area will be redrawn
+void latencyProbeInvalidate(const lv_area_t *area) {
+#if LATENCY_PROBE
+    if (!probe_enabled) return;
+    if (stage == STAGE_INPUT) {
+        inv_area = *area;
+        t_invalidate = micros();
+        stage = STAGE_RENDER;
+    } else if (stage == STAGE_RENDER) {
+        _lv_area_join(&inv_area, &inv_area, area);
+    }
+#endif
+}
+
+// Flush task: area has been copied to the panel (last = final strip of the refresh)
+void latencyProbeFlushed(const lv_area_t *area, bool last) {
+#if LATENCY_PROBE
+    if (!probe_enabled || (stage != STAGE_RENDER && stage != STAGE_FLUSH)) return;
+    uint32_t now = micros();
+    stage = STAGE_FLUSH;
+    if (_lv_area_is_on(area, &inv_area)) t_flush = now;
+    if (!last) return;
+    
+    if (t_flush != 0) {
+        recordSample();
+        stage = STAGE_IDLE;
+    } else if (now - t_input > LATENCY_PROBE_TIMEOUT_MS * 1000UL) {
+        abandonProbe();
+    } else {
+        stage = STAGE_RENDER;   // That refresh did not include the area yet; wait for the next one
+    }
+#endif
+}
+
+void latencyProbeReset() {
+#if LATENCY_PROBE
+    stage = STAGE_IDLE;
+    memset(rings, 0, sizeof(rings));
+#endif
+}
+
+// Percentiles of each stage per kind of touch
+void latencyProbeDump() {
+#if LATENCY_PROBE
+    printf("---- Touch latency (us after the touch interrupt) %s ----\r\n", probe_enabled ? "" : "[off, 'latency on']");
+    for (int k = 0; k < PROBE_KINDS; k++) {
+        const LatencyRing *ring = &rings[k];
+        uint32_t n = ring->count < LATENCY_PROBE_SAMPLES ? ring->count : LATENCY_PROBE_SAMPLES;
+        printf("  %s: %lu samples, %lu without redraw, %lu timed out\r\n", kind_names[k], (unsigned long)ring->count,
+               (unsigned long)ring->no_redraw, (unsigned long)ring->timeouts);
+        if (n == 0) continue;
+        printf("    %-10s %8s %8s %8s %8s\r\n", "stage", "p50", "p90", "p99", "max");
+        for (int s = 0; s < 4; s++) {
+            static uint32_t values[LATENCY_PROBE_SAMPLES];
+            for (uint32_t i = 0; i < n; i++) {
+                values[i] = ring->samples[i].stages[s];
+            }
+            qsort(values, n, sizeof(values[0]), compareU32);
+            printf("    %-10s %8lu %8lu %8lu %8lu\r\n", stage_names[s], (unsigned long)values[(n - 1) * 50 / 100],
+                   (unsigned long)values[(n - 1) * 90 / 100], (unsigned long)values[(n - 1) * 99 / 100],
+                   (unsigned long)values[n - 1]);
+        }
+    }
+    printf("------------------------------------------------\r\n");
+#else
+    printf("Latency probe is disabled (LATENCY_PROBE 0)\r\n");
+#endif
+}
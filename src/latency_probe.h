@@ -0,0 +1,21 @@
+/*
+ * Input-to-photon latency probe (touch interrupt to the affected area on the panel)
+ */
+
+#ifndef LATENCY_PROBE_H
+#define LATENCY_PROBE_H
+
+#include <lvgl.h>
+#include <stdint.h>
+
+// Functions (hooks are no-ops unless the probe has been enabled)
+void latencyProbeEnable(bool enabled);
+bool latencyProbeEnabled();
+void latencyProbeInput(bool pressed, uint32_t input_us);
+void latencyProbeDispatch(uint8_t event_code);
+void latencyProbeInvalidate(const lv_area_t *area);
+void latencyProbeFlushed(const lv_area_t *area, bool last);
+void latencyProbeReset();
+void latencyProbeDump();
+
+#endif // LATENCY_PROBE_H
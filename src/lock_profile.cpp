@@ -0,0 +1,140 @@
+/*
+ * LVGL lock profiler implementation
+ *
+ * Every lvgl_port_lock() call site passes a tag (its function name), and the
+ * outermost acquisition records how long the caller waited for the mutex and,
+ * on release, how long it was held. Recording happens while the caller holds
+ * the LVGL mutex, so the per-site counters and log2 histograms need no lock
+ * or atomics of their own: the mutex being profiled already serializes every
+ * writer. The dump reads the counters without locking (a value may be one
+ * update behind) and a reset is only requested, then carried out by the next
+ * lock holder. The cost per acquisition is two micros() reads and a short scan
+ * of the site table, small enough to leave enabled in production builds.
+ */
+
+#include "lock_profile.h"
+#include "config.h"
+#include <Arduino.h>
+#include <string.h>
+
+#if LOCK_PROFILE
+#define LOCK_PROFILE_BUCKETS 16     // Bucket b counts times in [2^b, 2^(b+1)) us, the last one everything above
+
+struct LockProfileSite {
+    const char *tag;
+    uint32_t count;
+    uint64_t wait_total_us;
+    uint64_t hold_total_us;
+    uint32_t wait_max_us;
+    uint32_t hold_max_us;
+    uint32_t wait_hist[LOCK_PROFILE_BUCKETS];
+    uint32_t hold_hist[LOCK_PROFILE_BUCKETS];
+};
+
+static LockProfileSite sites[LOCK_PROFILE_MAX_SITES];   // The last entry collects sites that did not fit
+static uint8_t site_count = 0;
+static LockProfileSite *holder_site = NULL;              // Site of the current outermost holder
+static volatile bool reset_requested = false;
+
+static inline uint8_t bucketOf(uint32_t us) {
+    uint8_t b = (us > 1) ? (uint8_t)(31 - __builtin_clz(us)) : 0;
+    return (b < LOCK_PROFILE_BUCKETS) ? b : LOCK_PROFILE_BUCKETS - 1;
+}
+
+static LockProfileSite *findSite(const char *tag) {
+    for (uint8_t i = 0; i < site_count; i++) {
+        if (sites[i].tag == tag) return &sites[i];
+    }
+    if (site_count < LOCK_PROFILE_MAX_SITES - 1) {
+        sites[site_count].tag = tag;
+        return &sites[site_count++];
+    }
+    sites[LOCK_PROFILE_MAX_SITES - 1].tag = "(other)";
+    return &sites[LOCK_PROFILE_MAX_SITES - 1];
+}
+
+static void printHistogram(const char *name, const uint32_t *hist) {
+    printf("      %s", name);
+    for (uint8_t b = 0; b < LOCK_PROFILE_BUCKETS; b++) {
+        if (hist[b] == 0) continue;
+        if (b == LOCK_PROFILE_BUCKETS - 1) {
+            printf(" >=%lu:%lu", (unsigned long)(1UL << b), (unsigned long)hist[b]);
+        } else {
+            printf(" <%lu:%lu", (unsigned long)(2UL << b), (unsigned long)hist[b]);
+        }
+    }
+    printf("\r\n");
+}
+#endif
+
+// The caller got the mutex after waiting wait_us (outermost acquisition only)
+void lockProfileAcquired(const char *tag, uint32_t wait_us) {
+#if LOCK_PROFILE
+    if (reset_requested) {
+        memset(sites, 0, sizeof(sites));
+        site_count = 0;
+        reset_requested = false;
+    }
+    LockProfileSite *site = findSite(tag ? tag : "(untagged)");
+    site->count++;
+    site->wait_total_us += wait_us;
+    if (wait_us > site->wait_max_us) site->wait_max_us = wait_us;
+    site->wait_hist[bucketOf(wait_us)]++;
+    holder_site = site;
+#endif
+}
+
+// The outermost holder is about to give the mutex back after hold_us
+void lockProfileReleased(uint32_t hold_us) {
+#if LOCK_PROFILE
+    LockProfileSite *site = holder_site;
+    if (site == NULL) return;
+    holder_site = NULL;
+    site->hold_total_us += hold_us;
+    if (hold_us > site->hold_max_us) site->hold_max_us = hold_us;
+    site->hold_hist[bucketOf(hold_us)]++;
+#endif
+}
+
+// Clear the counters (done by the next lock holder)
+void lockProfileReset() {
+#if LOCK_PROFILE
+    reset_requested = true;
+#endif
+}
+
+// Print wait and hold statistics per call site, longest maximum hold first
+void lockProfileDump() {
+#if LOCK_PROFILE
+    static LockProfileSite copy[LOCK_PROFILE_MAX_SITES];
+    uint8_t count = site_count;
+    memcpy(copy, sites, sizeof(copy));
+    if (sites[LOCK_PROFILE_MAX_SITES - 1].count > 0) count = LOCK_PROFILE_MAX_SITES;
+    
+    // Few sites: a simple insertion sort is enough
+    for (uint8_t i = 1; i < count; i++) {
+        LockProfileSite site = copy[i];
+        int j = i - 1;
+        while (j >= 0 && copy[j].hold_max_us < site.hold_max_us) {
+            copy[j + 1] = copy[j];
+            j--;
+        }
+        copy[j + 1] = site;
+    }
+    
+    printf("---- LVGL lock profile (us) ----\r\n");
+    printf("  %-24s %8s %9s %8s %9s %8s\r\n", "site", "count", "wait avg", "max", "hold avg", "max");
+    for (uint8_t i = 0; i < count; i++) {
+        const LockProfileSite *site = &copy[i];
+        if (site->count == 0) continue;
+        printf("  %-24s %8lu %9lu %8lu %9lu %8lu\r\n", site->tag, (unsigned long)site->count,
+               (unsigned long)(site->wait_total_us / site->count), (unsigned long)site->wait_max_us,
+               (unsigned long)(site->hold_total_us / site->count), (unsigned long)site->hold_max_us);
+        printHistogram("wait", site->wait_hist);
+        printHistogram("hold", site->hold_hist);
+    }
+    printf("--------------------------------\r\n");
+#else
+    printf("Lock profiling is disabled (LOCK_PROFILE 0)\r\n");
+#endif
+}
@@ -0,0 +1,16 @@
+/*
+ * LVGL lock profiler (wait and hold time per lvgl_port_lock() call site)
+ */
+
+#ifndef LOCK_PROFILE_H
+#define LOCK_PROFILE_H
+
+#include <stdint.h>
+
+// Functions (Acquired/Released are called by the lock holder, outermost level only)
+void lockProfileAcquired(const char *tag, uint32_t wait_us);
+void lockProfileReleased(uint32_t hold_us);
+void lockProfileReset();
+void lockProfileDump();
+
+#endif // LOCK_PROFILE_H
@@ -0,0 +1,593 @@
+/*
+ * LVGL heap implementation
+ *
+ * LVGL allocates through lv_conf.h's LV_MEM_CUSTOM hooks, which used to be
+ * plain malloc/free: styles, objects, label text and the occasional large
+ * render buffer all shared one heap, and small long-lived objects stranded
+ * between short-lived big ones fragment it over days of uptime. Here requests
+ * up to the largest size class are served from slabs: LVGL_HEAP_SLAB_SIZE
+ * blocks of internal SRAM, aligned to their size so a block's slab is found
+ * by masking its address, each cut into equal blocks of one class. A new
+ * block is taken from the fullest slab of its class so nearly-empty slabs can
+ * drain, and a slab that empties is returned to the system unless it is its
+ * class's only spare. Spares still count against LVGL_HEAP_SRAM_BUDGET, so
+ * once it is used up a class that needs a slab takes another class's spare
+ * before giving up. Larger requests (and small ones once the slabs holding
+ * live blocks fill the budget) go to PSRAM with a small size header.
+ *
+ * There is no lock: LVGL is only ever called with the LVGL mutex held, which
+ * serializes every allocation. The statistics are plain counters read
+ * without locking by the "heap" console command.
+ *
+ * On the host (LVGL_HEAP_TRACE), the harness records the allocation sequence
+ * of its scan and render passes and replays it for a simulated week through
+ * this heap and through plain malloc, to compare how much memory each holds
+ * over time. The run fails if this heap fails an allocation or holds more
+ * than LVGL_HEAP_SOAK_MAX_GROWTH_KB more at the end than after the first day.
+ */
+
+#include "lvgl_heap.h"
+#include "config.h"
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SLAB_HEADER_SIZE    32      // Keeps blocks 16-byte aligned
+#define LARGE_HEADER_SIZE   16
+#define MAX_SLABS           (LVGL_HEAP_SRAM_BUDGET / LVGL_HEAP_SLAB_SIZE)
+#define LARGE_CAPS          (LVGL_HEAP_LARGE_IN_PSRAM ? MALLOC_CAP_SPIRAM : (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT))
+
+static const uint16_t class_sizes[] = {16, 32, 48, 64, 96, 128, 192, 256};
+#define CLASS_COUNT         (sizeof(class_sizes) / sizeof(class_sizes[0]))
+
+struct Slab {
+    Slab *next;             // Next slab of the same class
+    void *free_list;        // Free blocks, each holding the next one's address
+    uint16_t used;
+    uint16_t capacity;
+    uint8_t size_class;
+};
+
+struct SizeClass {
+    Slab *slabs;
+    uint16_t slab_count;
+    uint16_t empty_slabs;   // Slabs with no block in use (at most one is kept)
+    uint32_t in_use;
+    uint32_t peak_in_use;
+    uint32_t allocs;
+    uint32_t overflows;     // Allocations sent to the large path because the budget was used up
+    uint64_t requested;     // Bytes asked for by those allocations (internal waste = blocks - requested)
+};
+
+struct LargeHeader {
+    uint32_t size;          // Requested size
+    uint32_t in_sram;       // Fell back to internal SRAM
+};
+
+static SizeClass classes[CLASS_COUNT];
+static Slab *slab_table[MAX_SLABS > 0 ? MAX_SLABS : 1];    // Every live slab, to tell slab blocks from large ones
+static uint16_t slab_total = 0;
+static uint16_t slab_peak = 0;
+
+static uint32_t large_count = 0;
+static uint32_t large_bytes = 0;
+static uint32_t large_peak_bytes = 0;
+static uint32_t large_sram_fallbacks = 0;
+static uint32_t alloc_failures = 0;
+
+static void releaseSlab(Slab *slab);
+static void traceAlloc(void *ptr, size_t size);
+static void traceFree(void *ptr);
+static void traceRealloc(void *old_ptr, void *new_ptr, size_t size);
+
+static inline int classOf(size_t size) {
+    for (uint8_t c = 0; c < CLASS_COUNT; c++) {
+        if (size <= class_sizes[c]) return c;
+    }
+    return -1;
+}
+
+static Slab *slabOf(void *ptr) {
+    Slab *base = (Slab *)((uintptr_t)ptr & ~(uintptr_t)(LVGL_HEAP_SLAB_SIZE - 1));
+    for (uint16_t i = 0; i < slab_total; i++) {
+        if (slab_table[i] == base) return base;
+    }
+    return NULL;
+}
+
+// Budget used up: free another class's spare empty slab to make room
+static bool reclaimSpare(void) {
+    for (uint8_t c = 0; c < CLASS_COUNT; c++) {
+        if (classes[c].empty_slabs == 0) continue;
+        for (Slab *slab = classes[c].slabs; slab != NULL; slab = slab->next) {
+            if (slab->used == 0) {
+                classes[c].empty_slabs--;
+                releaseSlab(slab);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static Slab *newSlab(uint8_t c) {
+    if (slab_total >= MAX_SLABS && !reclaimSpare()) return NULL;
+    Slab *slab = (Slab *)heap_caps_aligned_alloc(LVGL_HEAP_SLAB_SIZE, LVGL_HEAP_SLAB_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (slab == NULL) return NULL;
+    
+    uint16_t size = class_sizes[c];
+    slab->capacity = (LVGL_HEAP_SLAB_SIZE - SLAB_HEADER_SIZE) / size;
+    slab->used = 0;
+    slab->size_class = c;
+    slab->free_list = NULL;
+    uint8_t *blocks = (uint8_t *)slab + SLAB_HEADER_SIZE;
+    for (int i = slab->capacity - 1; i >= 0; i--) {
+        void *block = blocks + i * size;
+        *(void **)block = slab->free_list;
+        slab->free_list = block;
+    }
+    
+    slab->next = classes[c].slabs;
+    classes[c].slabs = slab;
+    classes[c].slab_count++;
+    classes[c].empty_slabs++;
+    slab_table[slab_total++] = slab;
+    if (slab_total > slab_peak) slab_peak = slab_total;
+    return slab;
+}
+
+static void releaseSlab(Slab *slab) {
+    SizeClass *cls = &classes[slab->size_class];
+    for (Slab **link = &cls->slabs; *link != NULL; link = &(*link)->next) {
+        if (*link == slab) {
+            *link = slab->next;
+            break;
+        }
+    }
+    cls->slab_count--;
+    for (uint16_t i = 0; i < slab_total; i++) {
+        if (slab_table[i] == slab) {
+            slab_table[i] = slab_table[--slab_total];
+            break;
+        }
+    }
+    heap_caps_free(slab);
+}
+
+// Block from the fullest slab of the class with room, or a new slab
+static void *slabAlloc(uint8_t c) {
+    SizeClass *cls = &classes[c];
+    Slab *best = NULL;
+    for (Slab *slab = cls->slabs; slab != NULL; slab = slab->next) {
+        if (slab->free_list != NULL && (best == NULL || slab->used > best->used)) best = slab;
+    }
+    if (best == NULL) best = newSlab(c);
+    if (best == NULL) return NULL;
+    
+    void *block = best->free_list;
+    best->free_list = *(void **)block;
+    if (best->used++ == 0) cls->empty_slabs--;
+    if (++cls->in_use > cls->peak_in_use) cls->peak_in_use = cls->in_use;
+    return block;
+}
+
+static void slabFree(Slab *slab, void *ptr) {
+    SizeClass *cls = &classes[slab->size_class];
+    *(void **)ptr = slab->free_list;
+    slab->free_list = ptr;
+    cls->in_use--;
+    if (--slab->used > 0) return;
+    // Keep one empty slab per class so a block freed and reallocated does not cycle a slab
+    if (cls->empty_slabs > 0) {
+        releaseSlab(slab);
+    } else {
+        cls->empty_slabs++;
+    }
+}
+
+static void *largeAlloc(size_t size) {
+    LargeHeader *header = (LargeHeader *)heap_caps_malloc(size + LARGE_HEADER_SIZE, LARGE_CAPS);
+    bool in_sram = false;
+    if (header == NULL && LVGL_HEAP_LARGE_IN_PSRAM) {
+        header = (LargeHeader *)heap_caps_malloc(size + LARGE_HEADER_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        in_sram = true;
+    }
+    if (header == NULL) return NULL;
+    header->size = size;
+    header->in_sram = in_sram;
+    if (in_sram) large_sram_fallbacks++;
+    large_count++;
+    large_bytes += size;
+    if (large_bytes > large_peak_bytes) large_peak_bytes = large_bytes;
+    return (uint8_t *)header + LARGE_HEADER_SIZE;
+}
+
+static void largeFree(void *ptr) {
+    LargeHeader *header = (LargeHeader *)((uint8_t *)ptr - LARGE_HEADER_SIZE);
+    large_count--;
+    large_bytes -= header->size;
+    heap_caps_free(header);
+}
+
+static void *heapAlloc(size_t size) {
+    int c = LVGL_HEAP_SLABS ? classOf(size) : -1;
+    void *ptr = NULL;
+    if (c >= 0) {
+        classes[c].allocs++;
+        classes[c].requested += size;
+        ptr = slabAlloc(c);
+        if (ptr == NULL) classes[c].overflows++;
+    }
+    if (ptr == NULL) ptr = largeAlloc(size);
+    if (ptr == NULL) alloc_failures++;
+    return ptr;
+}
+
+static void heapFree(void *ptr) {
+    Slab *slab = slabOf(ptr);
+    if (slab != NULL) {
+        slabFree(slab, ptr);
+    } else {
+        largeFree(ptr);
+    }
+}
+
+void *lvgl_heap_alloc(size_t size) {
+    void *ptr = heapAlloc(size);
+    traceAlloc(ptr, size);
+    return ptr;
+}
+
+void lvgl_heap_free(void *ptr) {
+    if (ptr == NULL) return;
+    traceFree(ptr);
+    heapFree(ptr);
+}
+
+// Stays in place while the new size fits the same class (or shrinks a large block); otherwise moves
+void *lvgl_heap_realloc(void *ptr, size_t size) {
+    if (ptr == NULL) return lvgl_heap_alloc(size);
+    
+    Slab *slab = slabOf(ptr);
+    size_t old_size = slab ? class_sizes[slab->size_class] : ((LargeHeader *)((uint8_t *)ptr - LARGE_HEADER_SIZE))->size;
+    bool fits = slab ? classOf(size) == slab->size_class : (size <= old_size && size > old_size / 2);
+    if (fits) {
+        traceRealloc(ptr, ptr, size);
+        return ptr;
+    }
+    
+    void *moved = heapAlloc(size);
+    if (moved == NULL) return NULL;
+    memcpy(moved, ptr, old_size < size ? old_size : size);
+    heapFree(ptr);
+    traceRealloc(ptr, moved, size);
+    return moved;
+}
+
+// Bytes handed to LVGL and not yet freed (slab blocks at their class size, large blocks as requested)
+size_t lvgl_heap_in_use(void) {
+    size_t bytes = large_bytes;
+    for (uint8_t c = 0; c < CLASS_COUNT; c++) {
+        bytes += (size_t)classes[c].in_use * class_sizes[c];
+    }
+    return bytes;
+}
+
+// Per-class use and waste, large blocks, and how fragmented the system heaps are
+void lvgl_heap_dump(void) {
+    printf("---- LVGL heap ----\r\n");
+    printf("  %6s %6s %7s %7s %6s %9s %9s %6s\r\n", "class", "slabs", "in use", "peak", "util%", "allocs", "overflow", "waste%");
+    uint32_t slab_used_bytes = 0;
+    for (uint8_t c = 0; c < CLASS_COUNT; c++) {
+        const SizeClass *cls = &classes[c];
+        if (cls->allocs == 0) continue;
+        uint32_t capacity = (uint32_t)cls->slab_count * ((LVGL_HEAP_SLAB_SIZE - SLAB_HEADER_SIZE) / class_sizes[c]);
+        uint64_t served = (uint64_t)(cls->allocs - cls->overflows) * class_sizes[c];
+        uint64_t requested = cls->allocs ? cls->requested * (cls->allocs - cls->overflows) / cls->allocs : 0;
+        slab_used_bytes += cls->in_use * class_sizes[c];
+        printf("  %6u %6u %7lu %7lu %5lu%% %9lu %9lu %5lu%%\r\n", class_sizes[c], cls->slab_count,
+               (unsigned long)cls->in_use, (unsigned long)cls->peak_in_use,
+               (unsigned long)(capacity ? cls->in_use * 100 / capacity : 0), (unsigned long)cls->allocs,
+               (unsigned long)cls->overflows, (unsigned long)(served ? (served - requested) * 100 / served : 0));
+    }
+    uint32_t slab_bytes = (uint32_t)slab_total * LVGL_HEAP_SLAB_SIZE;
+    printf("  slabs: %u of %u (peak %u), %lu of %lu bytes in use\r\n", slab_total, (unsigned)MAX_SLABS, slab_peak,
+           (unsigned long)slab_used_bytes, (unsigned long)slab_bytes);
+    printf("  large: %lu blocks, %lu bytes (peak %lu), %lu fell back to SRAM, %lu failed allocations\r\n",
+           (unsigned long)large_count, (unsigned long)large_bytes, (unsigned long)large_peak_bytes,
+           (unsigned long)large_sram_fallbacks, (unsigned long)alloc_failures);
+    
+    // External fragmentation: share of free memory not usable as one block
+    static const struct { const char *name; uint32_t caps; } heaps[] = {
+        {"SRAM", MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT},
+        {"PSRAM", MALLOC_CAP_SPIRAM},
+    };
+    for (size_t h = 0; h < sizeof(heaps) / sizeof(heaps[0]); h++) {
+        size_t free_bytes = heap_caps_get_free_size(heaps[h].caps);
+        size_t largest = heap_caps_get_largest_free_block(heaps[h].caps);
+        printf("  %-5s free %lu KB, largest block %lu KB, fragmentation %lu%%\r\n", heaps[h].name,
+               (unsigned long)(free_bytes / 1024), (unsigned long)(largest / 1024),
+               (unsigned long)(free_bytes ? 100 - (uint64_t)largest * 100 / free_bytes : 0));
+    }
+    printf("-------------------\r\n");
+}
+
+#if LVGL_HEAP_TRACE
+#include <malloc.h>
+
+// Allocation trace recording (host soak test): pointers are replaced by ids so the trace can be replayed
+enum TraceOp : uint8_t { TRACE_ALLOC, TRACE_FREE, TRACE_REALLOC, TRACE_MARK };
+
+struct TraceEvent {
+    uint32_t id;
+    uint32_t size;
+    TraceOp op;
+};
+
+struct TraceSlot {
+    void *ptr;              // NULL = empty, TRACE_TOMBSTONE = deleted
+    uint32_t id;
+};
+
+#define TRACE_MAP_SIZE      (1u << 18)  // Live pointers tracked while recording (power of two)
+#define TRACE_TOMBSTONE     ((void *)1)
+
+static TraceEvent *trace_events = NULL;
+static uint32_t trace_capacity = 0;
+static uint32_t trace_count = 0;
+static uint32_t trace_ids = 0;
+static bool trace_recording = false;
+static TraceSlot *trace_map = NULL;
+
+static inline uint32_t traceHash(void *ptr) {
+    return (uint32_t)(((uintptr_t)ptr >> 4) * 2654435761u) & (TRACE_MAP_SIZE - 1);
+}
+
+static TraceSlot *traceFind(void *ptr) {
+    for (uint32_t i = traceHash(ptr), n = 0; n < TRACE_MAP_SIZE; i = (i + 1) & (TRACE_MAP_SIZE - 1), n++) {
+        if (trace_map[i].ptr == ptr) return &trace_map[i];
+        if (trace_map[i].ptr == NULL) return NULL;
+    }
+    return NULL;
+}
+
+static void traceInsert(void *ptr, uint32_t id) {
+    for (uint32_t i = traceHash(ptr), n = 0; n < TRACE_MAP_SIZE; i = (i + 1) & (TRACE_MAP_SIZE - 1), n++) {
+        if (trace_map[i].ptr == NULL || trace_map[i].ptr == TRACE_TOMBSTONE) {
+            trace_map[i].ptr = ptr;
+            trace_map[i].id = id;
+            return;
+        }
+    }
+}
+
+static void traceRecord(TraceOp op, uint32_t id, uint32_t size) {
+    if (trace_count >= trace_capacity) {
+        trace_recording = false;    // Full: stop rather than record a truncated sequence silently
+        printf("LVGL heap trace full after %lu events\r\n", (unsigned long)trace_count);
+        return;
+    }
+    trace_events[trace_count].op = op;
+    trace_events[trace_count].id = id;
+    trace_events[trace_count].size = size;
+    trace_count++;
+}
+
+static void traceAlloc(void *ptr, size_t size) {
+    if (!trace_recording || ptr == NULL) return;
+    traceInsert(ptr, trace_ids);
+    traceRecord(TRACE_ALLOC, trace_ids++, size);
+}
+
+// Frees of blocks allocated before recording started are not part of the trace
+static void traceFree(void *ptr) {
+    if (!trace_recording) return;
+    TraceSlot *slot = traceFind(ptr);
+    if (slot == NULL) return;
+    traceRecord(TRACE_FREE, slot->id, 0);
+    slot->ptr = TRACE_TOMBSTONE;
+}
+
+static void traceRealloc(void *old_ptr, void *new_ptr, size_t size) {
+    if (!trace_recording) return;
+    TraceSlot *slot = traceFind(old_ptr);
+    if (slot == NULL) {
+        traceAlloc(new_ptr, size);
+        return;
+    }
+    uint32_t id = slot->id;
+    traceRecord(TRACE_REALLOC, id, size);
+    if (new_ptr != old_ptr) {
+        slot->ptr = TRACE_TOMBSTONE;
+        traceInsert(new_ptr, id);
+    }
+}
+
+// Start recording LVGL's allocations (replaces any earlier trace)
+void lvgl_heap_trace_start(uint32_t max_events) {
+    free(trace_events);
+    free(trace_map);
+    trace_events = (TraceEvent *)malloc(max_events * sizeof(TraceEvent));
+    trace_map = (TraceSlot *)calloc(TRACE_MAP_SIZE, sizeof(TraceSlot));
+    trace_capacity = (trace_events && trace_map) ? max_events : 0;
+    trace_count = 0;
+    trace_ids = 0;
+    trace_recording = trace_capacity > 0;
+}
+
+// Start of the next sweep in the trace (the replay cycles through sweeps)
+void lvgl_heap_trace_mark(void) {
+    if (trace_recording) traceRecord(TRACE_MARK, 0, 0);
+}
+
+void lvgl_heap_trace_stop(void) {
+    trace_recording = false;
+    free(trace_map);
+    trace_map = NULL;
+}
+
+// Bytes the heap holds from the system: slabs plus large blocks with their headers
+static size_t heapHeld(void) {
+    return (size_t)slab_total * LVGL_HEAP_SLAB_SIZE + large_bytes + large_count * LARGE_HEADER_SIZE;
+}
+
+static uint32_t heapOverflows(void) {
+    uint32_t overflows = 0;
+    for (uint8_t c = 0; c < CLASS_COUNT; c++) {
+        overflows += classes[c].overflows;
+    }
+    return overflows;
+}
+
+// Bytes glibc holds from the system, free chunks included (the malloc baseline)
+static size_t mallocHeld(void) {
+    struct mallinfo2 info = mallinfo2();
+    return info.arena + info.hblkhd;
+}
+    
+static void *mallocRealloc(void *ptr, size_t size) {
+    return realloc(ptr, size);
+}
+    
+// One allocator the trace is replayed through
+struct SoakAllocator {
+    const char *name;
+    void *(*alloc)(size_t size);
+    void *(*realloc)(void *ptr, size_t size);
+    void (*free)(void *ptr);
+    size_t (*held)(void);
+    bool slabs;             // Report slab and overflow counts (this heap only)
+};
+
+struct SoakResult {
+    size_t first_day_held;
+    size_t last_held;
+    size_t peak_held;
+    uint32_t failures;
+};
+
+// Replay the recorded sweeps round-robin through one allocator, printing each day what it holds for what is live
+static SoakResult soakReplay(const SoakAllocator *allocator, uint32_t days, const uint32_t *sweep_start,
+                             uint32_t sweep_count, void **slots, uint32_t *sizes) {
+    SoakResult result = {0, 0, 0, 0};
+    uint32_t sweeps_per_day = 86400000UL / LVGL_HEAP_SOAK_SWEEP_MS;
+    printf("  %s\r\n", allocator->name);
+    printf("  %4s %9s %9s %9s %6s %6s %10s\r\n", "day", "live KB", "held KB", "peak KB", "held%", "slabs", "overflows");
+    
+    memset(slots, 0, trace_ids * sizeof(void *));
+    memset(sizes, 0, trace_ids * sizeof(uint32_t));
+    size_t baseline = allocator->held();
+    uint32_t overflows_before = heapOverflows();
+    uint64_t live = 0;
+    uint32_t start_us = micros();
+    for (uint32_t day = 1; day <= days; day++) {
+        for (uint32_t s = 0; s < sweeps_per_day; s++) {
+            uint32_t sweep = ((day - 1) * sweeps_per_day + s) % sweep_count;
+            for (uint32_t i = sweep_start[sweep]; i < trace_count && trace_events[i].op != TRACE_MARK; i++) {
+                const TraceEvent *ev = &trace_events[i];
+                void **slot = &slots[ev->id];
+                if (*slot != NULL) {
+                    live -= sizes[ev->id];
+                    sizes[ev->id] = 0;
+                }
+                if (ev->op == TRACE_FREE || (ev->op == TRACE_ALLOC && *slot != NULL)) {
+                    allocator->free(*slot);
+                    *slot = NULL;
+                }
+                if (ev->op == TRACE_FREE) continue;
+                
+                void *ptr = (*slot != NULL) ? allocator->realloc(*slot, ev->size) : allocator->alloc(ev->size);
+                if (ptr == NULL) {
+                    result.failures++;
+                    continue;   // A failed realloc leaves the old block; it is freed with the others at the end
+                }
+                memset(ptr, 0xA5, ev->size < 16 ? ev->size : 16);
+                *slot = ptr;
+                sizes[ev->id] = ev->size;
+                live += ev->size;
+            }
+            size_t held = allocator->held() - baseline;
+            if (held > result.peak_held) result.peak_held = held;
+        }
+        size_t held = allocator->held() - baseline;
+        if (day == 1) result.first_day_held = held;
+        printf("  %4lu %9lu %9lu %9lu %5lu%%", (unsigned long)day, (unsigned long)(live / 1024),
+               (unsigned long)(held / 1024), (unsigned long)(result.peak_held / 1024),
+               (unsigned long)(live ? held * 100 / live : 0));
+        if (allocator->slabs) {
+            printf(" %6u %10lu\r\n", slab_total, (unsigned long)(heapOverflows() - overflows_before));
+        } else {
+            printf(" %6s %10s\r\n", "-", "-");
+        }
+    }
+    result.last_held = allocator->held() - baseline;
+    printf("  held after day %lu vs day 1: %+ld KB, %lu failed allocations, %lu ms\r\n", (unsigned long)days,
+           ((long)result.last_held - (long)result.first_day_held) / 1024, (unsigned long)result.failures,
+           (unsigned long)((micros() - start_us) / 1000));
+    
+    for (uint32_t id = 0; id < trace_ids; id++) {
+        if (slots[id] != NULL) allocator->free(slots[id]);
+    }
+    return result;
+}
+
+// Replay the recorded trace for the given number of days at one sweep per LVGL_HEAP_SOAK_SWEEP_MS, first
+// through plain malloc as the baseline and then through this heap. A block the trace never frees is freed
+// when its sweep comes round again, so it lives one round. Fails if this heap fails an allocation or what
+// it holds creeps up by more than LVGL_HEAP_SOAK_MAX_GROWTH_KB between the first and the last day.
+bool lvgl_heap_soak(uint32_t days) {
+    if (trace_events == NULL || trace_count == 0) {
+        printf("LVGL heap soak: no trace recorded\r\n");
+        return false;
+    }
+    void **slots = (void **)calloc(trace_ids, sizeof(void *));
+    uint32_t *sizes = (uint32_t *)calloc(trace_ids, sizeof(uint32_t));
+    if (slots == NULL || sizes == NULL) {
+        free(slots);
+        free(sizes);
+        return false;
+    }
+    
+    // Sweep boundaries in the trace
+    static uint32_t sweep_start[256];
+    uint32_t sweep_count = 0;
+    for (uint32_t i = 0; i < trace_count && sweep_count < 256; i++) {
+        if (trace_events[i].op == TRACE_MARK) sweep_start[sweep_count++] = i + 1;
+    }
+    if (sweep_count == 0) sweep_start[sweep_count++] = 0;
+    
+    printf("LVGL heap soak: %lu events over %lu recorded sweeps, %lu sweeps per day for %lu days\r\n",
+           (unsigned long)trace_count, (unsigned long)sweep_count,
+           (unsigned long)(86400000UL / LVGL_HEAP_SOAK_SWEEP_MS), (unsigned long)days);
+    static const SoakAllocator system_malloc = {"malloc (baseline)", malloc, mallocRealloc, free, mallocHeld, false};
+    static const SoakAllocator lvgl_heap = {"LVGL heap", heapAlloc, lvgl_heap_realloc, heapFree, heapHeld, true};
+    SoakResult baseline = soakReplay(&system_malloc, days, sweep_start, sweep_count, slots, sizes);
+    SoakResult result = soakReplay(&lvgl_heap, days, sweep_start, sweep_count, slots, sizes);
+    free(slots);
+    free(sizes);
+    lvgl_heap_dump();
+    
+    long growth = (long)result.last_held - (long)result.first_day_held;
+    long baseline_growth = (long)baseline.last_held - (long)baseline.first_day_held;
+    bool ok = result.failures == 0 && growth <= (long)LVGL_HEAP_SOAK_MAX_GROWTH_KB * 1024;
+    printf("LVGL heap soak: peak held %lu KB (malloc %lu KB), growth %+ld KB (malloc %+ld KB, limit %d KB), "
+           "%lu failed allocations: %s\r\n", (unsigned long)(result.peak_held / 1024),
+           (unsigned long)(baseline.peak_held / 1024), growth / 1024, baseline_growth / 1024,
+           LVGL_HEAP_SOAK_MAX_GROWTH_KB, (unsigned long)result.failures, ok ? "PASS" : "FAIL");
+    return ok;
+}
+#else
+static void traceAlloc(void *ptr, size_t size) {}
+static void traceFree(void *ptr) {}
+static void traceRealloc(void *old_ptr, void *new_ptr, size_t size) {}
+
+void lvgl_heap_trace_start(uint32_t max_events) {}
+void lvgl_heap_trace_mark(void) {}
+void lvgl_heap_trace_stop(void) {}
+
+bool lvgl_heap_soak(uint32_t days) {
+    printf("LVGL heap soak needs LVGL_HEAP_TRACE (host harness)\r\n");
+    return false;
+}
+#endif
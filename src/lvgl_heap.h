@@ -0,0 +1,33 @@
+/*
+ * LVGL heap (LV_MEM_CUSTOM): size-class slabs in internal SRAM, large blocks in PSRAM
+ *
+ * Included by LVGL itself through LV_MEM_CUSTOM_INCLUDE in lv_conf.h, so it must stay C.
+ */
+
+#ifndef LVGL_HEAP_H
+#define LVGL_HEAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Functions
+void *lvgl_heap_alloc(size_t size);
+void lvgl_heap_free(void *ptr);
+void *lvgl_heap_realloc(void *ptr, size_t size);
+size_t lvgl_heap_in_use(void);
+void lvgl_heap_dump(void);
+void lvgl_heap_trace_start(uint32_t max_events);
+void lvgl_heap_trace_mark(void);
+void lvgl_heap_trace_stop(void);
+bool lvgl_heap_soak(uint32_t days);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LVGL_HEAP_H
@@ -1,92 +1,404 @@
 /*
  * LVGL porting layer implementation
+ *
+ * The LVGL task sleeps on its task notification rather than polling. It runs
+ * lv_timer_handler(), then blocks until the next LVGL timer deadline or until
+ * something notifies it: an invalidation made from another task (caught by
+ * the display rounder callback, which LVGL calls for every invalidated area)
+ * or a touch interrupt. LVGL already pauses its refresh timer once a frame is
+ * done, so with nothing on screen changing the task only wakes for the timers
+ * that are actually running. Scan results arrive on the UI bus; the scanner
+ * wakes the task after queueing them and they are applied before the handler.
+ *
+ * Every lock is tagged with its caller so the lock profiler can attribute
+ * wait and hold times to call sites. Render, flush and invalidated-area times
+ * and the task's awake time are reported to the performance monitor.
+ *
+ * The GT911 is read over I2C only after it pulls its INT line low. Between
+ * interrupts the indev gets the cached points, and once the finger is up the
+ * indev read timer is paused until the next interrupt, so an untouched screen
+ * causes no I2C traffic on the bus shared with the IO expander.
+ *
+ * The idle governor sets the task's shortest sleep and the backlight through
+ * this layer, and sees every touch first so it can restore full speed.
+ *
+ * The latency probe is fed from here too: the first touch interrupt of a press
+ * or release, the read that reports it, LVGL's indev feedback for each event,
+ * the rounder's invalidations and each flushed strip.
  */
 
 #include "lvgl_port.h"
 #include "config.h"
+#include "graph_gesture.h"
+#include "touch_filter.h"
+#include "ui_bus.h"
+#include "lock_profile.h"
+#include "perf_monitor.h"
+#include "boot_trace.h"
+#include "idle_governor.h"
+#include "latency_probe.h"
 #include <ESP_IOExpander_Library.h>
+#include <freertos/queue.h>
 #include <Arduino.h>
 
 // Global panel and mutex
 ESP_Panel *panel = NULL;
 SemaphoreHandle_t lvgl_mux = NULL;
 
-#if ESP_PANEL_LCD_BUS_TYPE == ESP_PANEL_BUS_TYPE_RGB
+static TaskHandle_t lvgl_task_handle = NULL;
+static volatile uint32_t lvgl_flush_count = 0;  // Strips sent to the panel
+static lvgl_wake_stats_t lvgl_wake_stats = {0, 0, 0, 0, 0};
+static int lvgl_lock_depth = 0;                 // Recursion depth of the task holding the mutex
+static uint32_t lvgl_lock_hold_start = 0;       // When the outermost lock was taken
+static uint32_t lvgl_flush_block_us = 0;        // Time the LVGL task spent waiting on the panel (subtracted from render time)
+static uint32_t lvgl_task_min_delay_ms = LVGL_TASK_MIN_DELAY_MS;  // Raised by the idle governor
+static ESP_IOExpander *lvgl_expander = NULL;    // Drives the backlight enable pin
+static SemaphoreHandle_t lvgl_flush_done = NULL; // Given each time a flush completes asynchronously
+
+/* The last strip of the first frame ends the boot timeline */
+static void lvgl_port_trace_first_frame(lv_disp_drv_t *disp)
+{
+    static bool first_frame_done = false;
+    if (first_frame_done || !lv_disp_flush_is_last(disp)) return;
+    first_frame_done = true;
+    bootTraceMark("first frame rendered");
+    bootTraceDump();
+}
+
+#if (ESP_PANEL_LCD_BUS_TYPE == ESP_PANEL_BUS_TYPE_RGB) && LVGL_BUF_DOUBLE
+/* A rendered strip waiting to be copied into the RGB frame buffer */
+typedef struct {
+    lv_disp_drv_t *disp;
+    lv_area_t area;
+    lv_color_t *color_p;
+    bool last;                  // Final strip of the refresh
+} lvgl_flush_job_t;
+
+static QueueHandle_t lvgl_flush_queue = NULL;
+
+/* Display flushing - hand the strip to the flush task so LVGL can render into the other buffer */
+void lvgl_port_disp_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p)
+{
+    lvgl_port_trace_first_frame(disp);
+    lvgl_flush_count++;
+    lvgl_flush_job_t job = {disp, *area, color_p, lv_disp_flush_is_last(disp)};
+    xQueueSend(lvgl_flush_queue, &job, portMAX_DELAY);
+}
+
+/* Copy queued strips into the frame buffer and report completion */
+static void lvgl_port_flush_task(void *arg)
+{
+    lvgl_flush_job_t job;
+    while (1) {
+        if (xQueueReceive(lvgl_flush_queue, &job, portMAX_DELAY) == pdTRUE) {
+            uint32_t start = micros();
+            panel->getLcd()->drawBitmap(job.area.x1, job.area.y1, job.area.x2 + 1, job.area.y2 + 1, job.color_p);
+            perfMonitorFlush(micros() - start, lv_area_get_size(&job.area));
+            latencyProbeFlushed(&job.area, job.last);
+            notify_lvgl_flush_ready(job.disp);
+        }
+    }
+}
+
+/* Called by LVGL while it waits for a buffer to be released - sleep until the flush task reports one done
+ * (a give left over from a strip nobody waited for only costs LVGL one more pass through this wait) */
+static void lvgl_port_flush_wait(lv_disp_drv_t *disp)
+{
+    uint32_t start = micros();
+    xSemaphoreTake(lvgl_flush_done, pdMS_TO_TICKS(LVGL_FLUSH_TIMEOUT_MS));
+    lvgl_flush_block_us += micros() - start;
+}
+#elif ESP_PANEL_LCD_BUS_TYPE == ESP_PANEL_BUS_TYPE_RGB
 /* Display flushing */
 void lvgl_port_disp_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p)
 {
+    lvgl_port_trace_first_frame(disp);
+    lvgl_flush_count++;
+    uint32_t start = micros();
     panel->getLcd()->drawBitmap(area->x1, area->y1, area->x2 + 1, area->y2 + 1, color_p);
+    uint32_t flush_us = micros() - start;
+    lvgl_flush_block_us += flush_us;
+    perfMonitorFlush(flush_us, lv_area_get_size(area));
+    latencyProbeFlushed(area, lv_disp_flush_is_last(disp));
     lv_disp_flush_ready(disp);
 }
 #else
-/* Display flushing */
+/* Display flushing - completion is reported by the bus callback */
 void lvgl_port_disp_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p)
 {
+    lvgl_port_trace_first_frame(disp);
+    lvgl_flush_count++;
+    uint32_t start = micros();
     panel->getLcd()->drawBitmap(area->x1, area->y1, area->x2 + 1, area->y2 + 1, color_p);
+    perfMonitorFlush(micros() - start, lv_area_get_size(area));  // Only the hand-off to the bus
+    latencyProbeFlushed(area, lv_disp_flush_is_last(disp));     // Queued to the bus, not yet on the glass
 }
+#endif /* ESP_PANEL_LCD_BUS_TYPE */
 
+/* Flush completion callback */
 bool notify_lvgl_flush_ready(void *user_ctx)
 {
     lv_disp_drv_t *disp_driver = (lv_disp_drv_t *)user_ctx;
     lv_disp_flush_ready(disp_driver);
+#if ESP_PANEL_LCD_BUS_TYPE != ESP_PANEL_BUS_TYPE_RGB
+    /* Called from the bus's transfer-done interrupt */
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(lvgl_flush_done, &woken);
+    return woken == pdTRUE;
+#else
+    xSemaphoreGive(lvgl_flush_done);
     return false;
+#endif
 }
-#endif /* ESP_PANEL_LCD_BUS_TYPE */
 
 #if ESP_PANEL_USE_LCD_TOUCH
-/* Read the touchpad */
+static lv_indev_drv_t *touch_indev_drv = NULL;
+static volatile bool touch_irq_pending = false;
+static volatile uint32_t touch_irq_first_us = 0;    // First interrupt since the touch state last changed (latency probe)
+static bool touch_irq_enabled = false;              // false: read the GT911 on every indev read
+static lv_point_t touch_points[TOUCH_MAX_POINTS];   // Points from the last I2C read
+static uint8_t touch_count = 0;
+static uint32_t touch_read_ms = 0;                  // When they were read
+
+/* GT911 INT falling edge - new points (or the release) are ready to read */
+static void IRAM_ATTR lvgl_port_touch_isr(esp_lcd_touch_handle_t tp)
+{
+    touch_irq_pending = true;
+    if (touch_irq_first_us == 0) touch_irq_first_us = micros();
+    lvgl_wake_stats.touch_irqs++;
+    lvgl_port_wake_from_isr();
+}
+
+#if TOUCH_FILTER_ENABLE
+/* Driver hook: debounce and smooth the points before anything reads them */
+static void lvgl_port_touch_process(esp_lcd_touch_handle_t tp, uint16_t *x, uint16_t *y, uint16_t *strength,
+                                    uint8_t *point_num, uint8_t max_point_num)
+{
+    touchFilterProcess(x, y, point_num, millis());
+}
+#endif
+
+/* An interrupt restarts the touch read timer paused while the screen was untouched */
+static void lvgl_port_touch_resume(void)
+{
+    if (!touch_irq_pending || touch_indev_drv == NULL || touch_indev_drv->read_timer == NULL) return;
+    lv_timer_resume(touch_indev_drv->read_timer);
+    lv_timer_ready(touch_indev_drv->read_timer);
+}
+
+/* Read the touchpad - every point goes to the graph gesture recognizer, the first one to LVGL */
 void lvgl_port_tp_read(lv_indev_drv_t * indev, lv_indev_data_t * data)
 {
     // Check if touch controller is available (may fail to initialize)
-    if (panel->getLcdTouch() == NULL) {
+    esp_lcd_touch_handle_t tp = (panel->getLcdTouch() != NULL) ? panel->getLcdTouch()->getHandle() : NULL;
+    if (tp == NULL) {
         data->state = LV_INDEV_STATE_REL;
         return;
     }
     
-    panel->getLcdTouch()->readData();
+    // Only go to I2C after an interrupt, or to confirm a release whose interrupt was missed
+    uint32_t read_start_us = micros();
+    bool stale = touch_count > 0 && millis() - touch_read_ms >= TOUCH_IRQ_RELEASE_MS;
+    if (!touch_irq_enabled || touch_irq_pending || stale) {
+        touch_irq_pending = false;
+        uint16_t x[TOUCH_MAX_POINTS];
+        uint16_t y[TOUCH_MAX_POINTS];
+        uint16_t strength[TOUCH_MAX_POINTS];
+        uint8_t count = 0;
+        esp_lcd_touch_read_data(tp);
+        lvgl_wake_stats.touch_reads++;
+        bool touched = esp_lcd_touch_get_coordinates(tp, x, y, strength, &count, TOUCH_MAX_POINTS);
+        if (!touched) count = 0;
+#if TOUCH_FILTER_ENABLE
+        // The filter hook never sees a read without points
+        if (count == 0) touchFilterRelease();
+#endif
+        
+        for (uint8_t i = 0; i < count; i++) {
+            touch_points[i].x = x[i];
+            touch_points[i].y = y[i];
+        }
+        touch_count = count;
+        touch_read_ms = millis();
+    }
+    
+    // A touch restores full speed at once; the one that lights a dark screen goes no further
+    static bool swallow_press = false;
+    if (touch_count > 0 && idleGovernorTouch()) swallow_press = true;
+    if (swallow_press && touch_count == 0) swallow_press = false;
+    if (swallow_press) {
+        data->state = LV_INDEV_STATE_REL;
+        return;
+    }
+    graphGestureFeed(touch_points, touch_count);
 
-    bool touched = panel->getLcdTouch()->getTouchState();
-    if(!touched) {
+    // A press or release starts a latency probe, timed from its first interrupt
+    static bool touch_was_pressed = false;
+    bool pressed = touch_count > 0;
+    if (pressed != touch_was_pressed) {
+        uint32_t first_irq_us = touch_irq_first_us;
+        latencyProbeInput(pressed, first_irq_us != 0 ? first_irq_us : read_start_us);
+        touch_was_pressed = pressed;
+        touch_irq_first_us = 0;
+    } else if (pressed || read_start_us - touch_irq_first_us > TOUCH_IRQ_RELEASE_MS * 1000UL) {
+        touch_irq_first_us = 0;     // Moves while held, or release chatter - keep only a press still being debounced
+    }
+    
+    if(touch_count == 0) {
         data->state = LV_INDEV_STATE_REL;
     } else {
-        TouchPoint point = panel->getLcdTouch()->getPoint();
-
         data->state = LV_INDEV_STATE_PR;
         /*Set the coordinates*/
-        data->point.x = point.x;
-        data->point.y = point.y;
+        data->point = touch_points[0];
     }
+    
+    // Released and nothing pending: stop reading until the next interrupt (after a scroll throw has run out)
+    if (touch_irq_enabled && touch_count == 0 && !touch_irq_pending) {
+        lv_indev_t *indev_obj = lv_indev_get_act();
+        if (indev_obj != NULL && lv_indev_get_scroll_obj(indev_obj) == NULL) {
+            lv_timer_pause(indev->read_timer);
+        }
+    }
+}
+
+/* LVGL calls this as it sends each input event to the pressed object, before its handlers */
+static void lvgl_port_tp_feedback(lv_indev_drv_t *indev, uint8_t event_code)
+{
+    latencyProbeDispatch(event_code);
 }
 #endif
 
-void lvgl_port_lock(int timeout_ms)
+/* Take the LVGL mutex (through the lvgl_port_lock() macro, which passes the caller's name as the tag) */
+void lvgl_port_lock_tagged(int timeout_ms, const char *tag)
 {
     const TickType_t timeout_ticks = (timeout_ms < 0) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+#if LOCK_PROFILE
+    uint32_t wait_start = micros();
+    if (xSemaphoreTakeRecursive(lvgl_mux, timeout_ticks) != pdTRUE) return;
+    // Only the outermost lock is profiled; nested locks are part of its hold time
+    if (lvgl_lock_depth++ == 0) {
+        lvgl_lock_hold_start = micros();
+        lockProfileAcquired(tag, lvgl_lock_hold_start - wait_start);
+    }
+#else
     xSemaphoreTakeRecursive(lvgl_mux, timeout_ticks);
+#endif
 }
 
 void lvgl_port_unlock(void)
 {
+#if LOCK_PROFILE
+    if (lvgl_lock_depth > 0 && --lvgl_lock_depth == 0) {
+        lockProfileReleased(micros() - lvgl_lock_hold_start);
+    }
+#endif
     xSemaphoreGiveRecursive(lvgl_mux);
 }
 
+/* Wake the LVGL task early (no-op from the LVGL task itself, which is awake) */
+void lvgl_port_wake(void)
+{
+    if (lvgl_task_handle == NULL || xTaskGetCurrentTaskHandle() == lvgl_task_handle) return;
+    xTaskNotifyGive(lvgl_task_handle);
+}
+
+/* Same, from an interrupt handler */
+void IRAM_ATTR lvgl_port_wake_from_isr(void)
+{
+    if (lvgl_task_handle == NULL) return;
+    BaseType_t higher_priority_woken = pdFALSE;
+    vTaskNotifyGiveFromISR(lvgl_task_handle, &higher_priority_woken);
+    if (higher_priority_woken) portYIELD_FROM_ISR();
+}
+
+/* True while LVGL renders: the rounder is then only asked to round areas (get_max_row), nothing is invalidated */
+static bool lvgl_port_rendering(void)
+{
+    lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+    return disp != NULL && disp->rendering_in_progress;
+}
+
+/* LVGL calls the rounder for every invalidated area - used as the invalidation hook, areas are left as they are.
+ * Calls made while rendering only size the draw buffer rows and are not invalidations, so neither the
+ * latency probe nor the wakeup sees them. */
+static void lvgl_port_rounder(lv_disp_drv_t *disp_drv, lv_area_t *area)
+{
+    if (lvgl_port_rendering()) return;
+    latencyProbeInvalidate(area);
+    lvgl_port_wake();
+}
+
+/* Called after every refresh with the number of pixels redrawn */
+static void lvgl_port_monitor(lv_disp_drv_t *disp_drv, uint32_t time_ms, uint32_t px)
+{
+    perfMonitorRefresh(px);
+}
+
+void lvgl_port_get_wake_stats(lvgl_wake_stats_t *stats)
+{
+    *stats = lvgl_wake_stats;
+}
+
+/* Shortest sleep between handler runs when no event arrives (events still wake the task at once) */
+void lvgl_port_set_min_delay(uint32_t ms)
+{
+    lvgl_task_min_delay_ms = ms;
+}
+
+/* Backlight level - dimmed with a PWM backlight, otherwise the expander pin only switches it on or off */
+void lvgl_port_set_backlight(uint8_t percent)
+{
+    ESP_PanelBacklight *backlight = (panel != NULL) ? panel->getBacklight() : NULL;
+    if (backlight != NULL) {
+        backlight->setBrightness(percent);
+    } else if (lvgl_expander != NULL) {
+        lvgl_expander->digitalWrite(LCD_BL, percent > 0 ? HIGH : LOW);
+    }
+}
+
 void lvgl_port_task(void *arg)
 {
     Serial.println("Starting LVGL task");
 
-    uint32_t task_delay_ms = LVGL_TASK_MAX_DELAY_MS;
     while (1) {
+        uint32_t pass_start = micros();
+        
+        // Scan results queued by the scanner are applied here, in a lock of their own so
+        // the profiler can tell view updates apart from the timer handler pass
+        lvgl_port_lock_tagged(-1, "ui_bus_drain");
+        uiBusDrain();
+        lvgl_port_unlock();
+        
         // Lock the mutex due to the LVGL APIs are not thread-safe
-        lvgl_port_lock(-1);
-        task_delay_ms = lv_timer_handler();
+        lvgl_port_lock_tagged(-1, "lv_timer_handler");
+#if ESP_PANEL_USE_LCD_TOUCH
+        lvgl_port_touch_resume();
+#endif
+        uint32_t flushes = lvgl_flush_count;
+        uint32_t handler_start = micros();
+        lvgl_flush_block_us = 0;
+        uint32_t task_delay_ms = lv_timer_handler();
+        uint32_t handler_us = micros() - handler_start;
         // Release the mutex
         lvgl_port_unlock();
+        if (lvgl_flush_count == flushes) {
+            lvgl_wake_stats.wasted_wakeups++;
+        } else {
+            perfMonitorFrame(handler_us - lvgl_flush_block_us);
+        }
+        perfMonitorTaskPass(micros() - pass_start);
+        
+        // Sleep until the next timer is due (LV_NO_TIMER_READY when all are paused) or an event arrives
         if (task_delay_ms > LVGL_TASK_MAX_DELAY_MS) {
             task_delay_ms = LVGL_TASK_MAX_DELAY_MS;
-        } else if (task_delay_ms < LVGL_TASK_MIN_DELAY_MS) {
-            task_delay_ms = LVGL_TASK_MIN_DELAY_MS;
+        } else if (task_delay_ms < lvgl_task_min_delay_ms) {
+            task_delay_ms = lvgl_task_min_delay_ms;
+        }
+        if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(task_delay_ms)) > 0) {
+            lvgl_wake_stats.event_wakeups++;
+        } else {
+            lvgl_wake_stats.timer_wakeups++;
         }
-        vTaskDelay(pdMS_TO_TICKS(task_delay_ms));
     }
 }
 
@@ -102,7 +414,14 @@ void lvgl_port_init(void)
     static lv_disp_draw_buf_t draw_buf;
     uint8_t *buf = (uint8_t *)heap_caps_calloc(1, LVGL_BUF_SIZE * sizeof(lv_color_t), MALLOC_CAP_INTERNAL);
     assert(buf);
+#if LVGL_BUF_DOUBLE
+    /* Second buffer lets LVGL render the next strip while the previous one is flushed */
+    uint8_t *buf2 = (uint8_t *)heap_caps_calloc(1, LVGL_BUF_SIZE * sizeof(lv_color_t), MALLOC_CAP_INTERNAL);
+    assert(buf2);
+    lv_disp_draw_buf_init(&draw_buf, buf, buf2, LVGL_BUF_SIZE);
+#else
     lv_disp_draw_buf_init(&draw_buf, buf, NULL, LVGL_BUF_SIZE);
+#endif
     
     /* Initialize the display device */
     static lv_disp_drv_t disp_drv;
@@ -111,6 +430,11 @@ void lvgl_port_init(void)
     disp_drv.ver_res = ESP_PANEL_LCD_V_RES;
     disp_drv.flush_cb = lvgl_port_disp_flush;
     disp_drv.draw_buf = &draw_buf;
+    disp_drv.rounder_cb = lvgl_port_rounder;  // Invalidation hook that wakes the LVGL task
+    disp_drv.monitor_cb = lvgl_port_monitor;  // Invalidated area per refresh for the performance monitor
+#if (ESP_PANEL_LCD_BUS_TYPE == ESP_PANEL_BUS_TYPE_RGB) && LVGL_BUF_DOUBLE
+    disp_drv.wait_cb = lvgl_port_flush_wait;
+#endif
     lv_disp_drv_register(&disp_drv);
     
 #if ESP_PANEL_USE_LCD_TOUCH
@@ -119,6 +443,7 @@ void lvgl_port_init(void)
     lv_indev_drv_init(&indev_drv);
     indev_drv.type = LV_INDEV_TYPE_POINTER;
     indev_drv.read_cb = lvgl_port_tp_read;
+    indev_drv.feedback_cb = lvgl_port_tp_feedback;  // Event dispatch time for the latency probe
     lv_indev_drv_register(&indev_drv);
 #endif
     
@@ -144,14 +469,91 @@ void lvgl_port_init(void)
     expander->digitalWrite(USB_SEL, LOW);
     /* Add into panel */
     panel->addIOExpander(expander);
+    lvgl_expander = expander;
     
     /* Start panel */
     panel->begin();
     
+#if ESP_PANEL_USE_LCD_TOUCH
+    /* Read the GT911 only after it pulls INT low; without the interrupt the indev keeps polling */
+    esp_lcd_touch_handle_t tp = (panel->getLcdTouch() != NULL) ? panel->getLcdTouch()->getHandle() : NULL;
+    touch_indev_drv = &indev_drv;
+#if TOUCH_FILTER_ENABLE
+    if (tp != NULL) tp->config.process_coordinates = lvgl_port_touch_process;
+#endif
+    if (tp != NULL && esp_lcd_touch_register_interrupt_callback(tp, lvgl_port_touch_isr) == ESP_OK) {
+        touch_irq_enabled = true;
+        Serial.println("Touch interrupt enabled");
+    } else {
+        Serial.println("Touch interrupt unavailable, polling");
+    }
+#endif
+    
+    lvgl_flush_done = xSemaphoreCreateBinary();
+#if (ESP_PANEL_LCD_BUS_TYPE == ESP_PANEL_BUS_TYPE_RGB) && LVGL_BUF_DOUBLE
+    /* Create the flush task that copies finished strips into the frame buffer */
+    lvgl_flush_queue = xQueueCreate(LVGL_FLUSH_QUEUE_LEN, sizeof(lvgl_flush_job_t));
+    xTaskCreate(lvgl_port_flush_task, "lvgl_flush", LVGL_FLUSH_TASK_STACK_SIZE, NULL, LVGL_FLUSH_TASK_PRIORITY, NULL);
+#endif
+    
     /* Create a task to run the LVGL task periodically */
     lvgl_mux = xSemaphoreCreateRecursiveMutex();
-    xTaskCreate(lvgl_port_task, "lvgl", LVGL_TASK_STACK_SIZE, NULL, LVGL_TASK_PRIORITY, NULL);
+    xTaskCreate(lvgl_port_task, "lvgl", LVGL_TASK_STACK_SIZE, NULL, LVGL_TASK_PRIORITY, &lvgl_task_handle);
 }
 
 
 
+
+/* Benchmark: average full-screen frame time for several partial buffer sizes in SRAM and PSRAM */
+void lvgl_port_benchmark(void)
+{
+    static const uint16_t line_counts[] = {10, 20, 40, 80};
+    static const uint32_t caps[] = {MALLOC_CAP_INTERNAL, MALLOC_CAP_SPIRAM};
+    static const char *cap_names[] = {"SRAM", "PSRAM"};
+    
+    lv_disp_t *disp = lv_disp_get_default();
+    lv_disp_draw_buf_t *draw_buf = disp->driver->draw_buf;
+    lv_disp_draw_buf_t saved_buf = *draw_buf;  // Restored after the run
+    
+    Serial.printf("Draw buffer benchmark (%d full-screen frames each)\r\n", LVGL_BENCHMARK_FRAMES);
+    for (int c = 0; c < 2; c++) {
+        for (int l = 0; l < 4; l++) {
+            uint32_t px = ESP_PANEL_LCD_H_RES * line_counts[l];
+            void *b1 = heap_caps_malloc(px * sizeof(lv_color_t), caps[c]);
+            void *b2 = LVGL_BUF_DOUBLE ? heap_caps_malloc(px * sizeof(lv_color_t), caps[c]) : NULL;
+            if (b1 == NULL || (LVGL_BUF_DOUBLE && b2 == NULL)) {
+                Serial.printf("  %-5s %2u lines: allocation failed\r\n", cap_names[c], line_counts[l]);
+                free(b1);
+                free(b2);
+                continue;
+            }
+            lv_disp_draw_buf_init(draw_buf, b1, b2, px);
+            
+            xSemaphoreTake(lvgl_flush_done, 0);   // Drop a give left over from earlier strips
+            bool timed_out = false;
+            uint32_t start = micros();
+            for (int i = 0; i < LVGL_BENCHMARK_FRAMES && !timed_out; i++) {
+                lv_obj_invalidate(lv_scr_act());
+                lv_refr_now(disp);
+                // Include the last strip's flush in the frame time: sleep until the flush completion gives
+                // the semaphore (a stale give only costs one more check of the flag)
+                while (draw_buf->flushing && !timed_out) {
+                    timed_out = xSemaphoreTake(lvgl_flush_done, pdMS_TO_TICKS(LVGL_FLUSH_TIMEOUT_MS)) != pdTRUE;
+                }
+            }
+            uint32_t frame_us = (micros() - start) / LVGL_BENCHMARK_FRAMES;
+            if (timed_out) {
+                Serial.printf("  %-5s %2u lines: flush not done within %d ms\r\n", cap_names[c], line_counts[l],
+                              LVGL_FLUSH_TIMEOUT_MS);
+            } else {
+                Serial.printf("  %-5s %2u lines: %lu us/frame\r\n", cap_names[c], line_counts[l], (unsigned long)frame_us);
+            }
+            
+            free(b1);
+            free(b2);
+        }
+    }
+    
+    *draw_buf = saved_buf;
+    lv_obj_invalidate(lv_scr_act());
+}
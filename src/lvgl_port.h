@@ -10,6 +10,18 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
 
+// LVGL task wakeup counters (since boot)
+typedef struct {
+    uint32_t event_wakeups;     // Woken early by an invalidation or touch
+    uint32_t timer_wakeups;     // Woken by the next LVGL timer deadline
+    uint32_t wasted_wakeups;    // Handler runs that flushed nothing to the panel
+    uint32_t touch_irqs;        // GT911 interrupts
+    uint32_t touch_reads;       // GT911 reads over I2C
+} lvgl_wake_stats_t;
+
+// Every lock is tagged with the calling function for the lock profiler
+#define lvgl_port_lock(timeout_ms) lvgl_port_lock_tagged((timeout_ms), __func__)
+
 // Global panel and mutex (extern declarations)
 extern ESP_Panel *panel;
 extern SemaphoreHandle_t lvgl_mux;
@@ -17,11 +29,17 @@ extern SemaphoreHandle_t lvgl_mux;
 // Functions
 void lvgl_port_disp_flush(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p);
 void lvgl_port_tp_read(lv_indev_drv_t *indev, lv_indev_data_t *data);
-void lvgl_port_lock(int timeout_ms);
+void lvgl_port_lock_tagged(int timeout_ms, const char *tag);
 void lvgl_port_unlock(void);
 void lvgl_port_task(void *arg);
+void lvgl_port_wake(void);
+void lvgl_port_wake_from_isr(void);
+void lvgl_port_get_wake_stats(lvgl_wake_stats_t *stats);
+void lvgl_port_set_min_delay(uint32_t ms);
+void lvgl_port_set_backlight(uint8_t percent);
 bool notify_lvgl_flush_ready(void *user_ctx);
 void lvgl_port_init(void);
+void lvgl_port_benchmark(void);
 
 #endif // LVGL_PORT_H
 
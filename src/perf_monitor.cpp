@@ -0,0 +1,288 @@
+/*
+ * Performance monitor implementation
+ *
+ * Replaces LVGL's perf and memory monitors (one is off, the other does not
+ * work with LV_MEM_CUSTOM) with histograms that are useful when tuning buffer
+ * sizes and render paths. The LVGL port reports each handler pass that drew
+ * something (its time minus the time spent waiting for the panel, i.e. the
+ * render time), each refresh's invalidated area (display monitor callback),
+ * each strip flushed to the panel and how long the LVGL task was awake; the
+ * scanner reports its sweep time. FPS and the LVGL task's CPU share are
+ * measured over PERF_WINDOW_MS windows closed by the LVGL task.
+ *
+ * Every histogram has exactly one writer task, so recording needs no lock. A
+ * reset bumps a generation number and each histogram clears itself on its
+ * next record, the same deferred reset the lock profiler uses. The overlay is
+ * a label on the top layer refreshed once per window from the last closed
+ * window; its own redraw is small but does show up in the numbers.
+ */
+
+#include "perf_monitor.h"
+#include "ui_theme.h"
+#include "config.h"
+#include <Arduino.h>
+#include <lvgl.h>
+#include <string.h>
+
+#if PERF_MONITOR
+#define PERF_BUCKETS 20     // Log2: bucket b counts values in [2^b, 2^(b+1)); linear: [b*step, (b+1)*step); the last one everything above
+
+struct PerfHistogram {
+    const char *name;
+    uint16_t step;          // Linear bucket width (0 = log2 buckets)
+    uint32_t generation;    // Reset generation the counters belong to
+    uint32_t count;
+    uint64_t total;
+    uint32_t max;
+    uint32_t buckets[PERF_BUCKETS];
+};
+
+// Writers: render/area/fps/cpu = LVGL task, flush = flush task (or LVGL task without one), scan = scanner
+static PerfHistogram hist_render = {"render us", 0};
+static PerfHistogram hist_flush = {"flush us", 0};
+static PerfHistogram hist_flush_rate = {"flush px/ms", 0};
+static PerfHistogram hist_area = {"area px", 0};
+static PerfHistogram hist_fps = {"fps", 2};
+static PerfHistogram hist_cpu = {"lvgl cpu %", 5};
+static PerfHistogram hist_scan = {"scan ms", 0};
+static PerfHistogram *const histograms[] = {
+    &hist_render, &hist_flush, &hist_flush_rate, &hist_area, &hist_fps, &hist_cpu, &hist_scan
+};
+
+static volatile uint32_t reset_generation = 0;
+static uint32_t reset_ms = 0;
+
+// Flush totals since boot (flush task), windowed by difference
+static volatile uint32_t flush_total_us = 0;
+static volatile uint32_t flush_total_px = 0;
+
+// Current window (LVGL task only)
+static uint32_t window_start_us = 0;
+static uint32_t window_busy_us = 0;
+static uint32_t window_frames = 0;
+static uint32_t window_render_us = 0;
+static uint32_t window_render_max_us = 0;
+static uint32_t window_refreshes = 0;
+static uint32_t window_area_px = 0;
+static uint32_t window_flush_us_start = 0;
+static uint32_t window_flush_px_start = 0;
+
+// Last closed window, shown by the overlay
+struct PerfWindow {
+    uint32_t fps_x10;
+    uint32_t cpu_pct;
+    uint32_t render_avg_us;
+    uint32_t render_max_us;
+    uint32_t flush_us_per_frame;
+    uint32_t flush_px_per_ms;
+    uint32_t area_px_per_refresh;
+};
+static PerfWindow last_window = {0, 0, 0, 0, 0, 0, 0};
+static volatile uint32_t last_scan_ms = 0;
+
+static lv_obj_t *overlay_label = NULL;
+static lv_timer_t *overlay_timer = NULL;
+static char overlay_text[160];      // Text on the label, to skip redundant updates
+
+static inline uint8_t bucketOf(const PerfHistogram *h, uint32_t value) {
+    uint32_t b;
+    if (h->step > 0) {
+        b = value / h->step;
+    } else {
+        b = (value > 1) ? (31 - __builtin_clz(value)) : 0;
+    }
+    return (b < PERF_BUCKETS) ? (uint8_t)b : PERF_BUCKETS - 1;
+}
+
+static void record(PerfHistogram *h, uint32_t value) {
+    if (h->generation != reset_generation) {
+        h->count = 0;
+        h->total = 0;
+        h->max = 0;
+        memset(h->buckets, 0, sizeof(h->buckets));
+        h->generation = reset_generation;
+    }
+    h->count++;
+    h->total += value;
+    if (value > h->max) h->max = value;
+    h->buckets[bucketOf(h, value)]++;
+}
+
+static void printHistogram(const PerfHistogram *h) {
+    printf("      ");
+    for (uint8_t b = 0; b < PERF_BUCKETS; b++) {
+        if (h->buckets[b] == 0) continue;
+        uint32_t low = h->step ? (uint32_t)b * h->step : (1UL << b);
+        uint32_t high = h->step ? low + h->step : (2UL << b);
+        if (b == PERF_BUCKETS - 1) {
+            printf(" >=%lu:%lu", (unsigned long)low, (unsigned long)h->buckets[b]);
+        } else {
+            printf(" <%lu:%lu", (unsigned long)high, (unsigned long)h->buckets[b]);
+        }
+    }
+    printf("\r\n");
+}
+
+// Close the current window: FPS (only windows that drew), CPU share and the overlay's numbers
+static void closeWindow(uint32_t now_us) {
+    uint32_t elapsed_us = now_us - window_start_us;
+    uint32_t flush_us = flush_total_us - window_flush_us_start;
+    uint32_t flush_px = flush_total_px - window_flush_px_start;
+    
+    PerfWindow w;
+    w.fps_x10 = (uint32_t)((uint64_t)window_frames * 10000000ULL / elapsed_us);
+    w.cpu_pct = (uint32_t)((uint64_t)window_busy_us * 100 / elapsed_us);
+    w.render_avg_us = window_frames ? window_render_us / window_frames : 0;
+    w.render_max_us = window_render_max_us;
+    w.flush_us_per_frame = window_frames ? flush_us / window_frames : 0;
+    w.flush_px_per_ms = flush_us ? (uint32_t)((uint64_t)flush_px * 1000 / flush_us) : 0;
+    w.area_px_per_refresh = window_refreshes ? window_area_px / window_refreshes : 0;
+    last_window = w;
+    
+    if (window_frames > 0) record(&hist_fps, (w.fps_x10 + 5) / 10);
+    record(&hist_cpu, w.cpu_pct);
+    
+    window_start_us = now_us;
+    window_busy_us = 0;
+    window_frames = 0;
+    window_render_us = 0;
+    window_render_max_us = 0;
+    window_refreshes = 0;
+    window_area_px = 0;
+    window_flush_us_start = flush_total_us;
+    window_flush_px_start = flush_total_px;
+}
+
+static void overlayTimerCallback(lv_timer_t *timer) {
+    if (overlay_label == NULL) return;
+    char next[sizeof(overlay_text)];
+    const PerfWindow *w = &last_window;
+    snprintf(next, sizeof(next),
+             "%lu.%lu fps  cpu %lu%%\nrender %lu us (max %lu)\nflush %lu us/frame  %lu px/ms\narea %lu px\nscan %lu ms",
+             (unsigned long)(w->fps_x10 / 10), (unsigned long)(w->fps_x10 % 10), (unsigned long)w->cpu_pct,
+             (unsigned long)w->render_avg_us, (unsigned long)w->render_max_us,
+             (unsigned long)w->flush_us_per_frame, (unsigned long)w->flush_px_per_ms,
+             (unsigned long)w->area_px_per_refresh, (unsigned long)last_scan_ms);
+    // Unchanged text would still invalidate the label
+    if (strcmp(next, overlay_text) == 0) return;
+    strcpy(overlay_text, next);
+    lv_label_set_text(overlay_label, overlay_text);
+}
+#endif
+
+// LVGL task: a handler pass that flushed, minus the time it waited for the panel
+void perfMonitorFrame(uint32_t render_us) {
+#if PERF_MONITOR
+    record(&hist_render, render_us);
+    window_frames++;
+    window_render_us += render_us;
+    if (render_us > window_render_max_us) window_render_max_us = render_us;
+#endif
+}
+
+// LVGL task (display monitor callback): pixels redrawn by one refresh
+void perfMonitorRefresh(uint32_t area_px) {
+#if PERF_MONITOR
+    record(&hist_area, area_px);
+    window_refreshes++;
+    window_area_px += area_px;
+#endif
+}
+
+// Flush task: one strip copied to the panel
+void perfMonitorFlush(uint32_t flush_us, uint32_t px) {
+#if PERF_MONITOR
+    record(&hist_flush, flush_us);
+    if (flush_us > 0) record(&hist_flush_rate, (uint32_t)((uint64_t)px * 1000 / flush_us));
+    flush_total_us += flush_us;
+    flush_total_px += px;
+#endif
+}
+
+// LVGL task: time awake in one loop pass, before it goes back to sleep
+void perfMonitorTaskPass(uint32_t busy_us) {
+#if PERF_MONITOR
+    uint32_t now_us = micros();
+    if (window_start_us == 0) {
+        window_start_us = now_us;
+        window_flush_us_start = flush_total_us;
+        window_flush_px_start = flush_total_px;
+    }
+    window_busy_us += busy_us;
+    if (now_us - window_start_us >= PERF_WINDOW_MS * 1000UL) closeWindow(now_us);
+#endif
+}
+
+// Scanner: one sweep, from starting the scan to handing the results to the UI
+void perfMonitorScan(uint32_t scan_ms) {
+#if PERF_MONITOR
+    record(&hist_scan, scan_ms);
+    last_scan_ms = scan_ms;
+#endif
+}
+
+// Clear the histograms (each one on its next record)
+void perfMonitorReset() {
+#if PERF_MONITOR
+    reset_ms = millis();
+    reset_generation++;
+#endif
+}
+
+// Print count, average, maximum and histogram of every metric
+void perfMonitorDump() {
+#if PERF_MONITOR
+    uint32_t since_ms = millis() - reset_ms;
+    printf("---- Performance (%lu.%lu s since reset) ----\r\n", (unsigned long)(since_ms / 1000),
+           (unsigned long)(since_ms / 100 % 10));
+    printf("  %-12s %8s %8s %8s\r\n", "metric", "count", "avg", "max");
+    for (size_t i = 0; i < sizeof(histograms) / sizeof(histograms[0]); i++) {
+        // Copy first: the writer may update it meanwhile (a value may be one record behind)
+        PerfHistogram h = *histograms[i];
+        if (h.generation != reset_generation || h.count == 0) {
+            printf("  %-12s %8s\r\n", h.name, "-");
+            continue;
+        }
+        printf("  %-12s %8lu %8lu %8lu\r\n", h.name, (unsigned long)h.count,
+               (unsigned long)(h.total / h.count), (unsigned long)h.max);
+        printHistogram(&h);
+    }
+    printf("----------------------------------------\r\n");
+#else
+    printf("Performance monitor is disabled (PERF_MONITOR 0)\r\n");
+#endif
+}
+
+// Show or hide the on-screen overlay (LVGL lock held)
+void perfMonitorSetOverlay(bool visible) {
+#if PERF_MONITOR
+    if (visible == (overlay_label != NULL)) return;
+    if (!visible) {
+        lv_timer_del(overlay_timer);
+        lv_obj_del(overlay_label);
+        overlay_timer = NULL;
+        overlay_label = NULL;
+        return;
+    }
+    
+    // Top right of the info window, above every view
+    overlay_label = lv_label_create(lv_layer_top());
+    lv_obj_add_style(overlay_label, &ui_style_bar, LV_PART_MAIN);
+    lv_obj_add_style(overlay_label, &ui_style_caption, LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(overlay_label, LV_OPA_80, LV_PART_MAIN);
+    lv_obj_align(overlay_label, LV_ALIGN_TOP_LEFT, INFO_WINDOW_WIDTH - 200, 4);
+    lv_obj_set_width(overlay_label, 196);
+    overlay_text[0] = '\0';
+    lv_label_set_text(overlay_label, overlay_text);
+    overlay_timer = lv_timer_create(overlayTimerCallback, PERF_WINDOW_MS, NULL);
+    overlayTimerCallback(overlay_timer);
+#endif
+}
+
+bool perfMonitorOverlayVisible() {
+#if PERF_MONITOR
+    return overlay_label != NULL;
+#else
+    return false;
+#endif
+}
@@ -0,0 +1,21 @@
+/*
+ * Performance monitor (render, flush, invalidated area, FPS, LVGL CPU share, scan time)
+ */
+
+#ifndef PERF_MONITOR_H
+#define PERF_MONITOR_H
+
+#include <stdint.h>
+
+// Functions (each recorder has a single writer task, noted per function in perf_monitor.cpp)
+void perfMonitorFrame(uint32_t render_us);
+void perfMonitorRefresh(uint32_t area_px);
+void perfMonitorFlush(uint32_t flush_us, uint32_t px);
+void perfMonitorTaskPass(uint32_t busy_us);
+void perfMonitorScan(uint32_t scan_ms);
+void perfMonitorReset();
+void perfMonitorDump();
+void perfMonitorSetOverlay(bool visible);
+bool perfMonitorOverlayVisible();
+
+#endif // PERF_MONITOR_H
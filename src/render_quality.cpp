@@ -0,0 +1,124 @@
+/*
+ * Adaptive graph render quality implementation
+ *
+ * The graph is drawn at one of four quality tiers. The tier is the worse of two
+ * proposals: one from the number of visible networks (with a few networks of
+ * hysteresis), and one from a rolling average of the measured graph frame time
+ * (drop a tier when over budget, restore one only after a sustained run of
+ * cheap frames). Nobody can see 10% fills under 60 overlapping networks, so
+ * they are the first thing to go.
+ */
+
+#include "render_quality.h"
+#include "wifi_data.h"
+#include "config.h"
+#include <lvgl.h>
+
+// External UI objects (declared in ui_views.cpp)
+extern lv_obj_t *graph_obj;
+
+static const uint16_t tier_max_networks[QUALITY_TIER_COUNT - 1] = {
+    QUALITY_FULL_MAX_NETWORKS, QUALITY_LABELS_MAX_NETWORKS, QUALITY_OUTLINE_MAX_NETWORKS
+};
+
+static RenderQuality current_tier = QUALITY_FULL;
+static int count_tier = QUALITY_FULL;   // Proposed from the network count
+static int time_tier = QUALITY_FULL;    // Proposed from the frame time
+static int forced_tier = QUALITY_AUTO;
+
+static lv_timer_t *sample_timer = NULL;
+static uint32_t pending_draw_us = 0;    // Graph draw time since the last sample
+static uint32_t average_frame_us = 0;   // Rolling average (1/4 weight per frame)
+static uint16_t frames_since_change = 0;
+static uint16_t fast_frames = 0;
+
+// Tier suggested by the number of visible networks, sticky by QUALITY_COUNT_HYSTERESIS
+static int tierForCount(uint16_t count, int previous) {
+    int tier = QUALITY_FULL;
+    while (tier < QUALITY_BARS && count > tier_max_networks[tier]) tier++;
+    
+    // Only move back to a better tier once the count is clearly below its limit
+    if (tier < previous && count + QUALITY_COUNT_HYSTERESIS > tier_max_networks[tier]) {
+        tier = previous;
+    }
+    return tier;
+}
+
+static void applyTier() {
+    int tier = (forced_tier != QUALITY_AUTO) ? forced_tier : (count_tier > time_tier ? count_tier : time_tier);
+    if (tier == current_tier) return;
+    
+    current_tier = (RenderQuality)tier;
+    frames_since_change = 0;
+    fast_frames = 0;
+    average_frame_us = 0;
+    markGraphLabelsDirty();
+    if (graph_obj) lv_obj_invalidate(graph_obj);
+}
+
+// Fold the graph draw time of each rendered frame into the rolling average
+static void renderQualitySample(lv_timer_t *timer) {
+    count_tier = tierForCount(wifi_network_count, count_tier);
+    
+    // Nothing drawn since the last sample: sleep until the graph draws again
+    if (pending_draw_us == 0) {
+        lv_timer_pause(timer);
+    } else {
+        uint32_t frame_us = pending_draw_us;
+        pending_draw_us = 0;
+        
+        if (frames_since_change == 0) {
+            average_frame_us = frame_us;
+        } else {
+            average_frame_us += ((int32_t)frame_us - (int32_t)average_frame_us) / 4;
+        }
+        if (frames_since_change < UINT16_MAX) frames_since_change++;
+        
+        if (frames_since_change >= QUALITY_SETTLE_FRAMES) {
+            if (average_frame_us > QUALITY_FRAME_BUDGET_US) {
+                if (current_tier < QUALITY_BARS) time_tier = current_tier + 1;
+                fast_frames = 0;
+            } else if (average_frame_us < QUALITY_UPGRADE_US) {
+                if (++fast_frames >= QUALITY_UPGRADE_FRAMES && time_tier > QUALITY_FULL) {
+                    time_tier--;
+                    fast_frames = 0;
+                }
+            } else {
+                fast_frames = 0;
+            }
+        }
+    }
+    
+    applyTier();
+}
+
+// Start sampling (call once with the LVGL lock held)
+void renderQualityInit() {
+    sample_timer = lv_timer_create(renderQualitySample, LV_DISP_DEF_REFR_PERIOD, NULL);
+}
+
+// Called from graph_draw_cb with the time spent drawing one area of the graph
+void renderQualityAddDrawTime(uint32_t draw_us) {
+    pending_draw_us += draw_us;
+    if (sample_timer) lv_timer_resume(sample_timer);
+}
+
+RenderQuality renderQualityGet() {
+    return current_tier;
+}
+
+// Pin a tier (e.g. for golden-image tests), or QUALITY_AUTO to adapt again
+void renderQualityForce(int tier) {
+    forced_tier = (tier >= QUALITY_FULL && tier < QUALITY_TIER_COUNT) ? tier : QUALITY_AUTO;
+    applyTier();
+}
+
+const char *renderQualityName(RenderQuality tier) {
+    switch (tier) {
+        case QUALITY_FULL: return "full";
+        case QUALITY_OUTLINE_LABELS: return "outline+labels";
+        case QUALITY_OUTLINE: return "outline";
+        case QUALITY_BARS: return "bars";
+        default: return "?";
+    }
+}
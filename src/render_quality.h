@@ -0,0 +1,28 @@
+/*
+ * Adaptive graph render quality
+ */
+
+#ifndef RENDER_QUALITY_H
+#define RENDER_QUALITY_H
+
+#include <stdint.h>
+
+// Quality tiers, best first
+enum RenderQuality {
+    QUALITY_FULL = 0,        // Translucent fill, 2 px outline, labels
+    QUALITY_OUTLINE_LABELS,  // 1 px outline, labels
+    QUALITY_OUTLINE,         // 1 px outline only
+    QUALITY_BARS,            // One solid bar per network
+    QUALITY_TIER_COUNT
+};
+
+#define QUALITY_AUTO (-1)
+
+// Functions
+void renderQualityInit();
+void renderQualityAddDrawTime(uint32_t draw_us);
+RenderQuality renderQualityGet();
+void renderQualityForce(int tier);
+const char *renderQualityName(RenderQuality tier);
+
+#endif // RENDER_QUALITY_H
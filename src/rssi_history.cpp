@@ -0,0 +1,178 @@
+/*
+ * RSSI-over-time history implementation
+ *
+ * Each pinned BSSID owns a fixed ring of HISTORY_POINTS samples that the chart
+ * reads in place (lv_chart_set_ext_y_array), so sampling never allocates or
+ * copies point arrays. The chart runs in circular mode: every sweep writes the
+ * sample at the shared head index, leaves a gap after it as the "now" cursor,
+ * and invalidates only that column.
+ *
+ * Pins and samples do not depend on the chart: the view may not have been
+ * built yet or may have been freed while hidden. rssiHistoryAttachChart()
+ * adds a series per pinned ring when the chart is (re)created.
+ */
+
+#include "rssi_history.h"
+#include "ui_theme.h"
+#include "config.h"
+#include <Arduino.h>
+#include <string.h>
+
+// External UI objects (declared in ui_views.cpp)
+extern lv_obj_t *history_chart;
+extern lv_obj_t *history_legend;
+
+// One pinned network
+struct HistorySlot {
+    bool used;
+    uint8_t bssid[6];
+    char ssid[33];
+    lv_chart_series_t *series;
+};
+
+static HistorySlot history_slots[HISTORY_MAX_PINNED];
+static lv_coord_t history_points[HISTORY_MAX_PINNED][HISTORY_POINTS];
+static uint16_t history_head = 0;  // Index written by the next sweep
+
+static const uint32_t history_palette[HISTORY_MAX_PINNED] = {
+    0x4fc3f7, 0xffb74d, 0x81c784, 0xe57373, 0xba68c8, 0xfff176, 0x4db6ac, 0xf06292
+};
+
+static int findSlot(const uint8_t *bssid) {
+    for (int i = 0; i < HISTORY_MAX_PINNED; i++) {
+        if (history_slots[i].used && memcmp(history_slots[i].bssid, bssid, 6) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Rebuild the legend labels (only when the pin set changes)
+static void refreshLegend() {
+    if (history_legend == NULL) return;
+    lv_obj_clean(history_legend);
+    for (int i = 0; i < HISTORY_MAX_PINNED; i++) {
+        if (!history_slots[i].used) continue;
+        lv_obj_t *label = lv_label_create(history_legend);
+        lv_label_set_text(label, history_slots[i].ssid);
+        lv_obj_add_style(label, &ui_style_axis_label, LV_PART_MAIN);
+        lv_obj_set_style_text_color(label, lv_color_hex(history_palette[i]), LV_PART_MAIN);
+    }
+}
+
+// Give a pinned ring its chart series (read in place)
+static void addSeries(int slot) {
+    HistorySlot *s = &history_slots[slot];
+    s->series = lv_chart_add_series(history_chart, lv_color_hex(history_palette[slot]), LV_CHART_AXIS_PRIMARY_Y);
+    lv_chart_set_ext_y_array(history_chart, s->series, history_points[slot]);
+}
+
+// Pin or unpin a BSSID; returns true if it is pinned afterwards
+bool rssiHistoryTogglePin(const uint8_t *bssid, const char *ssid) {
+    int slot = findSlot(bssid);
+    if (slot >= 0) {
+        if (history_chart) lv_chart_remove_series(history_chart, history_slots[slot].series);
+        history_slots[slot].used = false;
+        history_slots[slot].series = NULL;
+        refreshLegend();
+        return false;
+    }
+    
+    for (slot = 0; slot < HISTORY_MAX_PINNED; slot++) {
+        if (!history_slots[slot].used) break;
+    }
+    if (slot == HISTORY_MAX_PINNED) {
+        Serial.printf("History: already %d networks pinned\r\n", HISTORY_MAX_PINNED);
+        return false;
+    }
+    
+    HistorySlot *s = &history_slots[slot];
+    s->used = true;
+    memcpy(s->bssid, bssid, 6);
+    strncpy(s->ssid, ssid, sizeof(s->ssid) - 1);
+    s->ssid[sizeof(s->ssid) - 1] = '\0';
+    
+    // Empty history, read in place by the chart
+    for (int i = 0; i < HISTORY_POINTS; i++) {
+        history_points[slot][i] = LV_CHART_POINT_NONE;
+    }
+    s->series = NULL;
+    if (history_chart) {
+        addSeries(slot);
+        lv_obj_invalidate(history_chart);
+    }
+    
+    refreshLegend();
+    return true;
+}
+
+// Bind the pinned rings to a newly created chart and fill its legend
+void rssiHistoryAttachChart() {
+    if (history_chart == NULL) return;
+    for (int slot = 0; slot < HISTORY_MAX_PINNED; slot++) {
+        if (history_slots[slot].used) addSeries(slot);
+    }
+    refreshLegend();
+}
+
+// Forget the series before the chart is deleted (the rings keep sampling)
+void rssiHistoryDetachChart() {
+    for (int slot = 0; slot < HISTORY_MAX_PINNED; slot++) {
+        history_slots[slot].series = NULL;
+    }
+}
+
+bool rssiHistoryIsPinned(const uint8_t *bssid) {
+    return findSlot(bssid) >= 0;
+}
+
+// Invalidate the chart between two point indices (inclusive)
+static void invalidateColumns(uint16_t first, uint16_t last) {
+    lv_chart_series_t *ser = lv_chart_get_series_next(history_chart, NULL);
+    if (ser == NULL) return;
+    
+    lv_point_t p_first, p_last;
+    lv_chart_get_point_pos_by_id(history_chart, ser, first, &p_first);
+    lv_chart_get_point_pos_by_id(history_chart, ser, last, &p_last);
+    
+    lv_area_t coords;
+    lv_obj_get_coords(history_chart, &coords);
+    lv_area_t column = {(lv_coord_t)(coords.x1 + p_first.x - 2), coords.y1,
+                        (lv_coord_t)(coords.x1 + p_last.x + 2), coords.y2};
+    lv_obj_invalidate_area(history_chart, &column);
+}
+
+// Append one sample per pinned BSSID (missing from this sweep = gap)
+void updateRssiHistory(const wifi_ap_record_t *ap_records, uint16_t ap_count) {
+    uint16_t head = history_head;
+    uint16_t next = (head + 1) % HISTORY_POINTS;
+    bool any_pinned = false;
+    
+    for (int slot = 0; slot < HISTORY_MAX_PINNED; slot++) {
+        if (!history_slots[slot].used) continue;
+        any_pinned = true;
+        
+        lv_coord_t value = LV_CHART_POINT_NONE;
+        for (uint16_t i = 0; i < ap_count; i++) {
+            if (memcmp(ap_records[i].bssid, history_slots[slot].bssid, 6) == 0) {
+                value = ap_records[i].rssi;
+                break;
+            }
+        }
+        history_points[slot][head] = value;
+        history_points[slot][next] = LV_CHART_POINT_NONE;  // Gap marks "now"
+    }
+    history_head = next;
+    
+    // Invalidate only the segments touching the new sample and the gap after it
+    if (any_pinned && history_chart) {
+        uint16_t first = (head > 0) ? head - 1 : 0;
+        if (next > head) {
+            invalidateColumns(first, (next + 1 < HISTORY_POINTS) ? next + 1 : next);
+        } else {
+            // Wrapped: the gap moved back to the start of the ring
+            invalidateColumns(first, head);
+            invalidateColumns(0, 1);
+        }
+    }
+}
@@ -0,0 +1,18 @@
+/*
+ * RSSI-over-time history for pinned networks
+ */
+
+#ifndef RSSI_HISTORY_H
+#define RSSI_HISTORY_H
+
+#include <lvgl.h>
+#include "esp_wifi.h"
+
+// Functions
+bool rssiHistoryTogglePin(const uint8_t *bssid, const char *ssid);
+bool rssiHistoryIsPinned(const uint8_t *bssid);
+void rssiHistoryAttachChart();
+void rssiHistoryDetachChart();
+void updateRssiHistory(const wifi_ap_record_t *ap_records, uint16_t ap_count);
+
+#endif // RSSI_HISTORY_H
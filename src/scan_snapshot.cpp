@@ -0,0 +1,107 @@
+/*
+ * Per-sweep scan snapshot implementation
+ *
+ * The graph, the table and the dashboard all need the same things from a
+ * sweep: the SSID with hidden networks substituted, the occupied channel span,
+ * the formatted channel/RSSI/width/security strings and the SSID label size.
+ * They are derived once here instead of in every view. Two snapshots are kept:
+ * the next one is built in the back buffer without the LVGL lock (the views
+ * only ever read the front one), and publishing is a pointer swap under the
+ * lock, so a view never sees a half-built sweep.
+ */
+
+#include "scan_snapshot.h"
+#include "wifi_scanner.h"
+#include <stdio.h>
+#include <string.h>
+
+static ScanSnapshot snapshots[2];
+static ScanSnapshot *front = &snapshots[0];
+static ScanSnapshot *back = &snapshots[1];
+
+// Fill in everything derived from one record except the label size
+void scanSnapshotDescribe(const wifi_ap_record_t *rec, SnapshotNetwork *net) {
+    memcpy(net->bssid, rec->bssid, 6);
+    int ssidLen = strlen((const char*)rec->ssid);
+    if (ssidLen == 0 || ssidLen > 32) {
+        strcpy(net->ssid, "(hidden)");
+    } else {
+        memcpy(net->ssid, rec->ssid, ssidLen);
+        net->ssid[ssidLen] = '\0';
+    }
+    net->rssi = rec->rssi;
+    net->channel = rec->primary;
+    net->second = rec->second;
+    net->authmode = rec->authmode;
+    
+    // Calculate center channel and width
+    net->center_channel = rec->primary;
+    net->width_channels = 4;  // Default 20MHz = 4 channels
+    if (rec->second == WIFI_SECOND_CHAN_ABOVE) {
+        net->center_channel = rec->primary + 2.0f;
+        net->width_channels = 8;
+    } else if (rec->second == WIFI_SECOND_CHAN_BELOW) {
+        net->center_channel = rec->primary - 2.0f;
+        net->width_channels = 8;
+    }
+    
+    snprintf(net->channel_text, sizeof(net->channel_text), "%d", rec->primary);
+    snprintf(net->rssi_text, sizeof(net->rssi_text), "%d", rec->rssi);
+    net->width_text = getChannelWidthString(rec->second);
+    net->security_text = getEncryptionTypeString(rec->authmode);
+    
+    // PHY modes advertised in the beacon, e.g. "b/g/n"
+    const char *phy_names[4] = {"b", "g", "n", "LR"};
+    bool phy_bits[4] = {rec->phy_11b != 0, rec->phy_11g != 0, rec->phy_11n != 0, rec->phy_lr != 0};
+    net->phy_text[0] = '\0';
+    for (int p = 0; p < 4; p++) {
+        if (!phy_bits[p]) continue;
+        if (net->phy_text[0]) strcat(net->phy_text, "/");
+        strcat(net->phy_text, phy_names[p]);
+    }
+    memcpy(net->country, rec->country.cc, 2);
+    net->country[2] = '\0';
+}
+
+// Derive the next snapshot from the merged scan results (scanner task, no lock needed;
+// the back buffer is the scanner's until the sweep event has been handled)
+void scanSnapshotBuild(const wifi_ap_record_t *ap_records, uint16_t ap_count) {
+    if (ap_count > SNAPSHOT_MAX_NETWORKS) ap_count = SNAPSHOT_MAX_NETWORKS;
+    
+    for (uint16_t i = 0; i < ap_count; i++) {
+        const wifi_ap_record_t *rec = &ap_records[i];
+        SnapshotNetwork *net = &back->networks[i];
+        scanSnapshotDescribe(rec, net);
+        
+        // Measure the label through the font metrics once per SSID (the front snapshot is read-only here)
+        net->label_width = 0;
+        for (uint16_t j = 0; j < front->count; j++) {
+            if (strcmp(front->networks[j].ssid, net->ssid) == 0) {
+                net->label_width = front->networks[j].label_width;
+                net->label_height = front->networks[j].label_height;
+                break;
+            }
+        }
+        if (net->label_width == 0) {
+            lv_point_t text_size;
+            lv_txt_get_size(&text_size, net->ssid, &lv_font_montserrat_10, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+            net->label_width = text_size.x;
+            net->label_height = text_size.y;
+        }
+    }
+    back->count = ap_count;
+    back->sweep = front->sweep + 1;
+}
+
+// Make the built snapshot the one views read (call with the LVGL lock held)
+const ScanSnapshot *scanSnapshotPublish() {
+    ScanSnapshot *built = back;
+    back = front;
+    front = built;
+    return front;
+}
+
+// Latest published snapshot (read with the LVGL lock held)
+const ScanSnapshot *scanSnapshotGet() {
+    return front;
+}
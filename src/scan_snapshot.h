@@ -0,0 +1,46 @@
+/*
+ * Per-sweep snapshot of the scan results shared by every view
+ */
+
+#ifndef SCAN_SNAPSHOT_H
+#define SCAN_SNAPSHOT_H
+
+#include <lvgl.h>
+#include "esp_wifi.h"
+
+#define SNAPSHOT_MAX_NETWORKS 64
+
+// One network with everything the views derive from its record
+struct SnapshotNetwork {
+    uint8_t bssid[6];
+    char ssid[33];              // "(hidden)" for hidden networks
+    int8_t rssi;
+    uint8_t channel;
+    wifi_second_chan_t second;
+    wifi_auth_mode_t authmode;
+    float center_channel;       // Centre of the occupied span (bonded channels shift it by 2)
+    int width_channels;         // Occupied span: 4 for 20MHz, 8 for 40MHz
+    char channel_text[4];
+    char rssi_text[6];
+    const char *width_text;
+    const char *security_text;
+    char phy_text[12];          // "b/g/n", plus "LR" for Espressif long range
+    char country[3];            // Country code from the beacon, empty if not advertised
+    int16_t label_width;        // SSID label size in the graph font
+    int16_t label_height;
+};
+
+// One sweep, strongest network first
+struct ScanSnapshot {
+    SnapshotNetwork networks[SNAPSHOT_MAX_NETWORKS];
+    uint16_t count;
+    uint32_t sweep;             // Increments with every published snapshot
+};
+
+// Functions
+void scanSnapshotDescribe(const wifi_ap_record_t *rec, SnapshotNetwork *net);
+void scanSnapshotBuild(const wifi_ap_record_t *ap_records, uint16_t ap_count);
+const ScanSnapshot *scanSnapshotPublish();
+const ScanSnapshot *scanSnapshotGet();
+
+#endif // SCAN_SNAPSHOT_H
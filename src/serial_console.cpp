@@ -0,0 +1,169 @@
+/*
+ * Serial console implementation
+ *
+ * A low-priority task reads lines from the serial port and runs the matching
+ * command from a fixed table, so diagnostics can be dumped on demand without
+ * waiting for the next sweep (the scanner's loop blocks for a whole scan).
+ * Commands print with printf like the rest of the firmware's logging. The
+ * same task prints the performance histograms periodically when asked to, and
+ * takes the stack and heap telemetry samples.
+ */
+
+#include "serial_console.h"
+#include "lock_profile.h"
+#include "perf_monitor.h"
+#include "lvgl_heap.h"
+#include "latency_probe.h"
+#include "telemetry.h"
+#include "label_cache.h"
+#include "lvgl_port.h"
+#include "config.h"
+#include <Arduino.h>
+#include <string.h>
+#include <stdlib.h>
+
+struct ConsoleCommand {
+    const char *name;
+    void (*run)(const char *args);
+    const char *help;
+};
+
+static void cmdHelp(const char *args);
+
+static uint32_t perf_dump_period_ms = PERF_DUMP_PERIOD_MS;   // 0: no periodic dump
+
+// "lock" dumps the LVGL lock profile, "lock reset" clears it
+static void cmdLock(const char *args) {
+    if (strcmp(args, "reset") == 0) {
+        lockProfileReset();
+        printf("Lock profile cleared\r\n");
+    } else {
+        lockProfileDump();
+    }
+}
+
+// "perf" dumps the performance histograms; "perf reset", "perf overlay", "perf every <s>"
+static void cmdPerf(const char *args) {
+    if (strcmp(args, "reset") == 0) {
+        perfMonitorReset();
+        printf("Performance histograms cleared\r\n");
+    } else if (strcmp(args, "overlay") == 0) {
+        lvgl_port_lock(-1);
+        bool visible = !perfMonitorOverlayVisible();
+        perfMonitorSetOverlay(visible);
+        lvgl_port_unlock();
+        printf("Performance overlay %s\r\n", visible ? "shown" : "hidden");
+    } else if (strncmp(args, "every", 5) == 0) {
+        perf_dump_period_ms = (uint32_t)strtoul(args + 5, NULL, 10) * 1000;
+        printf("Periodic performance dump %s\r\n", perf_dump_period_ms ? "on" : "off");
+    } else {
+        perfMonitorDump();
+    }
+}
+
+// "heap" prints the LVGL heap's size classes and fragmentation (read without the LVGL lock)
+static void cmdHeap(const char *args) {
+    lvgl_heap_dump();
+}
+
+// "latency" prints touch-to-panel percentiles; "latency on", "latency off", "latency reset"
+static void cmdLatency(const char *args) {
+    if (strcmp(args, "on") == 0 || strcmp(args, "off") == 0) {
+        latencyProbeEnable(args[1] == 'n');
+        printf("Latency probe %s\r\n", latencyProbeEnabled() ? "on, samples cleared" : "off");
+    } else if (strcmp(args, "reset") == 0) {
+        latencyProbeReset();
+        printf("Latency samples cleared\r\n");
+    } else {
+        latencyProbeDump();
+    }
+}
+
+// "telemetry" takes a fresh stack and heap sample and prints it
+static void cmdTelemetry(const char *args) {
+    telemetrySample();
+    telemetryDump();
+}
+
+// "labels" prints the label bitmap cache counters (for tuning LABEL_CACHE_ENTRIES)
+static void cmdLabels(const char *args) {
+    LabelCacheStats stats;
+    labelCacheGetStats(&stats);
+    printf("Label cache: %lu hits, %lu misses, %lu evictions (%d entries)\r\n", (unsigned long)stats.hits,
+           (unsigned long)stats.misses, (unsigned long)stats.evictions, LABEL_CACHE_ENTRIES);
+}
+
+// "wake" prints the LVGL task wakeup and touch counters since boot
+static void cmdWake(const char *args) {
+    lvgl_wake_stats_t stats;
+    lvgl_port_get_wake_stats(&stats);
+    printf("LVGL wakeups: %lu by event, %lu by timer, %lu wasted; touch: %lu interrupts, %lu reads\r\n",
+           (unsigned long)stats.event_wakeups, (unsigned long)stats.timer_wakeups, (unsigned long)stats.wasted_wakeups,
+           (unsigned long)stats.touch_irqs, (unsigned long)stats.touch_reads);
+}
+
+static const ConsoleCommand commands[] = {
+    {"help", cmdHelp, "list commands"},
+    {"lock", cmdLock, "LVGL lock wait/hold times per call site ('lock reset' clears them)"},
+    {"heap", cmdHeap, "LVGL heap size classes, large blocks and fragmentation"},
+    {"telemetry", cmdTelemetry, "task stack high-water marks and heap free/largest/minimum, with alarms"},
+    {"wake", cmdWake, "LVGL task wakeups (by event, by timer, wasted) and touch interrupts/reads since boot"},
+    {"labels", cmdLabels, "label bitmap cache hits (per frame), misses (rasterized) and evictions"},
+    {"latency", cmdLatency, "touch to panel latency percentiles ('latency on', 'latency off', 'latency reset')"},
+    {"perf", cmdPerf, "render/flush/area/FPS/CPU/scan histograms ('perf reset', 'perf overlay', 'perf every <s>')"},
+};
+
+static void cmdHelp(const char *args) {
+    for (size_t i = 0; i < sizeof(commands) / sizeof(commands[0]); i++) {
+        printf("  %-9s %s\r\n", commands[i].name, commands[i].help);
+    }
+}
+
+// Split "name args" and run the command
+static void runLine(char *line) {
+    char *args = strchr(line, ' ');
+    if (args) {
+        *args++ = '\0';
+        while (*args == ' ') args++;
+    } else {
+        args = line + strlen(line);
+    }
+    if (line[0] == '\0') return;
+    
+    for (size_t i = 0; i < sizeof(commands) / sizeof(commands[0]); i++) {
+        if (strcmp(line, commands[i].name) == 0) {
+            commands[i].run(args);
+            return;
+        }
+    }
+    printf("Unknown command '%s' (try 'help')\r\n", line);
+}
+
+static void serialConsoleTask(void *arg) {
+    static char line[SERIAL_CONSOLE_LINE_LEN];
+    size_t len = 0;
+    uint32_t last_perf_dump_ms = millis();
+    
+    while (1) {
+        while (Serial.available() > 0) {
+            int c = Serial.read();
+            if (c == '\r' || c == '\n') {
+                line[len] = '\0';
+                runLine(line);
+                len = 0;
+            } else if (len < sizeof(line) - 1) {
+                line[len++] = (char)c;
+            }
+        }
+        if (perf_dump_period_ms > 0 && millis() - last_perf_dump_ms >= perf_dump_period_ms) {
+            perfMonitorDump();
+            last_perf_dump_ms = millis();
+        }
+        telemetryPoll();
+        vTaskDelay(pdMS_TO_TICKS(SERIAL_CONSOLE_POLL_MS));
+    }
+}
+
+void serialConsoleStart() {
+    xTaskCreate(serialConsoleTask, "console", SERIAL_CONSOLE_TASK_STACK_SIZE, NULL, SERIAL_CONSOLE_TASK_PRIORITY, NULL);
+}
@@ -0,0 +1,11 @@
+/*
+ * Serial console (diagnostic commands typed into the serial monitor)
+ */
+
+#ifndef SERIAL_CONSOLE_H
+#define SERIAL_CONSOLE_H
+
+// Functions
+void serialConsoleStart();
+
+#endif // SERIAL_CONSOLE_H
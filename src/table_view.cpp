@@ -0,0 +1,547 @@
+/*
+ * Virtualized network table implementation
+ *
+ * Only TABLE_POOL_ROWS row widgets exist, however many networks are listed.
+ * Display row r is always shown by pool slot r % TABLE_POOL_ROWS, so scrolling
+ * by one row rebinds exactly one slot. Each slot owns the text buffers its
+ * labels display (lv_label_set_text_static), and a cell is only touched when
+ * its formatted text differs from what is on screen, so a sweep that changes
+ * nothing invalidates nothing and no sweep allocates.
+ *
+ * Networks keep their model index from sweep to sweep (matched by BSSID).
+ * Every column has a cached ascending permutation of the model indices;
+ * descending order reads it backwards. A sweep only moves a few networks, so
+ * the permutations are repaired with an insertion-sort pass instead of being
+ * rebuilt, and switching the sort column is just a different lookup. Rows
+ * point into the published scan snapshot, so the cell strings are formatted
+ * once per sweep there rather than every time a slot is bound.
+ *
+ * The model is independent of the widgets: it is kept up to date while the
+ * view has not been built yet (or has been freed), so building it later shows
+ * the current list straight away.
+ */
+
+#include "table_view.h"
+#include "rssi_history.h"
+#include "ui_handlers.h"
+#include "ui_theme.h"
+#include "config.h"
+#include <Arduino.h>
+#include "esp_heap_caps.h"
+#include <string.h>
+#include <strings.h>
+#include <stdlib.h>
+
+#define TABLE_CELL_TEXT_LEN 32
+#define TABLE_HEADER_TEXT_LEN 24
+
+const lv_coord_t table_col_widths[TABLE_COLUMNS] = {220, 60, 85, 95, 150};
+static const char *table_col_titles[TABLE_COLUMNS] = {"SSID", "Ch", "RSSI", "Width", "Security"};
+
+// One network as the table lists it
+struct TableRow {
+    uint8_t bssid[6];
+    const SnapshotNetwork *net;  // Values and derived strings in the published snapshot
+    bool valid;  // Model slot in use
+    bool seen;   // Present in the sweep being merged
+};
+
+// A recycled row widget and the text its cells currently display
+struct TableSlot {
+    lv_obj_t *row;
+    lv_obj_t *cells[TABLE_COLUMNS];
+    char text[TABLE_COLUMNS][TABLE_CELL_TEXT_LEN];
+    int bound_row;  // Display row shown, -1 if unused
+};
+
+static lv_obj_t *table_container = NULL;
+static lv_obj_t *table_spacer = NULL;      // Gives the container its full scroll height
+static TableRow table_rows[TABLE_MAX_ROWS];
+static uint16_t table_row_count = 0;
+static TableSlot table_slots[TABLE_POOL_ROWS];
+
+// Cached ascending order of the model indices for every column
+static uint16_t sort_perm[TABLE_COLUMNS][TABLE_MAX_ROWS];
+static int sort_column = 2;        // RSSI...
+static bool sort_descending = true; // ...strongest first, as the scanner orders it
+static lv_obj_t *header_labels[TABLE_COLUMNS];
+static char header_text[TABLE_COLUMNS][TABLE_HEADER_TEXT_LEN];
+static uint32_t slot_binds = 0;    // Slots rebound to another row (for the benchmark)
+
+// Compare two networks by one column (ties broken by BSSID so the order is stable)
+static int compareNetworks(int col, const SnapshotNetwork *ra, const SnapshotNetwork *rb) {
+    int diff = 0;
+    switch (col) {
+        case 0: diff = strcasecmp(ra->ssid, rb->ssid); break;
+        case 1: diff = ra->channel - rb->channel; break;
+        case 2: diff = ra->rssi - rb->rssi; break;
+        case 3: diff = (ra->second != WIFI_SECOND_CHAN_NONE) - (rb->second != WIFI_SECOND_CHAN_NONE);
+                if (diff == 0) diff = (int)ra->second - (int)rb->second;
+                break;
+        case 4: diff = (int)ra->authmode - (int)rb->authmode; break;
+    }
+    return diff != 0 ? diff : memcmp(ra->bssid, rb->bssid, 6);
+}
+
+static int compareRows(int col, uint16_t a, uint16_t b) {
+    return compareNetworks(col, table_rows[a].net, table_rows[b].net);
+}
+
+// Repair a nearly sorted permutation (cost grows with how far rows moved)
+static void insertionSort(int col) {
+    uint16_t *perm = sort_perm[col];
+    for (uint16_t i = 1; i < table_row_count; i++) {
+        uint16_t idx = perm[i];
+        int j = i - 1;
+        while (j >= 0 && compareRows(col, perm[j], idx) > 0) {
+            perm[j + 1] = perm[j];
+            j--;
+        }
+        perm[j + 1] = idx;
+    }
+}
+
+// Model index shown at a display row under the current ordering
+static uint16_t modelIndex(uint16_t display_row) {
+    uint16_t pos = sort_descending ? (table_row_count - 1 - display_row) : display_row;
+    return sort_perm[sort_column][pos];
+}
+
+// Update one cell only if its text changed
+static void setCell(TableSlot *slot, int col, const char *text) {
+    if (strcmp(slot->text[col], text) == 0) return;
+    strncpy(slot->text[col], text, TABLE_CELL_TEXT_LEN - 1);
+    slot->text[col][TABLE_CELL_TEXT_LEN - 1] = '\0';
+    lv_label_set_text_static(slot->cells[col], slot->text[col]);
+}
+
+// Format a display row into a slot's cells
+static void fillSlot(TableSlot *slot, uint16_t r) {
+    const SnapshotNetwork *net = table_rows[modelIndex(r)].net;
+    char cell[TABLE_CELL_TEXT_LEN];
+    
+    // Truncate long SSIDs and mark networks pinned in the RSSI history chart
+    snprintf(cell, sizeof(cell), "%s%.25s", rssiHistoryIsPinned(net->bssid) ? "* " : "", net->ssid);
+    setCell(slot, 0, cell);
+    setCell(slot, 1, net->channel_text);
+    setCell(slot, 2, net->rssi_text);
+    setCell(slot, 3, net->width_text);
+    setCell(slot, 4, net->security_text);
+}
+
+// Bind the slots to the rows around the viewport; refill_all re-checks rows that stayed bound
+static void refreshWindow(bool refill_all) {
+    if (table_container == NULL) return;
+    
+    int first = lv_obj_get_scroll_y(table_container) / TABLE_ROW_HEIGHT - TABLE_OVERSCAN_ROWS;
+    if (first < 0) first = 0;
+    int last = first + TABLE_POOL_ROWS - 1;
+    if (last >= table_row_count) last = table_row_count - 1;
+    
+    for (int s = 0; s < TABLE_POOL_ROWS; s++) {
+        TableSlot *slot = &table_slots[s];
+        
+        // The row in [first, last] that maps onto this slot, if any
+        int r = first + ((s - first % TABLE_POOL_ROWS) + TABLE_POOL_ROWS) % TABLE_POOL_ROWS;
+        if (r > last) {
+            if (slot->bound_row >= 0) {
+                lv_obj_add_flag(slot->row, LV_OBJ_FLAG_HIDDEN);
+                slot->bound_row = -1;
+            }
+            continue;
+        }
+        
+        if (slot->bound_row != r) {
+            if (slot->bound_row < 0) lv_obj_clear_flag(slot->row, LV_OBJ_FLAG_HIDDEN);
+            lv_obj_set_y(slot->row, r * TABLE_ROW_HEIGHT);
+            slot->bound_row = r;
+            slot_binds++;
+            fillSlot(slot, r);
+        } else if (refill_all) {
+            fillSlot(slot, r);
+        }
+    }
+}
+
+// Show the sort direction on the active header label
+static void updateHeaderLabels() {
+    for (int c = 0; c < TABLE_COLUMNS; c++) {
+        if (header_labels[c] == NULL) continue;
+        if (c == sort_column) {
+            snprintf(header_text[c], sizeof(header_text[c]), "%s %s", table_col_titles[c],
+                     sort_descending ? LV_SYMBOL_DOWN : LV_SYMBOL_UP);
+        } else {
+            snprintf(header_text[c], sizeof(header_text[c]), "%s", table_col_titles[c]);
+        }
+        lv_label_set_text_static(header_labels[c], header_text[c]);
+    }
+}
+
+static void onTableScroll(lv_event_t *e) {
+    refreshWindow(false);
+}
+
+// Create the scrollable list and its row pool (call with the LVGL lock held)
+lv_obj_t *tableViewCreate(lv_obj_t *parent) {
+    table_container = lv_obj_create(parent);
+    lv_obj_add_style(table_container, &ui_style_view, LV_PART_MAIN);
+    lv_obj_add_style(table_container, &ui_style_table, LV_PART_MAIN);
+    lv_obj_set_scroll_dir(table_container, LV_DIR_VER);
+    lv_obj_set_scrollbar_mode(table_container, LV_SCROLLBAR_MODE_AUTO);
+    lv_obj_add_event_cb(table_container, onTableScroll, LV_EVENT_SCROLL, NULL);
+    
+    table_spacer = lv_obj_create(table_container);
+    lv_obj_remove_style_all(table_spacer);
+    lv_obj_set_size(table_spacer, 1, 0);
+    lv_obj_clear_flag(table_spacer, LV_OBJ_FLAG_CLICKABLE);
+    
+    lv_coord_t row_width = 0;
+    for (int c = 0; c < TABLE_COLUMNS; c++) row_width += table_col_widths[c];
+    
+    for (int s = 0; s < TABLE_POOL_ROWS; s++) {
+        TableSlot *slot = &table_slots[s];
+        slot->row = lv_obj_create(table_container);
+        lv_obj_remove_style_all(slot->row);
+        lv_obj_add_style(slot->row, &ui_style_table_row, LV_PART_MAIN);
+        lv_obj_set_size(slot->row, row_width, TABLE_ROW_HEIGHT);
+        lv_obj_clear_flag(slot->row, LV_OBJ_FLAG_SCROLLABLE);
+        lv_obj_add_flag(slot->row, LV_OBJ_FLAG_HIDDEN);
+        // Tap a row for its detail screen, long-press to pin/unpin it in the RSSI history chart
+        lv_obj_add_event_cb(slot->row, onTableRowClicked, LV_EVENT_SHORT_CLICKED, NULL);
+        lv_obj_add_event_cb(slot->row, onTableRowLongPressed, LV_EVENT_LONG_PRESSED, NULL);
+        
+        lv_coord_t x = 0;
+        for (int c = 0; c < TABLE_COLUMNS; c++) {
+            slot->text[c][0] = '\0';
+            slot->cells[c] = lv_label_create(slot->row);
+            lv_obj_add_style(slot->cells[c], &ui_style_table_cell, LV_PART_MAIN);
+            lv_label_set_long_mode(slot->cells[c], LV_LABEL_LONG_CLIP);
+            lv_label_set_text_static(slot->cells[c], slot->text[c]);
+            lv_obj_set_width(slot->cells[c], table_col_widths[c]);
+            lv_obj_align(slot->cells[c], LV_ALIGN_LEFT_MID, x, 0);
+            x += table_col_widths[c];
+        }
+        slot->bound_row = -1;
+    }
+    
+    // The model may already hold networks (the view can be built after several sweeps)
+    lv_obj_set_height(table_spacer, table_row_count * TABLE_ROW_HEIGHT);
+    refreshWindow(true);
+    
+    return table_container;
+}
+
+// Forget the widgets before the view is deleted; the model keeps merging sweeps
+void tableViewDetach() {
+    table_container = NULL;
+    table_spacer = NULL;
+    for (int s = 0; s < TABLE_POOL_ROWS; s++) {
+        table_slots[s].row = NULL;
+        table_slots[s].bound_row = -1;
+    }
+    for (int c = 0; c < TABLE_COLUMNS; c++) {
+        header_labels[c] = NULL;
+    }
+}
+
+// Register a header label; tapping it sorts by that column
+void tableViewAttachHeader(int col, lv_obj_t *label) {
+    if (col < 0 || col >= TABLE_COLUMNS) return;
+    header_labels[col] = label;
+    lv_obj_add_flag(label, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(label, onTableHeaderClicked, LV_EVENT_CLICKED, (void *)(intptr_t)col);
+    updateHeaderLabels();
+}
+
+// Merge one sweep into the model (rows point into networks) and update only the cells that changed
+static void mergeNetworks(const SnapshotNetwork *networks, uint16_t ap_count) {
+    static int16_t record_row[TABLE_MAX_ROWS];  // Model row matched by each record, -1 = new
+    if (ap_count > TABLE_MAX_ROWS) ap_count = TABLE_MAX_ROWS;
+    
+    // Match records to the networks already listed
+    for (int m = 0; m < TABLE_MAX_ROWS; m++) table_rows[m].seen = false;
+    for (uint16_t i = 0; i < ap_count; i++) {
+        record_row[i] = -1;
+        for (int m = 0; m < TABLE_MAX_ROWS; m++) {
+            if (table_rows[m].valid && !table_rows[m].seen && memcmp(table_rows[m].bssid, networks[i].bssid, 6) == 0) {
+                table_rows[m].seen = true;
+                record_row[i] = m;
+                break;
+            }
+        }
+    }
+    
+    // Drop networks that are gone from every permutation (order of the rest is kept)
+    for (int c = 0; c < TABLE_COLUMNS; c++) {
+        uint16_t kept = 0;
+        for (uint16_t p = 0; p < table_row_count; p++) {
+            if (table_rows[sort_perm[c][p]].seen) sort_perm[c][kept++] = sort_perm[c][p];
+        }
+    }
+    uint16_t count = 0;
+    for (int m = 0; m < TABLE_MAX_ROWS; m++) {
+        if (table_rows[m].valid && !table_rows[m].seen) table_rows[m].valid = false;
+        if (table_rows[m].valid) count++;
+    }
+    
+    // Point at the new values; new networks take a free model slot and join the end of each permutation
+    int free_slot = 0;
+    for (uint16_t i = 0; i < ap_count; i++) {
+        int m = record_row[i];
+        if (m < 0) {
+            while (free_slot < TABLE_MAX_ROWS && table_rows[free_slot].valid) free_slot++;
+            if (free_slot >= TABLE_MAX_ROWS) continue;
+            m = free_slot;
+            memcpy(table_rows[m].bssid, networks[i].bssid, 6);
+            table_rows[m].valid = true;
+            table_rows[m].seen = true;
+            for (int c = 0; c < TABLE_COLUMNS; c++) sort_perm[c][count] = m;
+            count++;
+        }
+        table_rows[m].net = &networks[i];
+    }
+    
+    bool count_changed = (count != table_row_count);
+    table_row_count = count;
+    
+    // Repair every cached ordering so switching columns needs no sort
+    for (int c = 0; c < TABLE_COLUMNS; c++) {
+        insertionSort(c);
+    }
+    
+    if (count_changed && table_spacer) {
+        lv_obj_set_height(table_spacer, count * TABLE_ROW_HEIGHT);
+        // A shorter list may leave the view scrolled past its end
+        lv_obj_update_layout(table_container);
+        lv_obj_readjust_scroll(table_container, LV_ANIM_OFF);
+    }
+    
+    refreshWindow(true);
+}
+
+// Merge a published snapshot into the model (call with the LVGL lock held)
+void tableViewUpdate(const ScanSnapshot *snapshot) {
+    mergeNetworks(snapshot->networks, snapshot->count);
+}
+
+// Sort by a column; the active column toggles between ascending and descending
+void tableViewSortBy(int col) {
+    if (col < 0 || col >= TABLE_COLUMNS) return;
+    if (col == sort_column) {
+        sort_descending = !sort_descending;
+    } else {
+        sort_column = col;
+        sort_descending = (col == 2);  // Strongest first is the useful default for RSSI
+    }
+    
+    updateHeaderLabels();
+    if (table_container) lv_obj_scroll_to_y(table_container, 0, LV_ANIM_OFF);
+    refreshWindow(true);
+}
+
+// Re-check the visible cells (e.g. after a pin changed)
+void tableViewRefresh() {
+    refreshWindow(true);
+}
+
+// Display row shown by a pooled row widget, or -1
+int tableViewRowFromObj(lv_obj_t *row_obj) {
+    for (int s = 0; s < TABLE_POOL_ROWS; s++) {
+        if (table_slots[s].row == row_obj) return table_slots[s].bound_row;
+    }
+    return -1;
+}
+
+// Look up the network shown in a display row
+bool getTableRowNetwork(uint16_t row, uint8_t *bssid, char *ssid) {
+    if (row >= table_row_count) return false;
+    const TableRow *r = &table_rows[modelIndex(row)];
+    memcpy(bssid, r->bssid, 6);
+    strcpy(ssid, r->net->ssid);
+    return true;
+}
+
+// Synthetic network for the benchmark: id gives the BSSID and SSID, seed the rest
+static void makeTestNetwork(uint16_t id, uint32_t *seed, SnapshotNetwork *net) {
+    wifi_ap_record_t rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.bssid[4] = id >> 8;
+    rec.bssid[5] = id & 0xFF;
+    snprintf((char *)rec.ssid, sizeof(rec.ssid), "Network %03u", (unsigned)((id * 7919u) % 1000));
+    *seed = *seed * 1103515245u + 12345u;
+    rec.primary = 1 + (*seed >> 16) % 13;
+    rec.rssi = -30 - (int)((*seed >> 8) % 65);
+    rec.second = (wifi_second_chan_t)((*seed >> 4) % 3);
+    rec.authmode = (wifi_auth_mode_t)((*seed >> 20) % WIFI_AUTH_MAX);
+    scanSnapshotDescribe(&rec, net);
+}
+
+// Merge a sweep of rows synthetic networks into the built view, move a few of
+// them in a second sweep, then scroll through the whole list one row at a
+// time. False if a one-row scroll step rebinds more than one slot or takes
+// longer than TABLE_SCROLL_BUDGET_US. The published snapshot is merged back in
+// afterwards (call with the LVGL lock held, table view built and shown).
+bool tableViewBenchmark(uint16_t rows) {
+    if (rows > TABLE_MAX_ROWS) {
+        printf("Table benchmark: %u rows needs TABLE_MAX_ROWS >= %u (it is %d)\r\n", rows, rows, TABLE_MAX_ROWS);
+        return false;
+    }
+    if (table_container == NULL) {
+        printf("Table benchmark: the table view is not built\r\n");
+        return false;
+    }
+    SnapshotNetwork *networks = (SnapshotNetwork *)heap_caps_calloc(rows, sizeof(SnapshotNetwork), MALLOC_CAP_SPIRAM);
+    if (networks == NULL) {
+        printf("Table benchmark: failed to allocate %u networks\r\n", rows);
+        return false;
+    }
+    int saved_column = sort_column;
+    bool saved_descending = sort_descending;
+    
+    uint32_t seed = 12345;
+    for (uint16_t i = 0; i < rows; i++) {
+        makeTestNetwork(i, &seed, &networks[i]);
+    }
+    lv_obj_scroll_to_y(table_container, 0, LV_ANIM_OFF);
+    uint32_t start = micros();
+    mergeNetworks(networks, rows);
+    uint32_t first_us = micros() - start;
+    
+    // A later sweep: one network in ten changes RSSI by a few dB
+    for (uint16_t i = 0; i < rows; i += 10) {
+        seed = seed * 1103515245u + 12345u;
+        networks[i].rssi += (int8_t)((seed >> 16) % 7) - 3;
+        snprintf(networks[i].rssi_text, sizeof(networks[i].rssi_text), "%d", networks[i].rssi);
+    }
+    start = micros();
+    mergeNetworks(networks, rows);
+    uint32_t sweep_us = micros() - start;
+    
+    // Scroll to the end one row at a time
+    uint32_t steps = 0;
+    uint32_t total_us = 0;
+    uint32_t max_us = 0;
+    uint32_t max_binds = 0;
+    for (uint16_t r = 1; r < table_row_count; r++) {
+        uint32_t binds = slot_binds;
+        start = micros();
+        lv_obj_scroll_to_y(table_container, r * TABLE_ROW_HEIGHT, LV_ANIM_OFF);
+        uint32_t step_us = micros() - start;
+        total_us += step_us;
+        if (step_us > max_us) max_us = step_us;
+        if (slot_binds - binds > max_binds) max_binds = slot_binds - binds;
+        steps++;
+    }
+    
+    start = micros();
+    tableViewSortBy(0);
+    uint32_t sort_us = micros() - start;
+    
+    bool ok = table_row_count == rows && max_binds <= 1 && max_us <= TABLE_SCROLL_BUDGET_US;
+    printf("Table benchmark: %u rows, first sweep %lu us, next sweep %lu us, sort switch %lu us\r\n", table_row_count,
+           (unsigned long)first_us, (unsigned long)sweep_us, (unsigned long)sort_us);
+    printf("  %lu one-row scroll steps: avg %lu us, max %lu us (budget %d), at most %lu slot(s) rebound: %s\r\n",
+           (unsigned long)steps, (unsigned long)(steps ? total_us / steps : 0), (unsigned long)max_us,
+           TABLE_SCROLL_BUDGET_US, (unsigned long)max_binds, ok ? "ok" : "FAIL");
+    
+    // Back to the real list
+    sort_column = saved_column;
+    sort_descending = saved_descending;
+    updateHeaderLabels();
+    lv_obj_scroll_to_y(table_container, 0, LV_ANIM_OFF);
+    const ScanSnapshot *snapshot = scanSnapshotGet();
+    mergeNetworks(snapshot->networks, snapshot->count);
+    heap_caps_free(networks);
+    return ok;
+}
+
+// Reference order for the sort test: a full sort of the sweep
+static int reference_column;
+static int compareReference(const void *a, const void *b) {
+    return compareNetworks(reference_column, *(const SnapshotNetwork *const *)a, *(const SnapshotNetwork *const *)b);
+}
+
+// Merge randomized sweeps (networks come, go, move and get renamed) and check
+// after each one that every column's cached permutation, read in both
+// directions, lists each network once in the same order as a full sort.
+// The published snapshot is merged back in afterwards (LVGL lock held).
+bool tableViewSortTest(uint16_t sweeps) {
+    const uint16_t max_count = SNAPSHOT_MAX_NETWORKS < TABLE_MAX_ROWS ? SNAPSHOT_MAX_NETWORKS : TABLE_MAX_ROWS;
+    const uint16_t id_pool = 3 * max_count;     // Networks that can appear, so some come back
+    SnapshotNetwork *buffers = (SnapshotNetwork *)heap_caps_calloc(2 * max_count, sizeof(SnapshotNetwork), MALLOC_CAP_SPIRAM);
+    const SnapshotNetwork **expected = (const SnapshotNetwork **)heap_caps_calloc(max_count, sizeof(SnapshotNetwork *), MALLOC_CAP_SPIRAM);
+    uint16_t *ids = (uint16_t *)heap_caps_calloc(id_pool, sizeof(uint16_t), MALLOC_CAP_SPIRAM);
+    if (buffers == NULL || expected == NULL || ids == NULL) {
+        printf("Table sort test: allocation failed\r\n");
+        heap_caps_free(buffers);
+        heap_caps_free(expected);
+        heap_caps_free(ids);
+        return false;
+    }
+    int saved_column = sort_column;
+    bool saved_descending = sort_descending;
+    for (uint16_t i = 0; i < id_pool; i++) ids[i] = i;
+    
+    uint32_t seed = 2024;
+    uint32_t checks = 0;
+    const char *error = NULL;
+    uint16_t sweep = 0;
+    for (; sweep < sweeps; sweep++) {
+        // Rows keep pointing into the previous sweep's buffer until this merge, so alternate
+        SnapshotNetwork *networks = &buffers[(sweep % 2) * max_count];
+        seed = seed * 1103515245u + 12345u;
+        uint16_t count = (seed >> 16) % (max_count + 1);
+        for (uint16_t i = 0; i < count; i++) {
+            seed = seed * 1103515245u + 12345u;
+            uint16_t j = i + (seed >> 16) % (id_pool - i);
+            uint16_t id = ids[j];
+            ids[j] = ids[i];
+            ids[i] = id;
+            makeTestNetwork(id, &seed, &networks[i]);
+        }
+        mergeNetworks(networks, count);
+        
+        if (table_row_count != count) {
+            error = "row count differs from the sweep";
+            break;
+        }
+        for (int col = 0; col < TABLE_COLUMNS && error == NULL; col++) {
+            for (uint16_t i = 0; i < count; i++) expected[i] = &networks[i];
+            reference_column = col;
+            qsort(expected, count, sizeof(expected[0]), compareReference);
+            sort_column = col;
+            for (int d = 0; d < 2 && error == NULL; d++) {
+                sort_descending = (d == 1);
+                for (uint16_t r = 0; r < count; r++) {
+                    const SnapshotNetwork *want = expected[sort_descending ? count - 1 - r : r];
+                    if (table_rows[modelIndex(r)].net != want) {
+                        error = "order differs from a full sort";
+                        break;
+                    }
+                }
+                checks++;
+            }
+        }
+        if (error != NULL) break;
+    }
+    
+    bool ok = (error == NULL);
+    if (ok) {
+        printf("Table sort test: %u random sweeps, %lu column/direction orders match a full sort: ok\r\n", sweeps,
+               (unsigned long)checks);
+    } else {
+        printf("Table sort test: sweep %u, column %d %s: %s: FAIL\r\n", sweep + 1, sort_column,
+               sort_descending ? "descending" : "ascending", error);
+    }
+    
+    // Back to the real list
+    sort_column = saved_column;
+    sort_descending = saved_descending;
+    updateHeaderLabels();
+    const ScanSnapshot *snapshot = scanSnapshotGet();
+    mergeNetworks(snapshot->networks, snapshot->count);
+    heap_caps_free(buffers);
+    heap_caps_free(expected);
+    heap_caps_free(ids);
+    return ok;
+}
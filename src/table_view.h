@@ -0,0 +1,28 @@
+/*
+ * Virtualized network table
+ */
+
+#ifndef TABLE_VIEW_H
+#define TABLE_VIEW_H
+
+#include <lvgl.h>
+#include "scan_snapshot.h"
+
+#define TABLE_COLUMNS 5
+
+// Column widths shared with the fixed header row
+extern const lv_coord_t table_col_widths[TABLE_COLUMNS];
+
+// Functions
+lv_obj_t *tableViewCreate(lv_obj_t *parent);
+void tableViewDetach();
+void tableViewAttachHeader(int col, lv_obj_t *label);
+void tableViewUpdate(const ScanSnapshot *snapshot);
+void tableViewSortBy(int col);
+void tableViewRefresh();
+int tableViewRowFromObj(lv_obj_t *row_obj);
+bool getTableRowNetwork(uint16_t row, uint8_t *bssid, char *ssid);
+bool tableViewBenchmark(uint16_t rows);
+bool tableViewSortTest(uint16_t sweeps);
+
+#endif // TABLE_VIEW_H
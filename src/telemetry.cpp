@@ -0,0 +1,187 @@
+/*
+ * Stack and heap telemetry implementation
+ *
+ * The LVGL task runs on a 4 KB stack and the scan path keeps its large
+ * buffers static to stay off the stack, but nothing showed how close any task
+ * actually gets. Every TELEMETRY_PERIOD_MS the serial console task (which
+ * already wakes every SERIAL_CONSOLE_POLL_MS) reads every task's stack
+ * high-water mark through uxTaskGetSystemState() and the free, largest-block
+ * and minimum-ever sizes of the internal and PSRAM heaps. FreeRTOS computes
+ * each high-water mark by scanning the task's stack with the scheduler
+ * suspended, which is why this runs every few seconds rather than per frame.
+ *
+ * Like the scan snapshot, the next sample is built in a back buffer and the
+ * two are swapped under the LVGL lock, so the diagnostics view never reads a
+ * half-built sample. A task or heap crossing its threshold is logged once
+ * when it enters alarm and once when it leaves it.
+ */
+
+#include "telemetry.h"
+#include "lvgl_port.h"
+#include "config.h"
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_heap_caps.h>
+#include <string.h>
+
+// Stack sizes of the tasks this firmware creates (FreeRTOS only reports what is left)
+struct KnownStack {
+    const char *name;
+    uint32_t size;
+};
+
+static const KnownStack known_stacks[] = {
+    {"lvgl", LVGL_TASK_STACK_SIZE},
+    {"lvgl_flush", LVGL_FLUSH_TASK_STACK_SIZE},
+    {"console", SERIAL_CONSOLE_TASK_STACK_SIZE},
+#ifdef CONFIG_ARDUINO_LOOP_STACK_SIZE
+    {"loopTask", CONFIG_ARDUINO_LOOP_STACK_SIZE},   // Scanner (setup() and loop())
+#endif
+};
+
+static TelemetrySnapshot snapshots[2];
+static TelemetrySnapshot *front = &snapshots[0];
+static TelemetrySnapshot *back = &snapshots[1];
+static TaskStatus_t task_status[TELEMETRY_MAX_TASKS];
+static uint32_t last_sample_ms = 0;
+
+static uint32_t knownStackSize(const char *name) {
+    for (size_t i = 0; i < sizeof(known_stacks) / sizeof(known_stacks[0]); i++) {
+        if (strcmp(known_stacks[i].name, name) == 0) return known_stacks[i].size;
+    }
+    return 0;
+}
+
+// Whether the same task was in alarm in the previous sample
+static bool wasInAlarm(const char *name) {
+    for (uint8_t i = 0; i < front->task_count; i++) {
+        if (strcmp(front->tasks[i].name, name) == 0) return front->tasks[i].alarm;
+    }
+    return false;
+}
+
+static void sampleTasks(TelemetrySnapshot *snap) {
+    snap->task_count = 0;
+    UBaseType_t count = uxTaskGetNumberOfTasks();
+    snap->task_total = (uint8_t)(count < 255 ? count : 255);
+    if (count > TELEMETRY_MAX_TASKS) return;    // uxTaskGetSystemState() fills nothing unless every task fits
+    count = uxTaskGetSystemState(task_status, TELEMETRY_MAX_TASKS, NULL);
+    
+    for (UBaseType_t i = 0; i < count; i++) {
+        TelemetryTask *task = &snap->tasks[snap->task_count++];
+        strncpy(task->name, task_status[i].pcTaskName, sizeof(task->name) - 1);
+        task->name[sizeof(task->name) - 1] = '\0';
+        task->priority = (uint8_t)task_status[i].uxCurrentPriority;
+        task->stack_size = knownStackSize(task->name);
+        task->stack_free_min = task_status[i].usStackHighWaterMark;     // Bytes on ESP-IDF
+        task->alarm = task->stack_free_min < TELEMETRY_STACK_ALARM_BYTES;
+        
+        if (task->alarm != wasInAlarm(task->name)) {
+            printf("Telemetry: %s task stack %s (%lu bytes never used, alarm below %d)\r\n", task->name,
+                   task->alarm ? "ALARM" : "recovered", (unsigned long)task->stack_free_min, TELEMETRY_STACK_ALARM_BYTES);
+        }
+    }
+    
+    // Tightest stack first (insertion sort, a couple of dozen tasks)
+    for (uint8_t i = 1; i < snap->task_count; i++) {
+        TelemetryTask task = snap->tasks[i];
+        int j = i - 1;
+        while (j >= 0 && snap->tasks[j].stack_free_min > task.stack_free_min) {
+            snap->tasks[j + 1] = snap->tasks[j];
+            j--;
+        }
+        snap->tasks[j + 1] = task;
+    }
+}
+
+static void sampleHeap(TelemetryHeap *heap, uint32_t caps, uint32_t free_alarm, uint32_t block_alarm,
+                       bool was_alarm, const char *name) {
+    heap->total = heap_caps_get_total_size(caps);
+    heap->free = heap_caps_get_free_size(caps);
+    heap->largest_block = heap_caps_get_largest_free_block(caps);
+    heap->min_free = heap_caps_get_minimum_free_size(caps);
+    heap->alarm = heap->total > 0 && (heap->free < free_alarm || heap->largest_block < block_alarm);
+    
+    if (heap->alarm != was_alarm) {
+        printf("Telemetry: %s heap %s (%lu KB free, largest block %lu KB)\r\n", name,
+               heap->alarm ? "ALARM" : "recovered", (unsigned long)(heap->free / 1024),
+               (unsigned long)(heap->largest_block / 1024));
+    }
+}
+
+// Console task: take a sample every TELEMETRY_PERIOD_MS
+void telemetryPoll() {
+#if TELEMETRY
+    if (front->sample != 0 && millis() - last_sample_ms < TELEMETRY_PERIOD_MS) return;
+    telemetrySample();
+#endif
+}
+
+// Sample every task and both heaps now and publish the result (console task only, LVGL lock not held)
+void telemetrySample() {
+    last_sample_ms = millis();
+    sampleTasks(back);
+    sampleHeap(&back->internal, MALLOC_CAP_INTERNAL, TELEMETRY_INTERNAL_FREE_ALARM, TELEMETRY_INTERNAL_BLOCK_ALARM,
+               front->internal.alarm, "internal");
+    sampleHeap(&back->psram, MALLOC_CAP_SPIRAM, TELEMETRY_PSRAM_FREE_ALARM, 0, front->psram.alarm, "PSRAM");
+    
+    back->alarms = (back->internal.alarm ? 1 : 0) + (back->psram.alarm ? 1 : 0);
+    for (uint8_t i = 0; i < back->task_count; i++) {
+        if (back->tasks[i].alarm) back->alarms++;
+    }
+    back->sample = front->sample + 1;
+    back->time_ms = last_sample_ms;
+    
+    lvgl_port_lock(-1);
+    TelemetrySnapshot *built = back;
+    back = front;
+    front = built;
+    lvgl_port_unlock();
+}
+
+// Latest published sample (LVGL lock held, or from the console task)
+const TelemetrySnapshot *telemetryGet() {
+    return front;
+}
+
+static void dumpHeap(const char *name, const TelemetryHeap *heap) {
+    if (heap->total == 0) {
+        printf("  %-9s not present\r\n", name);
+        return;
+    }
+    printf("  %-9s %8lu %8lu %8lu %8lu %s\r\n", name, (unsigned long)heap->total, (unsigned long)heap->free,
+           (unsigned long)heap->largest_block, (unsigned long)heap->min_free, heap->alarm ? "ALARM" : "");
+}
+
+// Print the latest sample (console task)
+void telemetryDump() {
+    const TelemetrySnapshot *snap = front;
+    if (snap->sample == 0) {
+        printf("No telemetry sample yet\r\n");
+        return;
+    }
+    printf("---- Telemetry (sample %lu, %lu ms ago, %lu in alarm) ----\r\n", (unsigned long)snap->sample,
+           (unsigned long)(millis() - snap->time_ms), (unsigned long)snap->alarms);
+    printf("  %-9s %8s %8s %8s %8s  (bytes)\r\n", "heap", "total", "free", "largest", "min free");
+    dumpHeap("internal", &snap->internal);
+    dumpHeap("PSRAM", &snap->psram);
+    
+    printf("  %-16s %4s %8s %8s %5s  (bytes, tightest first)\r\n", "task", "prio", "stack", "min free", "peak");
+    for (uint8_t i = 0; i < snap->task_count; i++) {
+        const TelemetryTask *task = &snap->tasks[i];
+        char size[12] = "-";
+        char peak[8] = "-";
+        if (task->stack_size > task->stack_free_min) {
+            snprintf(size, sizeof(size), "%lu", (unsigned long)task->stack_size);
+            snprintf(peak, sizeof(peak), "%lu%%",
+                     (unsigned long)((task->stack_size - task->stack_free_min) * 100 / task->stack_size));
+        }
+        printf("  %-16s %4u %8s %8lu %5s %s\r\n", task->name, task->priority, size, (unsigned long)task->stack_free_min,
+               peak, task->alarm ? "ALARM" : "");
+    }
+    if (snap->task_total > TELEMETRY_MAX_TASKS) {
+        printf("  %u tasks running, stacks not sampled (raise TELEMETRY_MAX_TASKS in config.h)\r\n", snap->task_total);
+    }
+    printf("------------------------------------------------\r\n");
+}
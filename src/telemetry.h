@@ -0,0 +1,47 @@
+/*
+ * Stack and heap telemetry (task stack high-water marks, heap_caps watermarks, alarms)
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include "config.h"
+
+// One task's stack
+struct TelemetryTask {
+    char name[16];
+    uint8_t priority;
+    uint32_t stack_size;        // Bytes, 0 if not one of ours (FreeRTOS does not report it)
+    uint32_t stack_free_min;    // High-water mark: least free stack since the task started, in bytes
+    bool alarm;                 // stack_free_min below TELEMETRY_STACK_ALARM_BYTES
+};
+
+// One heap_caps region
+struct TelemetryHeap {
+    uint32_t total;             // 0 if the region does not exist (no PSRAM)
+    uint32_t free;
+    uint32_t largest_block;
+    uint32_t min_free;          // Least free since boot
+    bool alarm;                 // Free or largest block below the region's thresholds
+};
+
+// One sample, tightest stack first
+struct TelemetrySnapshot {
+    TelemetryTask tasks[TELEMETRY_MAX_TASKS];
+    uint8_t task_count;
+    uint8_t task_total;         // Tasks running (none are listed when more than TELEMETRY_MAX_TASKS)
+    TelemetryHeap internal;
+    TelemetryHeap psram;
+    uint32_t alarms;            // Tasks and heaps in alarm
+    uint32_t sample;            // Increments with every published sample (0 = none yet)
+    uint32_t time_ms;
+};
+
+// Functions
+void telemetryPoll();
+void telemetrySample();
+const TelemetrySnapshot *telemetryGet();
+void telemetryDump();
+
+#endif // TELEMETRY_H
@@ -0,0 +1,376 @@
+/*
+ * Touch coordinate filtering implementation
+ *
+ * Runs on the touch driver's process_coordinates hook, so every consumer
+ * (LVGL, the graph gesture recognizer) sees the same cleaned-up points. A new
+ * press has to be reported on TOUCH_DEBOUNCE_READS consecutive reads before
+ * it is passed on, which drops single-read glitches. Each point then goes
+ * through a one-euro filter: a low-pass whose cutoff rises with the finger's
+ * speed, so a resting finger is held steady while a fast swipe is followed
+ * with little lag. The filter's smoothed velocity of each point is kept and
+ * handed out by touchFilterVelocity(), which the graph uses to throw a
+ * two-finger pan when the fingers lift. Everything is integer arithmetic (positions in 1/16 px,
+ * filter gains in Q16) with no locks or allocation, so a step takes well
+ * under a microsecond and is safe from an ISR as well as a task.
+ *
+ * The driver only calls the hook when the controller reports points, so the
+ * touch read calls touchFilterRelease() whenever it ends up with none: either
+ * the finger is up, or the hook itself withheld a press still being debounced.
+ */
+
+#include "touch_filter.h"
+#include "config.h"
+#include <Arduino.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define POS_SHIFT       4           // Positions and velocities carry 4 fractional bits
+#define ALPHA_ONE       65536       // 1.0 in Q16
+#define TWO_PI_Q16      411775LL    // 2 * pi in Q16
+#define MAX_DT_MS       1000        // Longer gaps are treated as one second
+#define TOUCH_TEST_MAX_DRAG_LAG_PX  4   // Mean lag touchFilterTest() accepts on its traces
+#define TOUCH_TEST_MAX_FLICK_LAG_PX 5
+#define TOUCH_TEST_MAX_VEL_ERROR_PX_S 100 // Velocity error touchFilterTest() accepts at the end of a trace
+
+static const TouchFilterParams default_params = {
+    TOUCH_FILTER_MIN_CUTOFF_MHZ, TOUCH_FILTER_BETA, TOUCH_FILTER_D_CUTOFF_MHZ
+};
+
+// Hook state: one filter per reported point, matched by index
+static TouchFilterPoint filter_points[TOUCH_MAX_POINTS];
+static uint8_t filter_count = 0;    // Points passed on by the last read
+static uint8_t press_reads = 0;     // Reads a new press has been seen without being passed on
+static bool press_withheld = false; // The last hook call withheld a press that is still being debounced
+
+// Smoothing factor of a first-order low-pass at this cutoff and sample interval (Q16)
+static inline int32_t lowPassAlpha(uint32_t cutoff_mhz, uint32_t dt_ms) {
+    // alpha = k / (k + 1) with k = 2 * pi * cutoff * dt
+    int64_t k = TWO_PI_Q16 * cutoff_mhz * dt_ms / 1000000;
+    return (int32_t)((k << 16) / (k + ALPHA_ONE));
+}
+
+static inline int32_t blend(int32_t from, int32_t to, int32_t alpha) {
+    return from + (int32_t)(((int64_t)(to - from) * alpha + (ALPHA_ONE / 2)) >> 16);
+}
+
+static inline uint16_t toPixels(int32_t v) {
+    v = (v + (1 << (POS_SHIFT - 1))) >> POS_SHIFT;
+    return v < 0 ? 0 : (v > 0xFFFF ? 0xFFFF : (uint16_t)v);
+}
+
+void touchFilterReset(TouchFilterPoint *f) {
+    memset(f, 0, sizeof(*f));
+}
+
+// Filter one sample in place (the first sample after a reset passes through and seeds the filter)
+void touchFilterStep(TouchFilterPoint *f, const TouchFilterParams *params, uint16_t *x, uint16_t *y, uint32_t now_ms) {
+    int32_t raw_x = (int32_t)*x << POS_SHIFT;
+    int32_t raw_y = (int32_t)*y << POS_SHIFT;
+    if (!f->valid) {
+        f->x = raw_x;
+        f->y = raw_y;
+        f->vx = 0;
+        f->vy = 0;
+        f->raw_x = raw_x;
+        f->raw_y = raw_y;
+        f->t_ms = now_ms;
+        f->valid = true;
+        return;
+    }
+    
+    uint32_t dt = now_ms - f->t_ms;
+    if (dt == 0) dt = 1;
+    if (dt > MAX_DT_MS) dt = MAX_DT_MS;
+    f->t_ms = now_ms;
+    
+    // Velocity between raw samples, smoothed at a fixed cutoff
+    int32_t alpha_d = lowPassAlpha(params->d_cutoff_mhz, dt);
+    f->vx = blend(f->vx, (raw_x - f->raw_x) * 1000 / (int32_t)dt, alpha_d);
+    f->vy = blend(f->vy, (raw_y - f->raw_y) * 1000 / (int32_t)dt, alpha_d);
+    f->raw_x = raw_x;
+    f->raw_y = raw_y;
+    
+    // Speed (max + 3/8 min approximates the vector length) raises the position cutoff
+    uint32_t ax = f->vx < 0 ? -f->vx : f->vx;
+    uint32_t ay = f->vy < 0 ? -f->vy : f->vy;
+    uint32_t speed = (ax > ay) ? ax + ay * 3 / 8 : ay + ax * 3 / 8;
+    uint32_t cutoff = params->min_cutoff_mhz + params->beta * (speed >> POS_SHIFT);
+    
+    int32_t alpha = lowPassAlpha(cutoff, dt);
+    f->x = blend(f->x, raw_x, alpha);
+    f->y = blend(f->y, raw_y, alpha);
+    *x = toPixels(f->x);
+    *y = toPixels(f->y);
+}
+
+// process_coordinates hook: debounce new presses and filter every point
+void touchFilterProcess(uint16_t *x, uint16_t *y, uint8_t *point_num, uint32_t now_ms) {
+    uint8_t count = *point_num;
+    if (count > TOUCH_MAX_POINTS) count = TOUCH_MAX_POINTS;
+    
+    if (count == 0) {
+        press_withheld = false;
+        touchFilterRelease();
+        return;
+    }
+    
+    // A new press is passed on once it has been seen on enough consecutive reads
+    if (filter_count == 0 && ++press_reads < TOUCH_DEBOUNCE_READS) {
+        *point_num = 0;
+        press_withheld = true;
+        return;
+    }
+    press_reads = 0;
+    
+    // The controller may renumber points when one is added or lifted, so start the filters over
+    if (count != filter_count) {
+        for (uint8_t i = 0; i < TOUCH_MAX_POINTS; i++) {
+            touchFilterReset(&filter_points[i]);
+        }
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        touchFilterStep(&filter_points[i], &default_params, &x[i], &y[i], now_ms);
+    }
+    filter_count = count;
+}
+
+// A touch read reported no points: end the press and restart the debounce, unless
+// the hook withheld this read's points itself (call after every read that yields none)
+void touchFilterRelease() {
+    if (press_withheld) {
+        press_withheld = false;
+        return;
+    }
+    filter_count = 0;
+    press_reads = 0;
+    for (uint8_t i = 0; i < TOUCH_MAX_POINTS; i++) {
+        touchFilterReset(&filter_points[i]);
+    }
+}
+
+// Filtered velocity of a point passed on by the last read, in px/s (false if there is none)
+bool touchFilterVelocity(uint8_t index, int16_t *vx, int16_t *vy) {
+    if (index >= filter_count) {
+        *vx = 0;
+        *vy = 0;
+        return false;
+    }
+    *vx = (int16_t)(filter_points[index].vx >> POS_SHIFT);
+    *vy = (int16_t)(filter_points[index].vy >> POS_SHIFT);
+    return true;
+}
+
+// Benchmark traces: GT911-like reports every 10 ms with +-2 px of noise
+#define TRACE_SAMPLES       100
+#define TRACE_PERIOD_MS     10
+
+enum TraceShape { TRACE_HOLD, TRACE_DRAG, TRACE_FLICK };
+
+// True position of the finger (1/16 px) and its speed (px/s) at sample i
+static int32_t tracePosition(TraceShape shape, int i, int32_t *speed) {
+    int32_t t_ms = i * TRACE_PERIOD_MS;
+    switch (shape) {
+        case TRACE_DRAG:    // Steady 300 px/s
+            *speed = 300;
+            return (100 << POS_SHIFT) + 300 * t_ms * 16 / 1000;
+        case TRACE_FLICK:   // 0 to 2000 px/s over 200 ms, then constant
+            if (t_ms < 200) {
+                *speed = 10 * t_ms;
+                return (100 << POS_SHIFT) + 5 * t_ms * t_ms * 16 / 1000;
+            }
+            *speed = 2000;
+            return (100 << POS_SHIFT) + (200 * 16) + 2000 * (t_ms - 200) * 16 / 1000;
+        default:
+            *speed = 0;
+            return 400 << POS_SHIFT;
+    }
+}
+
+struct TraceResult {
+    uint32_t error_sum;     // Sum of |filtered - true| over the trace (1/16 px)
+    int32_t vel_error;      // Velocity estimate minus the true speed at the end (px/s)
+};
+
+// Replay one trace through the filter (params NULL = raw samples)
+static TraceResult replayTrace(TraceShape shape, const TouchFilterParams *params) {
+    TraceResult result = {0, 0};
+    TouchFilterPoint f;
+    touchFilterReset(&f);
+    uint32_t seed = 12345;
+    int32_t speed = 0;
+    for (int i = 0; i < TRACE_SAMPLES; i++) {
+        int32_t truth = tracePosition(shape, i, &speed);
+        seed = seed * 1103515245u + 12345u;
+        int32_t noise = (int32_t)((seed >> 16) % 5) - 2;
+        uint16_t x = toPixels(truth) + noise;
+        uint16_t y = 240;
+        if (params != NULL) touchFilterStep(&f, params, &x, &y, i * TRACE_PERIOD_MS);
+        int32_t error = ((int32_t)x << POS_SHIFT) - truth;
+        result.error_sum += error < 0 ? -error : error;
+    }
+    result.vel_error = (params != NULL) ? (f.vx >> POS_SHIFT) - speed : 0;
+    return result;
+}
+
+// Replay synthetic hold, drag and flick traces and print jitter against lag for a few tunings
+void touchFilterBenchmark() {
+    static const struct {
+        const char *name;
+        TouchFilterParams params;
+    } tunings[] = {
+        {"default", {TOUCH_FILTER_MIN_CUTOFF_MHZ, TOUCH_FILTER_BETA, TOUCH_FILTER_D_CUTOFF_MHZ}},
+        {"smooth", {TOUCH_FILTER_MIN_CUTOFF_MHZ / 2, TOUCH_FILTER_BETA / 2, TOUCH_FILTER_D_CUTOFF_MHZ}},
+        {"responsive", {TOUCH_FILTER_MIN_CUTOFF_MHZ * 2, TOUCH_FILTER_BETA * 2, TOUCH_FILTER_D_CUTOFF_MHZ}},
+    };
+    
+    printf("Touch filter: mean error in px (hold = jitter, drag/flick = lag), velocity error in px/s\r\n");
+    printf("  %-10s %8s %8s %8s %10s %8s\r\n", "tuning", "hold", "drag", "flick", "flick vel", "ns/step");
+    for (int t = -1; t < (int)(sizeof(tunings) / sizeof(tunings[0])); t++) {
+        const TouchFilterParams *params = (t < 0) ? NULL : &tunings[t].params;
+        TraceResult hold = replayTrace(TRACE_HOLD, params);
+        TraceResult drag = replayTrace(TRACE_DRAG, params);
+        TraceResult flick = replayTrace(TRACE_FLICK, params);
+        
+        // Cost per replayed sample (filter step plus trace generation)
+        uint32_t step_ns = 0;
+        if (params != NULL) {
+            const int replays = 100;
+            uint32_t start = micros();
+            for (int r = 0; r < replays; r++) {
+                replayTrace(TRACE_FLICK, params);
+            }
+            step_ns = (micros() - start) * 1000 / (replays * TRACE_SAMPLES);
+        }
+        
+        // Mean error in hundredths of a pixel
+        uint32_t scale = TRACE_SAMPLES << POS_SHIFT;
+        printf("  %-10s %5lu.%02lu %5lu.%02lu %5lu.%02lu %10ld %8lu\r\n", (t < 0) ? "raw" : tunings[t].name,
+               (unsigned long)(hold.error_sum / scale), (unsigned long)(hold.error_sum * 100 / scale % 100),
+               (unsigned long)(drag.error_sum / scale), (unsigned long)(drag.error_sum * 100 / scale % 100),
+               (unsigned long)(flick.error_sum / scale), (unsigned long)(flick.error_sum * 100 / scale % 100),
+               (long)flick.vel_error, (unsigned long)step_ns);
+    }
+}
+
+// One touch read the way lvgl_port_tp_read() does it: the driver only calls the hook when
+// the controller reports points, and the read releases the filter when it ends up with none
+static uint8_t testRead(bool pressed, uint16_t *x, uint16_t *y, uint32_t now_ms) {
+    uint8_t count = pressed ? 1 : 0;
+    if (count > 0) touchFilterProcess(x, y, &count, now_ms);
+    if (count == 0) touchFilterRelease();
+    return count;
+}
+
+// Mean |reported - true| in 1/100 px over a trace replayed through the hook, and the
+// velocity touchFilterVelocity() reports against the true speed at its end
+static uint32_t testTrace(TraceShape shape, uint32_t *raw_error, int32_t *speed_end, int16_t *velocity) {
+    uint32_t seed = 4242;
+    uint32_t error_sum = 0;
+    uint32_t raw_sum = 0;
+    uint32_t samples = 0;
+    int32_t speed;
+    for (int i = 0; i < TRACE_SAMPLES; i++) {
+        int32_t truth = tracePosition(shape, i, &speed);
+        seed = seed * 1103515245u + 12345u;
+        int32_t noise = (int32_t)((seed >> 16) % 5) - 2;
+        uint16_t x = toPixels(truth) + noise;
+        uint16_t y = 240;
+        int32_t raw = ((int32_t)x << POS_SHIFT) - truth;
+        if (testRead(true, &x, &y, i * TRACE_PERIOD_MS) == 0) continue;
+        int32_t error = ((int32_t)x << POS_SHIFT) - truth;
+        error_sum += error < 0 ? -error : error;
+        raw_sum += raw < 0 ? -raw : raw;
+        samples++;
+    }
+    int16_t vy;
+    *speed_end = speed;
+    if (!touchFilterVelocity(0, velocity, &vy)) *velocity = INT16_MIN;
+    uint16_t x = 0, y = 0;
+    testRead(false, &x, &y, TRACE_SAMPLES * TRACE_PERIOD_MS);
+    *raw_error = samples ? raw_sum * 100 / (samples << POS_SHIFT) : 0;
+    return samples ? error_sum * 100 / (samples << POS_SHIFT) : UINT32_MAX;
+}
+
+static bool testCheck(bool ok, const char *what) {
+    printf("  %-58s %s\r\n", what, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+// Drive the process_coordinates hook and touchFilterRelease() like the touch read does and check
+// the debounce, the reset on release and the jitter/lag bounds of the default tuning
+bool touchFilterTest() {
+    bool ok = true;
+    uint16_t x, y;
+    uint32_t t = 0;
+    printf("Touch filter test (debounce %d reads):\r\n", TOUCH_DEBOUNCE_READS);
+    touchFilterRelease();
+    
+    // A new press is withheld until its TOUCH_DEBOUNCE_READS-th read, which passes through unfiltered
+    bool withheld = true;
+    for (int i = 1; i < TOUCH_DEBOUNCE_READS; i++) {
+        x = 400; y = 240;
+        withheld = withheld && testRead(true, &x, &y, t += 10) == 0;
+    }
+    x = 400; y = 240;
+    bool passed = testRead(true, &x, &y, t += 10) == 1 && x == 400 && y == 240;
+    ok &= testCheck(withheld && passed, "press withheld until debounced, then passed unchanged");
+    
+    // A glitch shorter than the debounce never gets through, and does not shorten the next press's debounce
+    x = y = 0;
+    testRead(false, &x, &y, t += 10);
+    bool glitch_dropped = true;
+    for (int i = 1; i < TOUCH_DEBOUNCE_READS; i++) {
+        x = 50; y = 50;
+        glitch_dropped = glitch_dropped && testRead(true, &x, &y, t += 10) == 0;
+    }
+    testRead(false, &x, &y, t += 10);
+    x = 60; y = 60;
+    bool debounced_again = TOUCH_DEBOUNCE_READS < 2 || testRead(true, &x, &y, t += 10) == 0;
+    ok &= testCheck(glitch_dropped && debounced_again, "glitch dropped, release restarts the debounce");
+    
+    // After a release the next press starts fresh instead of being pulled towards the last one
+    // (a few pixels away, where the low-pass would otherwise hold it back)
+    for (int i = 0; i < 20; i++) {
+        x = 100; y = 100;
+        testRead(true, &x, &y, t += 10);
+    }
+    testRead(false, &x, &y, t += 10);
+    uint8_t count = 0;
+    for (int i = 0; i < TOUCH_DEBOUNCE_READS; i++) {
+        x = 106; y = 103;
+        count = testRead(true, &x, &y, t += 10);
+    }
+    ok &= testCheck(count == 1 && x == 106 && y == 103, "new press after a release starts at its own position");
+    testRead(false, &x, &y, t += 10);
+    
+    // Jitter of a resting finger and lag behind moving ones, in 1/100 px
+    uint32_t hold_raw, drag_raw, flick_raw;
+    int32_t hold_speed, drag_speed, flick_speed;
+    int16_t hold_vel, drag_vel, flick_vel;
+    uint32_t hold = testTrace(TRACE_HOLD, &hold_raw, &hold_speed, &hold_vel);
+    uint32_t drag = testTrace(TRACE_DRAG, &drag_raw, &drag_speed, &drag_vel);
+    uint32_t flick = testTrace(TRACE_FLICK, &flick_raw, &flick_speed, &flick_vel);
+    char what[80];
+    snprintf(what, sizeof(what), "hold jitter %lu.%02lu px (raw %lu.%02lu, limit half of raw)", (unsigned long)(hold / 100),
+             (unsigned long)(hold % 100), (unsigned long)(hold_raw / 100), (unsigned long)(hold_raw % 100));
+    ok &= testCheck(hold * 2 <= hold_raw, what);
+    snprintf(what, sizeof(what), "drag lag %lu.%02lu px at 300 px/s (limit %d px)", (unsigned long)(drag / 100),
+             (unsigned long)(drag % 100), TOUCH_TEST_MAX_DRAG_LAG_PX);
+    ok &= testCheck(drag <= TOUCH_TEST_MAX_DRAG_LAG_PX * 100, what);
+    snprintf(what, sizeof(what), "flick lag %lu.%02lu px up to 2000 px/s (limit %d px)", (unsigned long)(flick / 100),
+             (unsigned long)(flick % 100), TOUCH_TEST_MAX_FLICK_LAG_PX);
+    ok &= testCheck(flick <= TOUCH_TEST_MAX_FLICK_LAG_PX * 100, what);
+    
+    // The velocity a throw starts from: near zero at rest, within the error bound of the true speed when moving
+    snprintf(what, sizeof(what), "velocity at rest %d px/s (limit %d px/s)", hold_vel, TOUCH_TEST_MAX_VEL_ERROR_PX_S);
+    ok &= testCheck(hold_vel != INT16_MIN && abs(hold_vel) <= TOUCH_TEST_MAX_VEL_ERROR_PX_S, what);
+    snprintf(what, sizeof(what), "drag velocity %d px/s, true %ld px/s", drag_vel, (long)drag_speed);
+    ok &= testCheck(drag_vel != INT16_MIN && abs(drag_vel - drag_speed) <= TOUCH_TEST_MAX_VEL_ERROR_PX_S, what);
+    snprintf(what, sizeof(what), "flick velocity %d px/s, true %ld px/s", flick_vel, (long)flick_speed);
+    ok &= testCheck(flick_vel != INT16_MIN && abs(flick_vel - flick_speed) <= TOUCH_TEST_MAX_VEL_ERROR_PX_S, what);
+    int16_t vx, vy;
+    ok &= testCheck(!touchFilterVelocity(0, &vx, &vy) && vx == 0 && vy == 0, "no velocity after the release");
+    
+    touchFilterRelease();
+    return ok;
+}
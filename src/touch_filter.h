@@ -0,0 +1,38 @@
+/*
+ * Touch coordinate filtering (debounce, adaptive low-pass, velocity for kinetic scrolling)
+ */
+
+#ifndef TOUCH_FILTER_H
+#define TOUCH_FILTER_H
+
+#include <stdint.h>
+
+// One-euro filter tuning: cutoff = min_cutoff + beta * speed
+struct TouchFilterParams {
+    uint32_t min_cutoff_mhz;    // Cutoff at rest, in mHz (lower = steadier hold)
+    uint32_t beta;              // Added cutoff in mHz per px/s of speed (higher = less lag when moving)
+    uint32_t d_cutoff_mhz;      // Cutoff of the velocity estimate, in mHz
+};
+
+// Filter state of one touch point (fixed point, 1/16 px)
+struct TouchFilterPoint {
+    int32_t x;          // Filtered position
+    int32_t y;
+    int32_t vx;         // Filtered velocity, 1/16 px per second
+    int32_t vy;
+    int32_t raw_x;      // Previous unfiltered sample
+    int32_t raw_y;
+    uint32_t t_ms;      // Time of the last sample
+    bool valid;         // False until the first sample seeds the filter
+};
+
+// Functions
+void touchFilterReset(TouchFilterPoint *f);
+void touchFilterStep(TouchFilterPoint *f, const TouchFilterParams *params, uint16_t *x, uint16_t *y, uint32_t now_ms);
+void touchFilterProcess(uint16_t *x, uint16_t *y, uint8_t *point_num, uint32_t now_ms);
+void touchFilterRelease();
+bool touchFilterVelocity(uint8_t index, int16_t *vx, int16_t *vy);
+void touchFilterBenchmark();
+bool touchFilterTest();
+
+#endif // TOUCH_FILTER_H
@@ -0,0 +1,120 @@
+/*
+ * Message queues between the scanner and the UI
+ *
+ * The scanner (Arduino loop task) and the UI (LVGL task) never share state
+ * or take each other's locks. Scan results travel to the UI as events that
+ * the LVGL task drains before each lv_timer_handler() run, so every widget
+ * update happens in the task that already holds the LVGL lock. The records an
+ * event points at stay in the scanner's static buffers: the scanner takes a
+ * single "records free" token before writing them and the UI hands it back
+ * once the event is handled, so the buffers are lent rather than copied.
+ * Settings changes (pause, persistence, scan speed, the AP detail target)
+ * travel the other way as commands that the scanner applies to its own
+ * state between scans. The UI never waits on the scanner. Pause,
+ * persistence, scan time and sweep interval are states, not events: each
+ * has a one-slot mailbox that xQueueOverwrite() replaces, so a burst of
+ * changes collapses to the latest value and none of them can be lost to a
+ * full queue. Only the AP detail open/close commands are queued in order
+ * (a full queue drops one and logs it). Every send also leaves a token in
+ * command_ready, which is what the scanner waits on.
+ */
+
+#include "ui_bus.h"
+#include "ui_handlers.h"
+#include "lvgl_port.h"
+#include "config.h"
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <string.h>
+
+static QueueHandle_t event_queue = NULL;     // UiEvent, scanner -> UI
+static QueueHandle_t command_queue = NULL;   // ScanCommand, UI -> scanner (AP detail open/close)
+static QueueHandle_t settings[SCAN_CMD_COUNT];  // One-slot ScanCommand mailboxes, latest value wins
+static QueueHandle_t command_ready = NULL;   // Holds a token once anything was sent
+static QueueHandle_t records_free = NULL;    // Holds the token while the scanner may write its buffers
+
+// Commands that set a state: only the latest value matters
+static bool isSetting(ScanCommandType type) {
+    return type == SCAN_CMD_PAUSE || type == SCAN_CMD_PERSISTENCE || type == SCAN_CMD_SCAN_TIME ||
+           type == SCAN_CMD_INTERVAL;
+}
+
+void uiBusInit() {
+    event_queue = xQueueCreate(UI_BUS_EVENT_QUEUE_LEN, sizeof(UiEvent));
+    command_queue = xQueueCreate(UI_BUS_COMMAND_QUEUE_LEN, sizeof(ScanCommand));
+    for (int type = 0; type < SCAN_CMD_COUNT; type++) {
+        settings[type] = isSetting((ScanCommandType)type) ? xQueueCreate(1, sizeof(ScanCommand)) : NULL;
+    }
+    command_ready = xQueueCreate(1, sizeof(uint8_t));
+    records_free = xQueueCreate(1, sizeof(uint8_t));
+    uint8_t token = 0;
+    xQueueSend(records_free, &token, 0);
+}
+
+// Scanner: wait until the UI is done with the records lent by the previous event
+bool uiBusAcquireRecords(uint32_t timeout_ms) {
+    uint8_t token;
+    return xQueueReceive(records_free, &token, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+}
+
+// Scanner: hand an event (and the records it points at) to the UI
+void uiBusPostEvent(const UiEvent *event) {
+    if (xQueueSend(event_queue, event, 0) != pdTRUE) {
+        // Cannot happen while only one event lends the buffers; give them back
+        uint8_t token = 0;
+        xQueueSend(records_free, &token, 0);
+        return;
+    }
+    lvgl_port_wake();
+}
+
+// UI: handle queued events (LVGL task, lock held) and return the buffers
+void uiBusDrain() {
+    UiEvent event;
+    while (xQueueReceive(event_queue, &event, 0) == pdTRUE) {
+        handleScanEvent(&event);
+        uint8_t token = 0;
+        xQueueSend(records_free, &token, 0);
+    }
+}
+
+// UI: hand a command to the scanner without waiting
+void uiBusSendCommand(ScanCommandType type, uint16_t value, const uint8_t *bssid) {
+    ScanCommand command;
+    command.type = type;
+    command.value = value;
+    if (bssid) {
+        memcpy(command.bssid, bssid, 6);
+    } else {
+        memset(command.bssid, 0, 6);
+    }
+    if (isSetting(type)) {
+        xQueueOverwrite(settings[type], &command);
+    } else if (xQueueSend(command_queue, &command, 0) != pdTRUE) {
+        Serial.printf("UI bus: command %d dropped (queue full)\r\n", (int)type);
+        return;
+    }
+    uint8_t token = 0;
+    xQueueOverwrite(command_ready, &token);
+}
+
+// Pending settings first, then the AP detail commands in order
+static bool takeCommand(ScanCommand *command) {
+    for (int type = 0; type < SCAN_CMD_COUNT; type++) {
+        if (settings[type] != NULL && xQueueReceive(settings[type], command, 0) == pdTRUE) return true;
+    }
+    return xQueueReceive(command_queue, command, 0) == pdTRUE;
+}
+
+// Scanner: next command, waiting up to timeout_ms for one
+bool uiBusReceiveCommand(ScanCommand *command, uint32_t timeout_ms) {
+    if (takeCommand(command)) return true;
+    
+    // Drop a token left by commands already taken, then look again for one sent meanwhile
+    uint8_t token;
+    xQueueReceive(command_ready, &token, 0);
+    if (takeCommand(command)) return true;
+    if (timeout_ms == 0 || xQueueReceive(command_ready, &token, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) return false;
+    return takeCommand(command);
+}
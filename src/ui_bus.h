@@ -0,0 +1,49 @@
+/*
+ * Message queues between the scanner and the UI
+ */
+
+#ifndef UI_BUS_H
+#define UI_BUS_H
+
+#include <stdint.h>
+#include "esp_wifi.h"
+
+// Scanner -> UI
+enum UiEventType {
+    UI_EVENT_SWEEP,         // Full sweep (records of this sweep, snapshot back buffer built if has_snapshot)
+    UI_EVENT_DETAIL_SCAN    // Focused scan of the AP on the detail screen
+};
+
+struct UiEvent {
+    UiEventType type;
+    const wifi_ap_record_t *records;    // Scanner buffer, lent to the UI until the event has been handled
+    uint16_t count;
+    bool has_snapshot;                  // scanSnapshotBuild() ran, the UI publishes it
+};
+
+// UI -> scanner (pause, persistence, scan time and interval are coalesced: the scanner sees the latest value)
+enum ScanCommandType {
+    SCAN_CMD_PAUSE,         // value: 1 = paused
+    SCAN_CMD_PERSISTENCE,   // value: 1 = keep networks across sweeps, 0 = off (either starts a fresh list)
+    SCAN_CMD_SCAN_TIME,     // value: dwell per channel in ms
+    SCAN_CMD_DETAIL_OPEN,   // value: channel of bssid, sampled with focused scans
+    SCAN_CMD_DETAIL_CLOSE,
+    SCAN_CMD_INTERVAL,      // value: pause between sweeps in ms (idle governor)
+    SCAN_CMD_COUNT
+};
+
+struct ScanCommand {
+    ScanCommandType type;
+    uint16_t value;
+    uint8_t bssid[6];
+};
+
+// Functions
+void uiBusInit();
+bool uiBusAcquireRecords(uint32_t timeout_ms);
+void uiBusPostEvent(const UiEvent *event);
+void uiBusDrain();
+void uiBusSendCommand(ScanCommandType type, uint16_t value, const uint8_t *bssid);
+bool uiBusReceiveCommand(ScanCommand *command, uint32_t timeout_ms);
+
+#endif // UI_BUS_H
@@ -4,37 +4,71 @@
 
 #include "ui_handlers.h"
 #include "ui_views.h"
-#include "wifi_scanner.h"
 #include "preferences_storage.h"
 #include "lvgl_port.h"
 #include "wifi_data.h"
+#include "rssi_history.h"
+#include "table_view.h"
+#include "ap_detail.h"
+#include "ui_bus.h"
+#include "scan_snapshot.h"
+#include "dashboard_view.h"
+#include "waterfall.h"
+#include "diagnostics_view.h"
+#include <Arduino.h>
 
-// External state (declared in main.cpp)
-extern bool scanning_paused;
-extern bool persistence_enabled;
+// What the pause and persistence buttons show; the scanner keeps its own copy, set by commands
+static bool ui_paused = false;
+static bool ui_persistence = false;
+
+// Hide every view and release every view button
+static void hideAllViews() {
+    if (graph_obj) lv_obj_add_flag(graph_obj, LV_OBJ_FLAG_HIDDEN);
+    if (table_obj) lv_obj_add_flag(table_obj, LV_OBJ_FLAG_HIDDEN);
+    if (table_header) lv_obj_add_flag(table_header, LV_OBJ_FLAG_HIDDEN);
+    if (settings_obj) lv_obj_add_flag(settings_obj, LV_OBJ_FLAG_HIDDEN);
+    if (waterfall_obj) lv_obj_add_flag(waterfall_obj, LV_OBJ_FLAG_HIDDEN);
+    if (history_obj) lv_obj_add_flag(history_obj, LV_OBJ_FLAG_HIDDEN);
+    if (dashboard_obj) lv_obj_add_flag(dashboard_obj, LV_OBJ_FLAG_HIDDEN);
+    if (ap_detail_obj) lv_obj_add_flag(ap_detail_obj, LV_OBJ_FLAG_HIDDEN);
+    if (diagnostics_obj) lv_obj_add_flag(diagnostics_obj, LV_OBJ_FLAG_HIDDEN);
+    apDetailClose();  // Full sweeps resume
+    
+    if (graph_btn) lv_obj_clear_state(graph_btn, LV_STATE_CHECKED);
+    if (dashboard_btn) lv_obj_clear_state(dashboard_btn, LV_STATE_CHECKED);
+    if (table_btn) lv_obj_clear_state(table_btn, LV_STATE_CHECKED);
+    if (waterfall_btn) lv_obj_clear_state(waterfall_btn, LV_STATE_CHECKED);
+    if (history_btn) lv_obj_clear_state(history_btn, LV_STATE_CHECKED);
+    if (settings_btn) lv_obj_clear_state(settings_btn, LV_STATE_CHECKED);
+}
 
 // View switching functions
 void switchToGraphView(lv_event_t *e) {
     lvgl_port_lock(-1);
     
-    // Hide all views
-    if (table_obj) lv_obj_add_flag(table_obj, LV_OBJ_FLAG_HIDDEN);
-    if (table_header) lv_obj_add_flag(table_header, LV_OBJ_FLAG_HIDDEN);
-    if (settings_obj) lv_obj_add_flag(settings_obj, LV_OBJ_FLAG_HIDDEN);
+    hideAllViews();
+    setActiveView(VIEW_GRAPH);
     
-    // Show graph view
+    // Show graph view at full height
+    setGraphCompact(false);
     if (graph_obj) lv_obj_clear_flag(graph_obj, LV_OBJ_FLAG_HIDDEN);
+    if (graph_btn) lv_obj_add_state(graph_btn, LV_STATE_CHECKED);
     
-    // Update button states
-    if (graph_btn) {
-        lv_obj_add_state(graph_btn, LV_STATE_CHECKED);
-    }
-    if (table_btn) {
-        lv_obj_clear_state(table_btn, LV_STATE_CHECKED);
-    }
-    if (settings_btn) {
-        lv_obj_clear_state(settings_btn, LV_STATE_CHECKED);
-    }
+    lvgl_port_unlock();
+}
+
+void switchToDashboardView(lv_event_t *e) {
+    lvgl_port_lock(-1);
+    
+    hideAllViews();
+    ensureView(VIEW_DASHBOARD);  // Built on first use
+    setActiveView(VIEW_DASHBOARD);
+    
+    // Show the shortened graph with the compact list below it
+    setGraphCompact(true);
+    if (graph_obj) lv_obj_clear_flag(graph_obj, LV_OBJ_FLAG_HIDDEN);
+    if (dashboard_obj) lv_obj_clear_flag(dashboard_obj, LV_OBJ_FLAG_HIDDEN);
+    if (dashboard_btn) lv_obj_add_state(dashboard_btn, LV_STATE_CHECKED);
     
     lvgl_port_unlock();
 }
@@ -42,24 +76,42 @@ void switchToGraphView(lv_event_t *e) {
 void switchToTableView(lv_event_t *e) {
     lvgl_port_lock(-1);
     
-    // Hide all views
-    if (graph_obj) lv_obj_add_flag(graph_obj, LV_OBJ_FLAG_HIDDEN);
-    if (settings_obj) lv_obj_add_flag(settings_obj, LV_OBJ_FLAG_HIDDEN);
+    hideAllViews();
+    ensureView(VIEW_TABLE);  // Built on first use
+    setActiveView(VIEW_TABLE);
     
     // Show table view and header
     if (table_obj) lv_obj_clear_flag(table_obj, LV_OBJ_FLAG_HIDDEN);
     if (table_header) lv_obj_clear_flag(table_header, LV_OBJ_FLAG_HIDDEN);
+    if (table_btn) lv_obj_add_state(table_btn, LV_STATE_CHECKED);
     
-    // Update button states
-    if (table_btn) {
-        lv_obj_add_state(table_btn, LV_STATE_CHECKED);
-    }
-    if (graph_btn) {
-        lv_obj_clear_state(graph_btn, LV_STATE_CHECKED);
-    }
-    if (settings_btn) {
-        lv_obj_clear_state(settings_btn, LV_STATE_CHECKED);
-    }
+    lvgl_port_unlock();
+}
+
+void switchToWaterfallView(lv_event_t *e) {
+    lvgl_port_lock(-1);
+    
+    hideAllViews();
+    ensureView(VIEW_WATERFALL);  // Built on first use
+    setActiveView(VIEW_WATERFALL);
+    
+    // Show waterfall view
+    if (waterfall_obj) lv_obj_clear_flag(waterfall_obj, LV_OBJ_FLAG_HIDDEN);
+    if (waterfall_btn) lv_obj_add_state(waterfall_btn, LV_STATE_CHECKED);
+    
+    lvgl_port_unlock();
+}
+
+void switchToHistoryView(lv_event_t *e) {
+    lvgl_port_lock(-1);
+    
+    hideAllViews();
+    ensureView(VIEW_HISTORY);  // Built on first use
+    setActiveView(VIEW_HISTORY);
+    
+    // Show RSSI history view
+    if (history_obj) lv_obj_clear_flag(history_obj, LV_OBJ_FLAG_HIDDEN);
+    if (history_btn) lv_obj_add_state(history_btn, LV_STATE_CHECKED);
     
     lvgl_port_unlock();
 }
@@ -67,35 +119,41 @@ void switchToTableView(lv_event_t *e) {
 void switchToSettingsView(lv_event_t *e) {
     lvgl_port_lock(-1);
     
-    // Hide all views
-    if (graph_obj) lv_obj_add_flag(graph_obj, LV_OBJ_FLAG_HIDDEN);
-    if (table_obj) lv_obj_add_flag(table_obj, LV_OBJ_FLAG_HIDDEN);
-    if (table_header) lv_obj_add_flag(table_header, LV_OBJ_FLAG_HIDDEN);
+    hideAllViews();
+    ensureView(VIEW_SETTINGS);  // Built on first use
+    setActiveView(VIEW_SETTINGS);
     
     // Show settings view
     if (settings_obj) lv_obj_clear_flag(settings_obj, LV_OBJ_FLAG_HIDDEN);
+    if (settings_btn) lv_obj_add_state(settings_btn, LV_STATE_CHECKED);
     
-    // Update button states
-    if (settings_btn) {
-        lv_obj_add_state(settings_btn, LV_STATE_CHECKED);
-    }
-    if (graph_btn) {
-        lv_obj_clear_state(graph_btn, LV_STATE_CHECKED);
-    }
-    if (table_btn) {
-        lv_obj_clear_state(table_btn, LV_STATE_CHECKED);
+    lvgl_port_unlock();
+}
+
+// Opened from the settings view, so the settings button stays checked
+void switchToDiagnosticsView(lv_event_t *e) {
+    lvgl_port_lock(-1);
+    
+    hideAllViews();
+    if (ensureView(VIEW_DIAGNOSTICS)) {  // Built on first use
+        setActiveView(VIEW_DIAGNOSTICS);
+        diagnosticsViewUpdate();
+        lv_obj_clear_flag(diagnostics_obj, LV_OBJ_FLAG_HIDDEN);
+    } else if (settings_obj) {
+        lv_obj_clear_flag(settings_obj, LV_OBJ_FLAG_HIDDEN);
     }
+    if (settings_btn) lv_obj_add_state(settings_btn, LV_STATE_CHECKED);
     
     lvgl_port_unlock();
 }
 
 void togglePause(lv_event_t *e) {
-    scanning_paused = !scanning_paused;
-    
     lvgl_port_lock(-1);
     
+    ui_paused = !ui_paused;
+    uiBusSendCommand(SCAN_CMD_PAUSE, ui_paused, NULL);
     if (pause_btn) {
-        if (scanning_paused) {
+        if (ui_paused) {
             lv_obj_add_state(pause_btn, LV_STATE_CHECKED);
             lv_obj_t *label = lv_obj_get_child(pause_btn, 0);
             if (label) lv_label_set_text(label, "Resume");
@@ -110,23 +168,23 @@ void togglePause(lv_event_t *e) {
 }
 
 void togglePersistence(lv_event_t *e) {
-    persistence_enabled = !persistence_enabled;
-    
     lvgl_port_lock(-1);
     
+    // Turning it off also clears the scanner's persistent network list
+    ui_persistence = !ui_persistence;
+    uiBusSendCommand(SCAN_CMD_PERSISTENCE, ui_persistence, NULL);
     if (persistence_btn) {
-        if (persistence_enabled) {
+        if (ui_persistence) {
             lv_obj_add_state(persistence_btn, LV_STATE_CHECKED);
         } else {
             lv_obj_clear_state(persistence_btn, LV_STATE_CHECKED);
-            // Clear persistent network list when turning off
-            clearPersistentNetworks();
         }
     }
     
     lvgl_port_unlock();
 }
 
+// Slider released (LV_EVENT_RELEASED only, so a drag sends one command and one NVS write)
 void onRefreshSpeedChanged(lv_event_t *e) {
     lv_obj_t *slider = lv_event_get_target(e);
     int32_t value = lv_slider_get_value(slider);
@@ -138,9 +196,81 @@ void onRefreshSpeedChanged(lv_event_t *e) {
     // Map slider value (0-18) to scan time (120ms to 1920ms in 100ms steps)
     // Formula: 120ms + (value * 100ms)
     // This matches ESP-IDF's minimum of 120ms
-    scan_time_per_channel_ms = 120 + (value * 100);
+    uiBusSendCommand(SCAN_CMD_SCAN_TIME, 120 + (value * 100), NULL);
     
     // Save to non-volatile storage
     saveScanSpeed((uint8_t)value);
 }
 
+// Open the detail screen for a BSSID (in place of the table)
+void showApDetail(const uint8_t *bssid) {
+    lvgl_port_lock(-1);
+    
+    hideAllViews();
+    if (ensureView(VIEW_AP_DETAIL)) {  // Built on first use
+        setActiveView(VIEW_AP_DETAIL);
+        apDetailOpen(bssid);
+        lv_obj_clear_flag(ap_detail_obj, LV_OBJ_FLAG_HIDDEN);
+    } else if (table_obj) {
+        lv_obj_clear_flag(table_obj, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_clear_flag(table_header, LV_OBJ_FLAG_HIDDEN);
+    }
+    if (table_btn) lv_obj_add_state(table_btn, LV_STATE_CHECKED);  // The detail screen belongs to the table
+    
+    lvgl_port_unlock();
+}
+
+void onTableRowClicked(lv_event_t *e) {
+    int row = tableViewRowFromObj(lv_event_get_current_target(e));
+    if (row < 0) return;
+    
+    uint8_t bssid[6];
+    char ssid[33];
+    if (!getTableRowNetwork(row, bssid, ssid)) return;
+    showApDetail(bssid);
+}
+
+void onTableRowLongPressed(lv_event_t *e) {
+    int row = tableViewRowFromObj(lv_event_get_current_target(e));
+    if (row < 0) return;
+    
+    uint8_t bssid[6];
+    char ssid[33];
+    if (!getTableRowNetwork(row, bssid, ssid)) return;
+    
+    bool pinned = rssiHistoryTogglePin(bssid, ssid);
+    Serial.printf("History: %s %s\r\n", pinned ? "pinned" : "unpinned", ssid);
+    
+    // Show the pin marker right away rather than on the next sweep
+    tableViewRefresh();
+}
+
+void onTableHeaderClicked(lv_event_t *e) {
+    int col = (int)(intptr_t)lv_event_get_user_data(e);
+    tableViewSortBy(col);
+}
+
+// Scan results from the UI bus (LVGL task, lock held)
+void handleScanEvent(const UiEvent *event) {
+    switch (event->type) {
+        case UI_EVENT_SWEEP:
+            // Waterfall shows what is on air now, so it uses this sweep rather than the persistent list
+            // (an empty sweep is still a row of its time axis)
+            updateWaterfall(event->records, event->count);
+            updateRssiHistory(event->records, event->count);
+            apDetailObserve(event->records, event->count);
+            
+            // Publish the snapshot and update the graph, table and dashboard from it together
+            if (event->has_snapshot) {
+                const ScanSnapshot *snapshot = scanSnapshotPublish();
+                updateWiFiGraph(snapshot);
+                updateWiFiTable(snapshot);
+                dashboardViewUpdate(snapshot);
+            }
+            break;
+            
+        case UI_EVENT_DETAIL_SCAN:
+            apDetailObserve(event->records, event->count);
+            break;
+    }
+}
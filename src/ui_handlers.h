@@ -6,14 +6,24 @@
 #define UI_HANDLERS_H
 
 #include <lvgl.h>
+#include "ui_bus.h"
 
 // Functions
 void switchToGraphView(lv_event_t *e);
+void switchToDashboardView(lv_event_t *e);
 void switchToTableView(lv_event_t *e);
 void switchToSettingsView(lv_event_t *e);
+void switchToWaterfallView(lv_event_t *e);
+void switchToHistoryView(lv_event_t *e);
+void switchToDiagnosticsView(lv_event_t *e);
 void togglePause(lv_event_t *e);
 void togglePersistence(lv_event_t *e);
 void onRefreshSpeedChanged(lv_event_t *e);
+void showApDetail(const uint8_t *bssid);
+void onTableRowClicked(lv_event_t *e);
+void onTableRowLongPressed(lv_event_t *e);
+void onTableHeaderClicked(lv_event_t *e);
+void handleScanEvent(const UiEvent *event);
 
 #endif // UI_HANDLERS_H
 
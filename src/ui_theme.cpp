@@ -0,0 +1,194 @@
+/*
+ * Shared LVGL styles implementation
+ *
+ * Every lv_obj_set_style_*() call gives the object its own local style and
+ * grows it by one property, so the menu buttons and table header used to carry
+ * several private copies of identical styling, and each property lookup during
+ * drawing walked those arrays. The styles here are built once and attached by
+ * reference, which shares the memory and keeps the per-object style lists
+ * short. uiThemeBenchmark() builds the menu bar both ways to show the
+ * difference in heap use, style lookup time and redraw time. Heap use is
+ * counted by the LVGL heap itself (lv_mem_monitor() reports nothing with
+ * LV_MEM_CUSTOM), so it is the same on the device and on the host.
+ */
+
+#include "ui_theme.h"
+#include "lvgl_heap.h"
+#include "config.h"
+#include <Arduino.h>
+
+lv_style_t ui_style_view;
+lv_style_t ui_style_page;
+lv_style_t ui_style_bar;
+lv_style_t ui_style_menu_btn;
+lv_style_t ui_style_menu_btn_checked;
+lv_style_t ui_style_header_label;
+lv_style_t ui_style_table;
+lv_style_t ui_style_table_row;
+lv_style_t ui_style_table_cell;
+lv_style_t ui_style_title;
+lv_style_t ui_style_caption;
+lv_style_t ui_style_axis_label;
+
+static bool theme_ready = false;
+
+// Build the shared styles (call once with the LVGL lock held, before any view is created)
+void uiThemeInit() {
+    if (theme_ready) return;
+    
+    lv_style_init(&ui_style_view);
+    lv_style_set_bg_color(&ui_style_view, lv_color_hex(0x000000));
+    lv_style_set_bg_opa(&ui_style_view, LV_OPA_COVER);
+    lv_style_set_border_width(&ui_style_view, 0);
+    lv_style_set_pad_all(&ui_style_view, 0);
+    
+    lv_style_init(&ui_style_page);
+    lv_style_set_pad_all(&ui_style_page, 20);
+    
+    lv_style_init(&ui_style_bar);
+    lv_style_set_bg_color(&ui_style_bar, lv_color_hex(0x252526));
+    lv_style_set_bg_opa(&ui_style_bar, LV_OPA_COVER);
+    lv_style_set_border_width(&ui_style_bar, 0);
+    lv_style_set_radius(&ui_style_bar, 0);  // Square corners
+    lv_style_set_pad_all(&ui_style_bar, 5);
+    lv_style_set_pad_gap(&ui_style_bar, 5);
+    
+    // Text style is inherited by the button's label
+    lv_style_init(&ui_style_menu_btn);
+    lv_style_set_bg_color(&ui_style_menu_btn, lv_color_hex(0x2d2d30));
+    lv_style_set_bg_opa(&ui_style_menu_btn, LV_OPA_COVER);
+    lv_style_set_text_color(&ui_style_menu_btn, lv_color_hex(0xFFFFFF));
+    lv_style_set_text_font(&ui_style_menu_btn, &lv_font_montserrat_18);
+    
+    lv_style_init(&ui_style_menu_btn_checked);
+    lv_style_set_bg_color(&ui_style_menu_btn_checked, lv_color_hex(0x007acc));
+    lv_style_set_text_color(&ui_style_menu_btn_checked, lv_color_hex(0xFFFFFF));
+    
+    lv_style_init(&ui_style_header_label);
+    lv_style_set_text_color(&ui_style_header_label, lv_color_hex(0xFFFFFF));
+    lv_style_set_text_font(&ui_style_header_label, &lv_font_montserrat_14);
+    lv_style_set_pad_all(&ui_style_header_label, 4);
+    
+    lv_style_init(&ui_style_table);
+    lv_style_set_radius(&ui_style_table, 0);
+    lv_style_set_pad_all(&ui_style_table, 5);
+    
+    lv_style_init(&ui_style_table_row);
+    lv_style_set_bg_color(&ui_style_table_row, lv_color_hex(0x000000));
+    lv_style_set_bg_opa(&ui_style_table_row, LV_OPA_COVER);
+    lv_style_set_border_color(&ui_style_table_row, lv_color_hex(0x333333));
+    lv_style_set_border_width(&ui_style_table_row, 1);
+    lv_style_set_border_side(&ui_style_table_row, LV_BORDER_SIDE_BOTTOM);
+    
+    lv_style_init(&ui_style_table_cell);
+    lv_style_set_text_color(&ui_style_table_cell, lv_color_hex(0xFFFFFF));
+    lv_style_set_pad_left(&ui_style_table_cell, 4);
+    
+    lv_style_init(&ui_style_title);
+    lv_style_set_text_color(&ui_style_title, lv_color_hex(0xFFFFFF));
+    lv_style_set_text_font(&ui_style_title, &lv_font_montserrat_16);
+    
+    lv_style_init(&ui_style_caption);
+    lv_style_set_text_color(&ui_style_caption, lv_color_hex(0xFFFFFF));
+    lv_style_set_text_font(&ui_style_caption, &lv_font_montserrat_12);
+    
+    lv_style_init(&ui_style_axis_label);
+    lv_style_set_text_color(&ui_style_axis_label, lv_color_hex(0x888888));
+    lv_style_set_text_font(&ui_style_axis_label, &lv_font_montserrat_12);
+    
+    theme_ready = true;
+}
+
+#define THEME_BENCH_LOOKUPS 1000
+
+// A menu bar with MENU_BUTTON_COUNT buttons styled the old way (local properties) or with the shared styles
+static lv_obj_t *buildBenchMenu(bool shared) {
+    lv_obj_t *bar = lv_obj_create(lv_layer_top());
+    lv_obj_set_size(bar, MENU_BAR_WIDTH, MENU_BAR_HEIGHT);
+    lv_obj_align(bar, LV_ALIGN_TOP_RIGHT, 0, 0);
+    if (shared) {
+        lv_obj_add_style(bar, &ui_style_bar, LV_PART_MAIN);
+    } else {
+        lv_obj_set_style_bg_color(bar, lv_color_hex(0x252526), LV_PART_MAIN);
+        lv_obj_set_style_bg_opa(bar, LV_OPA_COVER, LV_PART_MAIN);
+        lv_obj_set_style_border_width(bar, 0, LV_PART_MAIN);
+        lv_obj_set_style_radius(bar, 0, LV_PART_MAIN);
+        lv_obj_set_style_pad_all(bar, 5, LV_PART_MAIN);
+        lv_obj_set_style_pad_gap(bar, 5, LV_PART_MAIN);
+    }
+    lv_obj_set_flex_flow(bar, LV_FLEX_FLOW_COLUMN);
+    lv_obj_clear_flag(bar, LV_OBJ_FLAG_SCROLLABLE);
+    
+    int button_height = (MENU_BAR_HEIGHT - 10 - 5 * (MENU_BUTTON_COUNT - 1)) / MENU_BUTTON_COUNT;
+    for (int i = 0; i < MENU_BUTTON_COUNT; i++) {
+        lv_obj_t *btn = lv_btn_create(bar);
+        lv_obj_set_size(btn, MENU_BAR_WIDTH - 10, button_height);
+        lv_obj_t *label = lv_label_create(btn);
+        lv_label_set_text(label, "Button");
+        lv_obj_center(label);
+        if (shared) {
+            lv_obj_add_style(btn, &ui_style_menu_btn, LV_PART_MAIN);
+            lv_obj_add_style(btn, &ui_style_menu_btn_checked, LV_PART_MAIN | LV_STATE_CHECKED);
+        } else {
+            lv_obj_set_style_bg_color(btn, lv_color_hex(0x2d2d30), LV_PART_MAIN);
+            lv_obj_set_style_bg_opa(btn, LV_OPA_COVER, LV_PART_MAIN);
+            lv_obj_set_style_text_color(btn, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
+            lv_obj_set_style_bg_color(btn, lv_color_hex(0x007acc), LV_PART_MAIN | LV_STATE_CHECKED);
+            lv_obj_set_style_text_color(btn, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_CHECKED);
+            lv_obj_set_style_text_font(label, &lv_font_montserrat_18, LV_PART_MAIN);
+        }
+    }
+    return bar;
+}
+
+// Heap, style lookup and redraw cost of one way of styling the menu bar; returns the LVGL heap bytes it held
+static size_t benchMenu(const char *name, bool shared, bool *leaked) {
+    size_t heap_before = lvgl_heap_in_use();
+    lv_obj_t *bar = buildBenchMenu(shared);
+    lv_obj_update_layout(bar);
+    size_t heap_used = lvgl_heap_in_use() - heap_before;
+    
+    // Property lookups the draw code performs for every button
+    uint32_t start = micros();
+    volatile uint32_t sink = 0;  // Keeps the lookups from being optimized away
+    for (int n = 0; n < THEME_BENCH_LOOKUPS; n++) {
+        for (uint32_t i = 0; i < lv_obj_get_child_cnt(bar); i++) {
+            lv_obj_t *btn = lv_obj_get_child(bar, i);
+            sink += lv_obj_get_style_bg_color(btn, LV_PART_MAIN).full;
+            sink += lv_obj_get_style_text_color(btn, LV_PART_MAIN).full;
+            sink += lv_obj_get_style_text_font(lv_obj_get_child(btn, 0), LV_PART_MAIN)->line_height;
+        }
+    }
+    uint32_t lookup_us = micros() - start;
+    
+    start = micros();
+    for (int f = 0; f < LVGL_BENCHMARK_FRAMES; f++) {
+        lv_obj_invalidate(bar);
+        lv_refr_now(NULL);
+    }
+    uint32_t redraw_us = (micros() - start) / LVGL_BENCHMARK_FRAMES;
+    
+    lv_obj_del(bar);
+    lv_refr_now(NULL);
+    *leaked = lvgl_heap_in_use() != heap_before;
+    
+    printf("Theme %-7s menu bar: %6u bytes, %5lu ns/lookup, %6lu us/redraw%s\r\n", name, (unsigned)heap_used,
+           (unsigned long)(lookup_us * 1000ULL / (THEME_BENCH_LOOKUPS * MENU_BUTTON_COUNT * 3)),
+           (unsigned long)redraw_us, *leaked ? ", not all freed" : "");
+    return heap_used;
+}
+
+// Compare local style properties with the shared styles; false unless the shared
+// styles take less LVGL heap and both menu bars give all of it back (LVGL lock held)
+bool uiThemeBenchmark() {
+    uiThemeInit();
+    lv_refr_now(NULL);  // Flush pending screen updates so only the menu bar is timed
+    bool local_leaked, shared_leaked;
+    size_t local_bytes = benchMenu("local", false, &local_leaked);
+    size_t shared_bytes = benchMenu("shared", true, &shared_leaked);
+    
+    bool ok = shared_bytes < local_bytes && !local_leaked && !shared_leaked;
+    printf("Theme: shared styles save %ld bytes of LVGL heap: %s\r\n", (long)local_bytes - (long)shared_bytes,
+           ok ? "ok" : "FAIL");
+    return ok;
+}
@@ -0,0 +1,28 @@
+/*
+ * Shared LVGL styles for the UI
+ */
+
+#ifndef UI_THEME_H
+#define UI_THEME_H
+
+#include <lvgl.h>
+
+// Shared styles (initialized once by uiThemeInit, applied with lv_obj_add_style)
+extern lv_style_t ui_style_view;            // Full-size black view / container
+extern lv_style_t ui_style_page;            // Padding for form-like views (settings)
+extern lv_style_t ui_style_bar;             // Dark grey strip: menu bar, table header, legend
+extern lv_style_t ui_style_menu_btn;        // Menu bar button
+extern lv_style_t ui_style_menu_btn_checked; // Menu bar button for the active view / toggle
+extern lv_style_t ui_style_header_label;    // Table column title
+extern lv_style_t ui_style_table;           // Table scroll container (padding, square corners)
+extern lv_style_t ui_style_table_row;       // Table row with a bottom divider
+extern lv_style_t ui_style_table_cell;      // Table cell text
+extern lv_style_t ui_style_title;           // Section title (white, 16 px)
+extern lv_style_t ui_style_caption;         // Small white text (12 px)
+extern lv_style_t ui_style_axis_label;      // Grey axis / hint text (12 px)
+
+// Functions
+void uiThemeInit();
+bool uiThemeBenchmark();
+
+#endif // UI_THEME_H
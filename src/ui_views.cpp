@@ -7,7 +7,19 @@
 #include "config.h"
 #include "preferences_storage.h"
 #include "wifi_scanner.h"
+#include "ui_bus.h"
 #include "lvgl_port.h"
+#include "waterfall.h"
+#include "wifi_data.h"
+#include "table_view.h"
+#include "dashboard_view.h"
+#include "ap_detail.h"
+#include "diagnostics_view.h"
+#include "graph_viewport.h"
+#include "graph_background.h"
+#include "ui_theme.h"
+#include "rssi_history.h"
+#include "boot_trace.h"
 #include <Arduino.h>
 
 // Global UI objects
@@ -16,48 +28,73 @@ lv_obj_t *vertical_axis_label = NULL;
 lv_obj_t *table_obj = NULL;
 lv_obj_t *table_header = NULL;
 lv_obj_t *settings_obj = NULL;
+lv_obj_t *waterfall_obj = NULL;
+lv_obj_t *history_obj = NULL;
+lv_obj_t *history_chart = NULL;
+lv_obj_t *history_legend = NULL;
+lv_obj_t *dashboard_obj = NULL;
+lv_obj_t *ap_detail_obj = NULL;
+lv_obj_t *diagnostics_obj = NULL;
 lv_obj_t *info_window = NULL;
 lv_obj_t *menu_bar = NULL;
 lv_obj_t *pause_btn = NULL;
 lv_obj_t *persistence_btn = NULL;
 lv_obj_t *graph_btn = NULL;
+lv_obj_t *dashboard_btn = NULL;
 lv_obj_t *table_btn = NULL;
+lv_obj_t *waterfall_btn = NULL;
+lv_obj_t *history_btn = NULL;
 lv_obj_t *settings_btn = NULL;
 
+// Saved refresh speed as a slider position (0-18)
+static uint8_t loadScanSpeedSlider() {
+    // Convert old values (0-100 or 0-19) to new range (0-18) if needed
+    uint8_t saved_raw = loadScanSpeed(9);  // Default to 9 (1020ms, middle of new range)
+    uint8_t saved_slider_value = saved_raw;
+    if (saved_raw > 18) {
+        // Old value from previous version, convert to new range (0-18)
+        if (saved_raw > 19) {
+            // Very old value (0-100), convert to new range
+            saved_slider_value = (saved_raw * 18) / 100;
+        } else {
+            // Previous version (0-19), convert to new range (0-18)
+            saved_slider_value = (saved_raw * 18) / 19;
+        }
+    }
+    return saved_slider_value;
+}
+
+// Apply the saved refresh speed at boot (the settings view itself is built on first use)
+void initScanSettings() {
+    // Formula: 120ms + (value * 100ms) = 120ms to 1920ms in 100ms steps
+    uiBusSendCommand(SCAN_CMD_SCAN_TIME, 120 + (loadScanSpeedSlider() * 100), NULL);
+}
+
 // Create menu bar
 void createMenuBar(lv_obj_t *parent) {
     // Create menu bar container
     menu_bar = lv_obj_create(parent);
     lv_obj_set_size(menu_bar, MENU_BAR_WIDTH, MENU_BAR_HEIGHT);
     lv_obj_align(menu_bar, LV_ALIGN_TOP_RIGHT, 0, 0);
-    lv_obj_set_style_bg_color(menu_bar, lv_color_hex(0x252526), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(menu_bar, LV_OPA_COVER, LV_PART_MAIN);
-    lv_obj_set_style_border_width(menu_bar, 0, LV_PART_MAIN);
-    lv_obj_set_style_radius(menu_bar, 0, LV_PART_MAIN);  // Square corners
-    lv_obj_set_style_pad_all(menu_bar, 5, LV_PART_MAIN);
+    lv_obj_add_style(menu_bar, &ui_style_bar, LV_PART_MAIN);  // Square corners, 5px padding and gap
     lv_obj_set_flex_flow(menu_bar, LV_FLEX_FLOW_COLUMN);
     lv_obj_set_flex_align(menu_bar, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-    lv_obj_set_style_pad_gap(menu_bar, 5, LV_PART_MAIN);
     // Disable scrolling to prevent scrollbar
     lv_obj_set_scrollbar_mode(menu_bar, LV_SCROLLBAR_MODE_OFF);
     lv_obj_clear_flag(menu_bar, LV_OBJ_FLAG_SCROLLABLE);
     
-    // Calculate button height to evenly distribute 5 buttons across menu bar
+    // Calculate button height to evenly distribute the buttons across menu bar
     // Menu bar: 480px total
     // - Top/bottom padding: 10px (5px each)
-    // - 4 gaps between 5 buttons: 20px (5px each)
-    // - 5 buttons: 5 * button_height
-    // So: 10 + 20 + 5*button_height = 480
-    // Therefore: button_height = (480 - 30) / 5 = 90px
-    int button_height = (MENU_BAR_HEIGHT - 10 - 20) / 5;
+    // - (MENU_BUTTON_COUNT - 1) gaps between buttons: 5px each
+    // So: 10 + 5*(count-1) + count*button_height = 480
+    // With 8 buttons: button_height = (480 - 45) / 8 = 54px
+    int button_height = (MENU_BAR_HEIGHT - 10 - 5 * (MENU_BUTTON_COUNT - 1)) / MENU_BUTTON_COUNT;
     
-    // Helper function to style buttons with common settings
+    // Helper function to style buttons with the shared menu button styles (label font is inherited)
     auto styleButton = [](lv_obj_t *btn) {
-        lv_obj_set_style_bg_color(btn, lv_color_hex(0x2d2d30), LV_PART_MAIN);
-        lv_obj_set_style_bg_opa(btn, LV_OPA_COVER, LV_PART_MAIN);
-        lv_obj_set_style_text_color(btn, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-        lv_obj_set_style_bg_color(btn, lv_color_hex(0x007acc), LV_PART_MAIN | LV_STATE_CHECKED);
-        lv_obj_set_style_text_color(btn, lv_color_hex(0xFFFFFF), LV_PART_MAIN | LV_STATE_CHECKED);
+        lv_obj_add_style(btn, &ui_style_menu_btn, LV_PART_MAIN);
+        lv_obj_add_style(btn, &ui_style_menu_btn_checked, LV_PART_MAIN | LV_STATE_CHECKED);
     };
     
     // Pause button
@@ -66,7 +103,6 @@ void createMenuBar(lv_obj_t *parent) {
     styleButton(pause_btn);
     lv_obj_t *pause_label = lv_label_create(pause_btn);
     lv_label_set_text(pause_label, "Pause");
-    lv_obj_set_style_text_font(pause_label, &lv_font_montserrat_18, LV_PART_MAIN);
     lv_obj_center(pause_label);
     lv_obj_add_event_cb(pause_btn, togglePause, LV_EVENT_CLICKED, NULL);
     
@@ -76,7 +112,6 @@ void createMenuBar(lv_obj_t *parent) {
     styleButton(persistence_btn);
     lv_obj_t *persistence_label = lv_label_create(persistence_btn);
     lv_label_set_text(persistence_label, "Persistence");
-    lv_obj_set_style_text_font(persistence_label, &lv_font_montserrat_18, LV_PART_MAIN);
     lv_obj_center(persistence_label);
     lv_obj_add_event_cb(persistence_btn, togglePersistence, LV_EVENT_CLICKED, NULL);
     
@@ -87,31 +122,130 @@ void createMenuBar(lv_obj_t *parent) {
     lv_obj_add_state(graph_btn, LV_STATE_CHECKED);  // Default view
     lv_obj_t *graph_label = lv_label_create(graph_btn);
     lv_label_set_text(graph_label, "Graph");
-    lv_obj_set_style_text_font(graph_label, &lv_font_montserrat_18, LV_PART_MAIN);
     lv_obj_center(graph_label);
     lv_obj_add_event_cb(graph_btn, switchToGraphView, LV_EVENT_CLICKED, NULL);
     
+    // Dashboard view button
+    dashboard_btn = lv_btn_create(menu_bar);
+    lv_obj_set_size(dashboard_btn, MENU_BAR_WIDTH - 10, button_height);
+    styleButton(dashboard_btn);
+    lv_obj_t *dashboard_label = lv_label_create(dashboard_btn);
+    lv_label_set_text(dashboard_label, "Dashboard");
+    lv_obj_center(dashboard_label);
+    lv_obj_add_event_cb(dashboard_btn, switchToDashboardView, LV_EVENT_CLICKED, NULL);
+    
     // Table view button
     table_btn = lv_btn_create(menu_bar);
     lv_obj_set_size(table_btn, MENU_BAR_WIDTH - 10, button_height);
     styleButton(table_btn);
     lv_obj_t *table_label = lv_label_create(table_btn);
     lv_label_set_text(table_label, "Table");
-    lv_obj_set_style_text_font(table_label, &lv_font_montserrat_18, LV_PART_MAIN);
     lv_obj_center(table_label);
     lv_obj_add_event_cb(table_btn, switchToTableView, LV_EVENT_CLICKED, NULL);
     
+    // Waterfall view button
+    waterfall_btn = lv_btn_create(menu_bar);
+    lv_obj_set_size(waterfall_btn, MENU_BAR_WIDTH - 10, button_height);
+    styleButton(waterfall_btn);
+    lv_obj_t *waterfall_label = lv_label_create(waterfall_btn);
+    lv_label_set_text(waterfall_label, "Waterfall");
+    lv_obj_center(waterfall_label);
+    lv_obj_add_event_cb(waterfall_btn, switchToWaterfallView, LV_EVENT_CLICKED, NULL);
+    
+    // RSSI history view button
+    history_btn = lv_btn_create(menu_bar);
+    lv_obj_set_size(history_btn, MENU_BAR_WIDTH - 10, button_height);
+    styleButton(history_btn);
+    lv_obj_t *history_label = lv_label_create(history_btn);
+    lv_label_set_text(history_label, "History");
+    lv_obj_center(history_label);
+    lv_obj_add_event_cb(history_btn, switchToHistoryView, LV_EVENT_CLICKED, NULL);
+    
     // Settings view button
     settings_btn = lv_btn_create(menu_bar);
     lv_obj_set_size(settings_btn, MENU_BAR_WIDTH - 10, button_height);
     styleButton(settings_btn);
     lv_obj_t *settings_label = lv_label_create(settings_btn);
     lv_label_set_text(settings_label, "Settings");
-    lv_obj_set_style_text_font(settings_label, &lv_font_montserrat_18, LV_PART_MAIN);
     lv_obj_center(settings_label);
     lv_obj_add_event_cb(settings_btn, switchToSettingsView, LV_EVENT_CLICKED, NULL);
 }
 
+// Centre the rotated "RSSI (dB)" title on the plot
+static void positionAxisLabel() {
+    uint32_t lbl_h = lv_obj_get_height(vertical_axis_label);
+    uint32_t lbl_w = lv_obj_get_width(vertical_axis_label);
+    
+    // Position label on the left side, centered vertically on the graph
+    // After -90° rotation, the original width becomes the vertical extent
+    // RSSI scale labels are drawn at x=25, so position title well to the left
+    int graph_center_y = GRAPH_TOP_OFFSET + (graphPlotHeight() / 2);
+    // After rotation, lbl_w (original width) becomes the height, so center using half of that
+    // After rotation, lbl_h (original height) becomes the width
+    // Use larger negative x to account for rotated label's bounding box and move it to the very left edge
+    // Try -lbl_h to fully compensate for the rotated width, or even more if needed
+    lv_obj_set_pos(vertical_axis_label, -lbl_h, graph_center_y - (lbl_w / 2));
+    
+    // Update layout after positioning to ensure transform is applied
+    lv_obj_update_layout(vertical_axis_label);
+}
+
+// Create info window and graph view
+void createGraphView(lv_obj_t *parent) {
+    // Create info window container (left region: 640x480)
+    info_window = lv_obj_create(parent);
+    lv_obj_set_size(info_window, INFO_WINDOW_WIDTH, INFO_WINDOW_HEIGHT);
+    lv_obj_align(info_window, LV_ALIGN_TOP_LEFT, 0, 0);
+    lv_obj_add_style(info_window, &ui_style_view, LV_PART_MAIN);
+    
+    // Create graph object for WiFi visualization (using custom draw callback)
+    graph_obj = lv_obj_create(info_window);
+    lv_obj_set_size(graph_obj, INFO_WINDOW_WIDTH, INFO_WINDOW_HEIGHT);
+    lv_obj_align(graph_obj, LV_ALIGN_TOP_LEFT, 0, 0);
+    lv_obj_add_style(graph_obj, &ui_style_view, LV_PART_MAIN);
+    lv_obj_add_event_cb(graph_obj, graph_draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+    
+    // Create rotated label for vertical axis title "RSSI (dB)"
+    vertical_axis_label = lv_label_create(info_window);
+    lv_label_set_text(vertical_axis_label, "RSSI (dB)");
+    lv_obj_add_style(vertical_axis_label, &ui_style_axis_label, LV_PART_MAIN);
+    lv_obj_set_style_text_align(vertical_axis_label, LV_TEXT_ALIGN_CENTER, LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(vertical_axis_label, LV_OPA_TRANSP, LV_PART_MAIN);
+    lv_obj_set_style_border_width(vertical_axis_label, 0, LV_PART_MAIN);
+    lv_obj_clear_flag(vertical_axis_label, LV_OBJ_FLAG_CLICKABLE);
+    
+    // Update layout to get actual label dimensions before rotation
+    lv_obj_update_layout(vertical_axis_label);
+    
+    // Get label dimensions and set rotation pivot to center
+    uint32_t lbl_h = lv_obj_get_height(vertical_axis_label);
+    uint32_t lbl_w = lv_obj_get_width(vertical_axis_label);
+    lv_obj_set_style_transform_pivot_x(vertical_axis_label, lbl_w / 2, LV_PART_MAIN);
+    lv_obj_set_style_transform_pivot_y(vertical_axis_label, lbl_h / 2, LV_PART_MAIN);
+    
+    // Rotate -90 degrees (counterclockwise) - LVGL 8.x uses transform_angle in 0.1 degree units, so -90° = -900
+    lv_obj_set_style_transform_angle(vertical_axis_label, -900, LV_PART_MAIN);
+    
+    positionAxisLabel();
+    
+    // Move label to front to ensure it's visible above graph
+    lv_obj_move_foreground(vertical_axis_label);
+}
+
+// Switch the graph between full height and the shorter dashboard layout (call with the LVGL lock held)
+void setGraphCompact(bool compact) {
+    if (graph_obj == NULL) return;
+    
+    int height = compact ? DASHBOARD_GRAPH_HEIGHT : INFO_WINDOW_HEIGHT;
+    if (lv_obj_get_height(graph_obj) == height) return;
+    
+    lv_obj_set_height(graph_obj, height);
+    graphViewportSetPlotHeight(height - GRAPH_TOP_OFFSET - GRAPH_BOTTOM_MARGIN);
+    graphBackgroundRefresh();
+    positionAxisLabel();
+    lv_obj_invalidate(info_window);
+}
+
 // Create table view
 void createTableView() {
     if (info_window == NULL) return;
@@ -120,54 +254,30 @@ void createTableView() {
     table_header = lv_obj_create(info_window);
     lv_obj_set_size(table_header, INFO_WINDOW_WIDTH, 30);
     lv_obj_align(table_header, LV_ALIGN_TOP_LEFT, 0, 0);
-    lv_obj_set_style_bg_color(table_header, lv_color_hex(0x252526), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(table_header, LV_OPA_COVER, LV_PART_MAIN);
-    lv_obj_set_style_border_width(table_header, 0, LV_PART_MAIN);
-    lv_obj_set_style_radius(table_header, 0, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(table_header, 5, LV_PART_MAIN);
+    lv_obj_add_style(table_header, &ui_style_bar, LV_PART_MAIN);
     lv_obj_clear_flag(table_header, LV_OBJ_FLAG_SCROLLABLE);
     
     // Use flex layout to match table column widths exactly
     lv_obj_set_flex_flow(table_header, LV_FLEX_FLOW_ROW);
     lv_obj_set_flex_align(table_header, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-    lv_obj_set_style_pad_gap(table_header, 0, LV_PART_MAIN);
+    lv_obj_set_style_pad_gap(table_header, 0, LV_PART_MAIN);  // Columns line up with the rows
     
-    // Column widths matching the table: 220, 60, 85, 95, 150
-    int col_widths[] = {220, 60, 85, 95, 150};
+    // Column widths shared with the table rows
     const char* header_texts[] = {"SSID", "Ch", "RSSI", "Width", "Security"};
     
-    for (int i = 0; i < 5; i++) {
+    for (int i = 0; i < TABLE_COLUMNS; i++) {
         lv_obj_t *header_label = lv_label_create(table_header);
         lv_label_set_text(header_label, header_texts[i]);
-        lv_obj_set_size(header_label, col_widths[i], LV_SIZE_CONTENT);
-        lv_obj_set_style_text_color(header_label, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-        lv_obj_set_style_text_font(header_label, &lv_font_montserrat_14, LV_PART_MAIN);
-        lv_obj_set_style_pad_all(header_label, 4, LV_PART_MAIN);
+        lv_obj_set_size(header_label, table_col_widths[i], LV_SIZE_CONTENT);
+        lv_obj_add_style(header_label, &ui_style_header_label, LV_PART_MAIN);
+        // Tap to sort by this column (shows the sort direction)
+        tableViewAttachHeader(i, header_label);
     }
     
-    // Create scrollable table below header
-    table_obj = lv_table_create(info_window);
+    // Create scrollable, virtualized table below header
+    table_obj = tableViewCreate(info_window);
     lv_obj_set_size(table_obj, INFO_WINDOW_WIDTH, INFO_WINDOW_HEIGHT - 30);
     lv_obj_align(table_obj, LV_ALIGN_TOP_LEFT, 0, 30);
-    lv_obj_set_style_bg_color(table_obj, lv_color_hex(0x000000), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(table_obj, LV_OPA_COVER, LV_PART_MAIN);
-    lv_obj_set_style_text_color(table_obj, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-    lv_obj_set_style_border_width(table_obj, 0, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(table_obj, 5, LV_PART_MAIN);
-    
-    // Set cell background and text colors
-    lv_obj_set_style_bg_color(table_obj, lv_color_hex(0x000000), LV_PART_ITEMS);
-    lv_obj_set_style_bg_opa(table_obj, LV_OPA_COVER, LV_PART_ITEMS);
-    lv_obj_set_style_text_color(table_obj, lv_color_hex(0xFFFFFF), LV_PART_ITEMS);
-    lv_obj_set_style_border_color(table_obj, lv_color_hex(0x333333), LV_PART_ITEMS);
-    lv_obj_set_style_border_width(table_obj, 1, LV_PART_ITEMS);
-    lv_obj_set_style_pad_all(table_obj, 4, LV_PART_ITEMS);
-    lv_obj_set_style_pad_top(table_obj, 8, LV_PART_ITEMS);
-    lv_obj_set_style_pad_bottom(table_obj, 8, LV_PART_ITEMS);
-    
-    // Make table scrollable
-    lv_obj_set_scroll_dir(table_obj, LV_DIR_VER);
-    lv_obj_set_scrollbar_mode(table_obj, LV_SCROLLBAR_MODE_AUTO);
     
     // Initially hidden (graph is default view)
     lv_obj_add_flag(table_obj, LV_OBJ_FLAG_HIDDEN);
@@ -181,46 +291,29 @@ void createSettingsView() {
     settings_obj = lv_obj_create(info_window);
     lv_obj_set_size(settings_obj, INFO_WINDOW_WIDTH, INFO_WINDOW_HEIGHT);
     lv_obj_align(settings_obj, LV_ALIGN_TOP_LEFT, 0, 0);
-    lv_obj_set_style_bg_color(settings_obj, lv_color_hex(0x000000), LV_PART_MAIN);
-    lv_obj_set_style_bg_opa(settings_obj, LV_OPA_COVER, LV_PART_MAIN);
-    lv_obj_set_style_border_width(settings_obj, 0, LV_PART_MAIN);
-    lv_obj_set_style_pad_all(settings_obj, 20, LV_PART_MAIN);
+    lv_obj_add_style(settings_obj, &ui_style_view, LV_PART_MAIN);
+    lv_obj_add_style(settings_obj, &ui_style_page, LV_PART_MAIN);
     
     // Title label
     lv_obj_t *title_label = lv_label_create(settings_obj);
     lv_label_set_text(title_label, "Refresh Speed");
-    lv_obj_set_style_text_color(title_label, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-    lv_obj_set_style_text_font(title_label, &lv_font_montserrat_16, LV_PART_MAIN);
+    lv_obj_add_style(title_label, &ui_style_title, LV_PART_MAIN);
     lv_obj_align(title_label, LV_ALIGN_TOP_LEFT, 0, 0);
     
     // Left label (Fast/Insensitive)
     lv_obj_t *left_label = lv_label_create(settings_obj);
     lv_label_set_text(left_label, "Fast/Insensitive");
-    lv_obj_set_style_text_color(left_label, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-    lv_obj_set_style_text_font(left_label, &lv_font_montserrat_12, LV_PART_MAIN);
+    lv_obj_add_style(left_label, &ui_style_caption, LV_PART_MAIN);
     lv_obj_align(left_label, LV_ALIGN_TOP_LEFT, 0, 40);
     
     // Right label (Slow/Sensitive)
     lv_obj_t *right_label = lv_label_create(settings_obj);
     lv_label_set_text(right_label, "Slow/Sensitive");
-    lv_obj_set_style_text_color(right_label, lv_color_hex(0xFFFFFF), LV_PART_MAIN);
-    lv_obj_set_style_text_font(right_label, &lv_font_montserrat_12, LV_PART_MAIN);
+    lv_obj_add_style(right_label, &ui_style_caption, LV_PART_MAIN);
     lv_obj_align(right_label, LV_ALIGN_TOP_RIGHT, 0, 40);
     
     // Load saved slider value from non-volatile storage
-    // Convert old values (0-100 or 0-19) to new range (0-18) if needed
-    uint8_t saved_raw = loadScanSpeed(9);  // Default to 9 (1020ms, middle of new range)
-    uint8_t saved_slider_value = saved_raw;
-    if (saved_raw > 18) {
-        // Old value from previous version, convert to new range (0-18)
-        if (saved_raw > 19) {
-            // Very old value (0-100), convert to new range
-            saved_slider_value = (saved_raw * 18) / 100;
-        } else {
-            // Previous version (0-19), convert to new range (0-18)
-            saved_slider_value = (saved_raw * 18) / 19;
-        }
-    }
+    uint8_t saved_slider_value = loadScanSpeedSlider();
     
     // Create slider with discrete steps (0-18 = 19 positions, each 100ms from 120ms to 1920ms)
     // Range: 120ms to 1920ms in 100ms increments (matches ESP-IDF minimum of 120ms)
@@ -235,18 +328,232 @@ void createSettingsView() {
     lv_obj_set_style_bg_color(slider, lv_color_hex(0x007acc), LV_PART_INDICATOR);
     lv_obj_set_style_bg_color(slider, lv_color_hex(0x007acc), LV_PART_KNOB);
     
-    // Add event handlers
-    lv_obj_add_event_cb(slider, onRefreshSpeedChanged, LV_EVENT_VALUE_CHANGED, NULL);
+    // Apply and save once the knob is let go, not for every step it is dragged through
     lv_obj_add_event_cb(slider, onRefreshSpeedChanged, LV_EVENT_RELEASED, NULL);
     
-    // Initialize scan time based on slider's initial value
-    // Formula: 120ms + (value * 100ms) = 120ms to 1920ms in 100ms steps
-    extern uint16_t scan_time_per_channel_ms;
-    scan_time_per_channel_ms = 120 + (saved_slider_value * 100);
+    // Task stacks and heaps
+    lv_obj_t *diagnostics_btn = lv_btn_create(settings_obj);
+    lv_obj_add_style(diagnostics_btn, &ui_style_menu_btn, LV_PART_MAIN);
+    lv_obj_align(diagnostics_btn, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+    lv_obj_t *diagnostics_label = lv_label_create(diagnostics_btn);
+    lv_label_set_text(diagnostics_label, "Diagnostics");
+    lv_obj_center(diagnostics_label);
+    lv_obj_add_event_cb(diagnostics_btn, switchToDiagnosticsView, LV_EVENT_CLICKED, NULL);
     
     // Initially hidden (graph is default view)
     lv_obj_add_flag(settings_obj, LV_OBJ_FLAG_HIDDEN);
 }
 
+// Create waterfall view
+void createWaterfallView() {
+    if (info_window == NULL) return;
+    
+    // Plot image lives in PSRAM (allocated at boot); skip the view if it could not be
+    if (!waterfallInit()) return;
+    
+    waterfall_obj = lv_obj_create(info_window);
+    lv_obj_set_size(waterfall_obj, INFO_WINDOW_WIDTH, INFO_WINDOW_HEIGHT);
+    lv_obj_align(waterfall_obj, LV_ALIGN_TOP_LEFT, 0, 0);
+    lv_obj_add_style(waterfall_obj, &ui_style_view, LV_PART_MAIN);
+    lv_obj_clear_flag(waterfall_obj, LV_OBJ_FLAG_SCROLLABLE);
+    lv_obj_add_event_cb(waterfall_obj, waterfall_draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+    
+    // Initially hidden (graph is default view)
+    lv_obj_add_flag(waterfall_obj, LV_OBJ_FLAG_HIDDEN);
+}
+
+// Create RSSI history view
+void createHistoryView() {
+    if (info_window == NULL) return;
+    
+    history_obj = lv_obj_create(info_window);
+    lv_obj_set_size(history_obj, INFO_WINDOW_WIDTH, INFO_WINDOW_HEIGHT);
+    lv_obj_align(history_obj, LV_ALIGN_TOP_LEFT, 0, 0);
+    lv_obj_add_style(history_obj, &ui_style_view, LV_PART_MAIN);
+    lv_obj_clear_flag(history_obj, LV_OBJ_FLAG_SCROLLABLE);
+    
+    // Legend row: one coloured SSID per pinned network
+    history_legend = lv_obj_create(history_obj);
+    lv_obj_set_size(history_legend, INFO_WINDOW_WIDTH, 30);
+    lv_obj_align(history_legend, LV_ALIGN_TOP_LEFT, 0, 0);
+    lv_obj_add_style(history_legend, &ui_style_bar, LV_PART_MAIN);
+    lv_obj_set_style_pad_gap(history_legend, 12, LV_PART_MAIN);
+    lv_obj_set_flex_flow(history_legend, LV_FLEX_FLOW_ROW);
+    lv_obj_set_flex_align(history_legend, LV_FLEX_ALIGN_START, LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
+    lv_obj_clear_flag(history_legend, LV_OBJ_FLAG_SCROLLABLE);
+    
+    lv_obj_t *hint_label = lv_label_create(history_legend);
+    lv_label_set_text(hint_label, "Long-press a table row to pin it");
+    lv_obj_add_style(hint_label, &ui_style_axis_label, LV_PART_MAIN);
+    
+    // Chart reads the history rings in place; circular mode redraws only the newest column
+    history_chart = lv_chart_create(history_obj);
+    lv_obj_set_size(history_chart, INFO_WINDOW_WIDTH - GRAPH_LEFT_MARGIN - GRAPH_RIGHT_MARGIN, INFO_WINDOW_HEIGHT - 30 - GRAPH_BOTTOM_MARGIN);
+    lv_obj_align(history_chart, LV_ALIGN_TOP_LEFT, GRAPH_LEFT_MARGIN, 30 + GRAPH_TOP_OFFSET);
+    lv_chart_set_type(history_chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_update_mode(history_chart, LV_CHART_UPDATE_MODE_CIRCULAR);
+    lv_chart_set_point_count(history_chart, HISTORY_POINTS);
+    lv_chart_set_range(history_chart, LV_CHART_AXIS_PRIMARY_Y, RSSI_MIN, RSSI_MAX);
+    lv_chart_set_div_line_count(history_chart, (RSSI_MAX - RSSI_MIN) / 10 + 1, 0);
+    lv_chart_set_axis_tick(history_chart, LV_CHART_AXIS_PRIMARY_Y, 5, 2, (RSSI_MAX - RSSI_MIN) / 10 + 1, 1, true, 40);
+    
+    // Show HISTORY_VISIBLE_POINTS at a time and scroll horizontally over the rest
+    lv_chart_set_zoom_x(history_chart, 256 * HISTORY_POINTS / HISTORY_VISIBLE_POINTS);
+    lv_obj_set_scroll_dir(history_chart, LV_DIR_HOR);
+    
+    lv_obj_set_style_bg_color(history_chart, lv_color_hex(0x000000), LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(history_chart, LV_OPA_COVER, LV_PART_MAIN);
+    lv_obj_set_style_border_color(history_chart, lv_color_hex(0x444444), LV_PART_MAIN);
+    lv_obj_set_style_line_color(history_chart, lv_color_hex(0x333333), LV_PART_MAIN);
+    lv_obj_set_style_text_color(history_chart, lv_color_hex(0x888888), LV_PART_TICKS);
+    lv_obj_set_style_text_font(history_chart, &lv_font_montserrat_10, LV_PART_TICKS);
+    lv_obj_set_style_line_width(history_chart, 2, LV_PART_ITEMS);
+    lv_obj_set_style_size(history_chart, 0, LV_PART_INDICATOR);  // No point markers
+    
+    // Series and legend for networks pinned before the chart existed
+    rssiHistoryAttachChart();
+    
+    // Initially hidden (graph is default view)
+    lv_obj_add_flag(history_obj, LV_OBJ_FLAG_HIDDEN);
+}
 
+// Create dashboard view (the compact list; the graph above it is the shared graph_obj, shortened)
+void createDashboardView() {
+    if (info_window == NULL) return;
+    
+    dashboard_obj = dashboardViewCreate(info_window);
+    lv_obj_set_size(dashboard_obj, INFO_WINDOW_WIDTH, INFO_WINDOW_HEIGHT - DASHBOARD_GRAPH_HEIGHT);
+    lv_obj_align(dashboard_obj, LV_ALIGN_TOP_LEFT, 0, DASHBOARD_GRAPH_HEIGHT);
+    
+    // Initially hidden (graph is default view)
+    lv_obj_add_flag(dashboard_obj, LV_OBJ_FLAG_HIDDEN);
+}
+
+// Create AP detail view (opened from a table row)
+void createApDetailView() {
+    if (info_window == NULL) return;
+    
+    ap_detail_obj = apDetailViewCreate(info_window);
+    lv_obj_set_size(ap_detail_obj, INFO_WINDOW_WIDTH, INFO_WINDOW_HEIGHT);
+    lv_obj_align(ap_detail_obj, LV_ALIGN_TOP_LEFT, 0, 0);
+}
 
+// Create diagnostics view (opened from the settings view)
+void createDiagnosticsView() {
+    if (info_window == NULL) return;
+    
+    diagnostics_obj = diagnosticsViewCreate(info_window);
+    lv_obj_set_size(diagnostics_obj, INFO_WINDOW_WIDTH, INFO_WINDOW_HEIGHT);
+    lv_obj_align(diagnostics_obj, LV_ALIGN_TOP_LEFT, 0, 0);
+    
+    // Initially hidden (graph is default view)
+    lv_obj_add_flag(diagnostics_obj, LV_OBJ_FLAG_HIDDEN);
+}
+
+// Free a view's widgets (models and data rings live outside the views and stay current)
+static void destroyTableView() {
+    tableViewDetach();
+    lv_obj_del(table_header);
+    lv_obj_del(table_obj);
+    table_header = NULL;
+    table_obj = NULL;
+}
+
+static void destroyWaterfallView() {
+    lv_obj_del(waterfall_obj);
+    waterfall_obj = NULL;
+}
+
+static void destroyHistoryView() {
+    rssiHistoryDetachChart();
+    lv_obj_del(history_obj);
+    history_obj = NULL;
+    history_chart = NULL;
+    history_legend = NULL;
+}
+
+static void destroySettingsView() {
+    lv_obj_del(settings_obj);
+    settings_obj = NULL;
+}
+
+static void destroyApDetailView() {
+    apDetailViewDetach();
+    lv_obj_del(ap_detail_obj);
+    ap_detail_obj = NULL;
+}
+
+static void destroyDashboardView() {
+    dashboardViewDetach();
+    lv_obj_del(dashboard_obj);
+    dashboard_obj = NULL;
+}
+
+static void destroyDiagnosticsView() {
+    diagnosticsViewDetach();
+    lv_obj_del(diagnostics_obj);
+    diagnostics_obj = NULL;
+}
+
+// Views built on first navigation; the graph is built at boot and never freed
+struct LazyView {
+    lv_obj_t **root;
+    void (*create)();
+    void (*destroy)();
+    const char *create_event;
+    const char *destroy_event;
+};
+
+static const LazyView lazy_views[VIEW_COUNT] = {
+    {&graph_obj, NULL, NULL, NULL, NULL},
+    {&table_obj, createTableView, destroyTableView, "table view built", "table view freed"},
+    {&waterfall_obj, createWaterfallView, destroyWaterfallView, "waterfall view built", "waterfall view freed"},
+    {&history_obj, createHistoryView, destroyHistoryView, "history view built", "history view freed"},
+    {&settings_obj, createSettingsView, destroySettingsView, "settings view built", "settings view freed"},
+    {&dashboard_obj, createDashboardView, destroyDashboardView, "dashboard view built", "dashboard view freed"},
+    {&ap_detail_obj, createApDetailView, destroyApDetailView, "AP detail view built", "AP detail view freed"},
+    {&diagnostics_obj, createDiagnosticsView, destroyDiagnosticsView, "diagnostics view built", "diagnostics view freed"},
+};
+
+static UiView active_view = VIEW_GRAPH;
+static uint32_t hidden_since[VIEW_COUNT];
+
+// Build a view if it does not exist yet (call with the LVGL lock held); false if it could not be built
+bool ensureView(UiView view) {
+    const LazyView *lv = &lazy_views[view];
+    if (*lv->root != NULL) return true;
+    if (lv->create == NULL) return false;
+    
+    BootTraceSpan span;
+    bootTraceBegin(&span);
+    lv->create();
+    bootTraceEnd(lv->create_event, &span);
+    return *lv->root != NULL;
+}
+
+// Record which view is on screen; the previous one starts its hidden period
+void setActiveView(UiView view) {
+    if (view == active_view) return;
+    hidden_since[active_view] = lv_tick_get();
+    active_view = view;
+}
+
+// Free views that have been hidden for VIEW_DESTROY_AFTER_MS
+static void viewReaperCb(lv_timer_t *timer) {
+    for (int v = 0; v < VIEW_COUNT; v++) {
+        const LazyView *lv = &lazy_views[v];
+        if (v == active_view || lv->destroy == NULL || *lv->root == NULL) continue;
+        if (lv_tick_elaps(hidden_since[v]) < VIEW_DESTROY_AFTER_MS) continue;
+        
+        BootTraceSpan span;
+        bootTraceBegin(&span);
+        lv->destroy();
+        bootTraceEnd(lv->destroy_event, &span);
+    }
+}
+
+// Start freeing long-hidden views (no-op when VIEW_DESTROY_AFTER_MS is 0)
+void startViewReaper() {
+    if (VIEW_DESTROY_AFTER_MS == 0) return;
+    lv_timer_create(viewReaperCb, VIEW_REAPER_PERIOD_MS, NULL);
+}
@@ -13,18 +13,52 @@ extern lv_obj_t *vertical_axis_label;
 extern lv_obj_t *table_obj;
 extern lv_obj_t *table_header;
 extern lv_obj_t *settings_obj;
+extern lv_obj_t *waterfall_obj;
+extern lv_obj_t *history_obj;
+extern lv_obj_t *history_chart;
+extern lv_obj_t *history_legend;
+extern lv_obj_t *dashboard_obj;
+extern lv_obj_t *ap_detail_obj;
+extern lv_obj_t *diagnostics_obj;
 extern lv_obj_t *info_window;
 extern lv_obj_t *menu_bar;
 extern lv_obj_t *pause_btn;
 extern lv_obj_t *persistence_btn;
 extern lv_obj_t *graph_btn;
+extern lv_obj_t *dashboard_btn;
 extern lv_obj_t *table_btn;
+extern lv_obj_t *waterfall_btn;
+extern lv_obj_t *history_btn;
 extern lv_obj_t *settings_btn;
 
+// Views shown in the info window
+enum UiView {
+    VIEW_GRAPH,
+    VIEW_TABLE,
+    VIEW_WATERFALL,
+    VIEW_HISTORY,
+    VIEW_SETTINGS,
+    VIEW_DASHBOARD,
+    VIEW_AP_DETAIL,
+    VIEW_DIAGNOSTICS,
+    VIEW_COUNT
+};
+
 // Functions
+void initScanSettings();
 void createMenuBar(lv_obj_t *parent);
+void createGraphView(lv_obj_t *parent);
 void createTableView();
 void createSettingsView();
+void createWaterfallView();
+void createHistoryView();
+void createDashboardView();
+void createApDetailView();
+void createDiagnosticsView();
+void setGraphCompact(bool compact);
+bool ensureView(UiView view);
+void setActiveView(UiView view);
+void startViewReaper();
 
 #endif // UI_VIEWS_H
 
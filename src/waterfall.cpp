@@ -0,0 +1,213 @@
+/*
+ * Waterfall (spectrogram) view implementation
+ *
+ * The plot is a PSRAM image with one band of WATERFALL_ROW_HEIGHT lines per
+ * sweep. Bands are written into a ring: each sweep overwrites the oldest band
+ * in place and a marker on the last line of the newest band shows where "now"
+ * is, so nothing is ever moved and only the new band (plus the marker) is
+ * invalidated. The marker only hides a line of the newest band until the next
+ * sweep moves it on; every older band, including the one about to be
+ * overwritten, is shown in full.
+ */
+
+#include "waterfall.h"
+#include "config.h"
+#include <Arduino.h>
+#include "esp_heap_caps.h"
+#include <math.h>
+#include <string.h>
+
+// External UI objects (declared in ui_views.cpp)
+extern lv_obj_t *waterfall_obj;
+
+static lv_color_t *waterfall_buf = NULL;   // GRAPH_WIDTH x GRAPH_HEIGHT, RGB565 in PSRAM
+static lv_img_dsc_t waterfall_img;
+static uint16_t waterfall_head = 0;        // Next band to overwrite
+static lv_color_t rssi_colors[RSSI_MAX - RSSI_MIN + 1];
+static lv_color_t row_line[GRAPH_WIDTH];   // One pixel line of the band being written
+static float column_level[GRAPH_WIDTH];    // Per-column dBm (strongest) or mW (summed)
+
+// Map RSSI onto a black -> blue -> cyan -> yellow -> red heat scale
+static void buildColorMap() {
+    const int steps = RSSI_MAX - RSSI_MIN;
+    for (int i = 0; i <= steps; i++) {
+        int t = i * 1023 / steps;  // 0..1023 across four segments
+        uint8_t r, g, b;
+        if (t < 256) {
+            r = 0; g = 0; b = 64 + t * 191 / 255;
+        } else if (t < 512) {
+            r = 0; g = t - 256; b = 255;
+        } else if (t < 768) {
+            r = t - 512; g = 255; b = 767 - t;
+        } else {
+            r = 255; g = 1023 - t; b = 0;
+        }
+        rssi_colors[i] = lv_color_make(r, g, b);
+    }
+}
+
+// Allocate the PSRAM image (at boot, so the ring fills before the view is first built)
+bool waterfallInit() {
+    if (waterfall_buf != NULL) return true;
+    
+    size_t buf_size = GRAPH_WIDTH * GRAPH_HEIGHT * sizeof(lv_color_t);
+    waterfall_buf = (lv_color_t *)heap_caps_calloc(1, buf_size, MALLOC_CAP_SPIRAM);
+    if (waterfall_buf == NULL) {
+        printf("Waterfall: failed to allocate %u bytes in PSRAM\r\n", (unsigned)buf_size);
+        return false;
+    }
+    
+    // calloc'd RGB565 zero is black, which is the "no signal" colour
+    waterfall_img.header.always_zero = 0;
+    waterfall_img.header.w = GRAPH_WIDTH;
+    waterfall_img.header.h = GRAPH_HEIGHT;
+    waterfall_img.header.cf = LV_IMG_CF_TRUE_COLOR;
+    waterfall_img.data_size = buf_size;
+    waterfall_img.data = (const uint8_t *)waterfall_buf;
+    
+    buildColorMap();
+    return true;
+}
+
+// Plot line of the marker: last line of the band written before waterfall_head
+static int markerLine() {
+    uint16_t newest = (waterfall_head + WATERFALL_ROWS - 1) % WATERFALL_ROWS;
+    return newest * WATERFALL_ROW_HEIGHT + WATERFALL_ROW_HEIGHT - 1;
+}
+
+// Custom draw callback: axes, the ring image as-is and the "now" marker
+void waterfall_draw_cb(lv_event_t *e) {
+    lv_obj_t *obj = lv_event_get_target(e);
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+    
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    int plot_x = coords.x1 + GRAPH_LEFT_MARGIN;
+    int plot_y = coords.y1 + GRAPH_TOP_OFFSET;
+    
+    // Black background
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    rect_dsc.bg_opa = LV_OPA_COVER;
+    rect_dsc.bg_color = lv_color_hex(0x000000);
+    rect_dsc.border_width = 0;
+    lv_draw_rect(draw_ctx, &rect_dsc, &coords);
+    
+    // Spectrogram image (only the clipped part is blended)
+    if (waterfall_buf) {
+        lv_draw_img_dsc_t img_dsc;
+        lv_draw_img_dsc_init(&img_dsc);
+        lv_area_t img_area = {(lv_coord_t)plot_x, (lv_coord_t)plot_y,
+                              (lv_coord_t)(plot_x + GRAPH_WIDTH - 1), (lv_coord_t)(plot_y + GRAPH_HEIGHT - 1)};
+        lv_draw_img(draw_ctx, &img_dsc, &img_area, &waterfall_img);
+    }
+    
+    // "Now" marker on the last line of the newest band
+    int marker_y = plot_y + markerLine();
+    rect_dsc.bg_color = lv_color_hex(0xFFFFFF);
+    lv_area_t marker_area = {(lv_coord_t)plot_x, (lv_coord_t)marker_y, (lv_coord_t)(plot_x + GRAPH_WIDTH - 1), (lv_coord_t)marker_y};
+    lv_draw_rect(draw_ctx, &rect_dsc, &marker_area);
+    
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    label_dsc.font = &lv_font_montserrat_10;
+    label_dsc.color = lv_color_hex(0x888888);
+    lv_area_t now_area = {(lv_coord_t)(coords.x1 + 25), (lv_coord_t)(marker_y - 6), (lv_coord_t)(plot_x - 5), (lv_coord_t)(marker_y + 6)};
+    lv_draw_label(draw_ctx, &label_dsc, &now_area, "now", NULL);
+    
+    // Channel labels on bottom (same positions as the graph)
+    for (int ch = CHANNEL_MIN; ch <= CHANNEL_MAX; ch++) {
+        if (!((ch >= 1 && ch <= 11) || ch == 13)) continue;
+        char ch_label[4];
+        snprintf(ch_label, sizeof(ch_label), "%d", ch);
+        int x_pos = plot_x + ((ch - CHANNEL_MIN) * GRAPH_WIDTH / (CHANNEL_MAX - CHANNEL_MIN));
+        lv_area_t label_area = {(lv_coord_t)(x_pos - 7), (lv_coord_t)(plot_y + GRAPH_HEIGHT + 5),
+                                (lv_coord_t)(x_pos + 7), (lv_coord_t)(plot_y + GRAPH_HEIGHT + 20)};
+        lv_draw_label(draw_ctx, &label_dsc, &label_area, ch_label, NULL);
+    }
+    
+    label_dsc.font = &lv_font_montserrat_12;
+    const char *axis_title = "Wifi Channel";
+    int title_width = strlen(axis_title) * 8;
+    int title_x = plot_x + (GRAPH_WIDTH / 2) - (title_width / 2);
+    lv_area_t title_area = {(lv_coord_t)title_x, (lv_coord_t)(plot_y + GRAPH_HEIGHT + 18),
+                            (lv_coord_t)(title_x + title_width - 1), (lv_coord_t)(plot_y + GRAPH_HEIGHT + 35)};
+    lv_draw_label(draw_ctx, &label_dsc, &title_area, axis_title, NULL);
+}
+
+// Write one band for this sweep and invalidate only that band and the marker
+void updateWaterfall(const wifi_ap_record_t *ap_records, uint16_t ap_count) {
+    if (waterfall_buf == NULL) return;
+    
+    // Reduce the sweep to one level per pixel column
+    for (int x = 0; x < GRAPH_WIDTH; x++) {
+        column_level[x] = WATERFALL_SUM_POWER ? 0.0f : (float)(RSSI_MIN - 1);
+    }
+    for (uint16_t i = 0; i < ap_count; i++) {
+        int rssi = ap_records[i].rssi;
+        if (rssi < RSSI_MIN) continue;
+        if (rssi > RSSI_MAX) rssi = RSSI_MAX;
+        
+        float center_channel = ap_records[i].primary;
+        int width_channels = 4;  // 20MHz = 4 channels
+        if (ap_records[i].second == WIFI_SECOND_CHAN_ABOVE) {
+            center_channel += 2.0f;
+            width_channels = 8;
+        } else if (ap_records[i].second == WIFI_SECOND_CHAN_BELOW) {
+            center_channel -= 2.0f;
+            width_channels = 8;
+        }
+        
+        int x_center = (int)((center_channel - CHANNEL_MIN) * GRAPH_WIDTH / (float)(CHANNEL_MAX - CHANNEL_MIN));
+        int half_width = width_channels * GRAPH_WIDTH / (CHANNEL_MAX - CHANNEL_MIN) / 2;
+        int x_start = x_center - half_width;
+        int x_end = x_center + half_width;
+        if (x_start < 0) x_start = 0;
+        if (x_end > GRAPH_WIDTH - 1) x_end = GRAPH_WIDTH - 1;
+        
+        float level = WATERFALL_SUM_POWER ? powf(10.0f, rssi / 10.0f) : (float)rssi;
+        for (int x = x_start; x <= x_end; x++) {
+            if (WATERFALL_SUM_POWER) {
+                column_level[x] += level;
+            } else if (level > column_level[x]) {
+                column_level[x] = level;
+            }
+        }
+    }
+    for (int x = 0; x < GRAPH_WIDTH; x++) {
+        float level = column_level[x];
+        if (WATERFALL_SUM_POWER) {
+            level = (level > 0.0f) ? 10.0f * log10f(level) : (float)(RSSI_MIN - 1);
+        }
+        int rssi = (int)level;
+        if (rssi < RSSI_MIN) {
+            row_line[x] = lv_color_hex(0x000000);
+        } else {
+            if (rssi > RSSI_MAX) rssi = RSSI_MAX;
+            row_line[x] = rssi_colors[rssi - RSSI_MIN];
+        }
+    }
+    
+    // Overwrite the oldest band in place
+    uint16_t row = waterfall_head;
+    lv_color_t *dst = waterfall_buf + (size_t)row * WATERFALL_ROW_HEIGHT * GRAPH_WIDTH;
+    for (int line = 0; line < WATERFALL_ROW_HEIGHT; line++) {
+        memcpy(dst + line * GRAPH_WIDTH, row_line, sizeof(row_line));
+    }
+    waterfall_head = (row + 1) % WATERFALL_ROWS;
+    
+    // Invalidate the new band, which holds the marker now and borders the old one
+    if (waterfall_obj) {
+        lv_area_t coords;
+        lv_obj_get_coords(waterfall_obj, &coords);
+        int band_y = coords.y1 + GRAPH_TOP_OFFSET + row * WATERFALL_ROW_HEIGHT;
+        lv_area_t band_area = {coords.x1, (lv_coord_t)(band_y - 6), coords.x2, (lv_coord_t)(band_y + WATERFALL_ROW_HEIGHT + 6)};
+        lv_obj_invalidate_area(waterfall_obj, &band_area);
+        if (row == 0) {
+            // Wrapped: the old marker was on the last line of the last band
+            int marker_y = coords.y1 + GRAPH_TOP_OFFSET + WATERFALL_ROWS * WATERFALL_ROW_HEIGHT - 1;
+            lv_area_t marker_area = {coords.x1, (lv_coord_t)(marker_y - 6), coords.x2, (lv_coord_t)(marker_y + 6)};
+            lv_obj_invalidate_area(waterfall_obj, &marker_area);
+        }
+    }
+}
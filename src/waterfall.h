@@ -0,0 +1,16 @@
+/*
+ * Waterfall (spectrogram) view: channel occupancy over time
+ */
+
+#ifndef WATERFALL_H
+#define WATERFALL_H
+
+#include <lvgl.h>
+#include "esp_wifi.h"
+
+// Functions
+bool waterfallInit();
+void waterfall_draw_cb(lv_event_t *e);
+void updateWaterfall(const wifi_ap_record_t *ap_records, uint16_t ap_count);
+
+#endif // WATERFALL_H
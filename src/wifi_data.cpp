@@ -4,8 +4,15 @@
 
 #include "wifi_data.h"
 #include "config.h"
-#include "lvgl_port.h"
 #include "wifi_scanner.h"
+#include "graph_anim.h"
+#include "render_quality.h"
+#include "label_cache.h"
+#include "label_layout.h"
+#include "table_view.h"
+#include "graph_viewport.h"
+#include "graph_background.h"
+#include <Arduino.h>
 #include <math.h>
 #include <string.h>
 
@@ -13,6 +20,21 @@
 WiFiNetworkData wifi_networks[64];
 uint16_t wifi_network_count = 0;
 
+// Geometry displayed before the latest sweep (start points for the transition)
+static WiFiNetworkData previous_networks[64];
+static uint16_t previous_network_count = 0;
+
+// SSID label layout, recomputed only when the graph geometry changes
+static LabelLayoutItem label_items[64];
+static LabelBadge label_badges[LABEL_MAX_BADGES];
+static uint16_t label_network[64];      // wifi_networks index of each layout item
+static uint16_t label_item_count = 0;
+static uint16_t label_badge_count = 0;
+static bool labels_dirty = true;
+
+// Viewport version the pixel geometry in wifi_networks was computed for
+static uint32_t geometry_version = 0;
+
 // Persistent network storage (for persistence mode)
 PersistentNetwork persistent_networks[64];
 uint16_t persistent_network_count = 0;
@@ -20,26 +42,46 @@ uint16_t persistent_network_count = 0;
 // External UI objects (declared in ui_views.cpp)
 extern lv_obj_t *graph_obj;
 extern lv_obj_t *vertical_axis_label;
-extern lv_obj_t *table_obj;
+
+// Map a network's channel span and RSSI to pixels in the current viewport
+static void computeGeometry(WiFiNetworkData *net) {
+    net->x_center = graphChannelToX(net->center_channel);
+    net->width_target = graphChannelSpanToPixels(net->width_channels);
+    net->y_bottom = graphRssiToY(RSSI_MIN);
+    net->y_top_target = graphRssiToY(net->rssi);
+}
 
 // Custom draw callback for graph widget - uses Draw Layer API for efficient rendering
 void graph_draw_cb(lv_event_t *e) {
+    uint32_t draw_start_us = micros();
     lv_obj_t *obj = lv_event_get_target(e);
     lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
     
     // Get widget dimensions
     int obj_width = lv_obj_get_width(obj);
-    int obj_height = lv_obj_get_height(obj);
+    int obj_x = obj->coords.x1;
+    int obj_y = obj->coords.y1;
     int graph_y_offset = GRAPH_TOP_OFFSET;
+    int plot_bottom = graph_y_offset + graphPlotHeight();
+    
+    // The viewport moved (pinch/pan): rebuild pixel geometry and snap to it
+    if (geometry_version != graphViewportVersion()) {
+        for (uint16_t i = 0; i < wifi_network_count; i++) {
+            WiFiNetworkData *net = &wifi_networks[i];
+            computeGeometry(net);
+            net->y_top = net->y_top_target;
+            net->width_pixels = net->width_target;
+            net->animating = false;
+        }
+        geometry_version = graphViewportVersion();
+        labels_dirty = true;
+    }
     
-    // Draw black background
-    lv_draw_rect_dsc_t bg_dsc;
-    lv_draw_rect_dsc_init(&bg_dsc);
-    bg_dsc.bg_opa = LV_OPA_COVER;
-    bg_dsc.bg_color = lv_color_hex(0x000000);
-    bg_dsc.border_width = 0;
-    lv_area_t bg_area = {0, 0, obj_width - 1, obj_height - 1};
-    lv_draw_rect(draw_ctx, &bg_dsc, &bg_area);
+    // Axes, grid and scale labels (cached image unless the viewport is moving)
+    graphBackgroundDraw(draw_ctx);
+    
+    // Vertical axis title "RSSI (dB)" is now handled by a rotated label widget
+    // (created in ui_views.cpp, no need to draw it here)
     
     // Initialize draw descriptors
     lv_draw_rect_dsc_t rect_dsc;
@@ -49,89 +91,13 @@ void graph_draw_cb(lv_event_t *e) {
     lv_draw_label_dsc_t label_dsc;
     lv_draw_label_dsc_init(&label_dsc);
     
-    // Draw axes (bold lines)
-    rect_dsc.bg_color = lv_color_hex(0x444444);
-    rect_dsc.bg_opa = LV_OPA_COVER;
-    rect_dsc.border_width = 0;
-    
-    // Left axis (vertical)
-    lv_area_t left_axis = {GRAPH_LEFT_MARGIN - 1, graph_y_offset, GRAPH_LEFT_MARGIN, graph_y_offset + GRAPH_HEIGHT - 1};
-    lv_draw_rect(draw_ctx, &rect_dsc, &left_axis);
-    
-    // Bottom axis (horizontal)
-    lv_area_t bottom_axis = {GRAPH_LEFT_MARGIN, graph_y_offset + GRAPH_HEIGHT, GRAPH_LEFT_MARGIN + GRAPH_WIDTH - 1, graph_y_offset + GRAPH_HEIGHT + 1};
-    lv_draw_rect(draw_ctx, &rect_dsc, &bottom_axis);
-    
-    // Top border
-    lv_area_t top_axis = {GRAPH_LEFT_MARGIN, graph_y_offset, GRAPH_LEFT_MARGIN + GRAPH_WIDTH - 1, graph_y_offset + 1};
-    lv_draw_rect(draw_ctx, &rect_dsc, &top_axis);
-    
-    // Right border
-    lv_area_t right_axis = {GRAPH_LEFT_MARGIN + GRAPH_WIDTH, graph_y_offset, GRAPH_LEFT_MARGIN + GRAPH_WIDTH + 1, graph_y_offset + GRAPH_HEIGHT - 1};
-    lv_draw_rect(draw_ctx, &rect_dsc, &right_axis);
-    
-    // Draw RSSI scale labels on left
-    label_dsc.font = &lv_font_montserrat_10;
-    label_dsc.color = lv_color_hex(0x888888);
-    char rssi_label[8];
-    for (int rssi = RSSI_MIN; rssi <= RSSI_MAX; rssi += 10) {
-        snprintf(rssi_label, sizeof(rssi_label), "%d", rssi);
-        int y_pos = graph_y_offset + GRAPH_HEIGHT - ((rssi - RSSI_MIN) * GRAPH_HEIGHT / (RSSI_MAX - RSSI_MIN));
-        lv_area_t label_area = {25, y_pos - 5, 75, y_pos + 5};
-        lv_draw_label(draw_ctx, &label_dsc, &label_area, rssi_label, NULL);
-    }
-    
-    // Draw channel labels on bottom
-    for (int ch = CHANNEL_MIN; ch <= CHANNEL_MAX; ch++) {
-        char ch_label[4];
-        snprintf(ch_label, sizeof(ch_label), "%d", ch);
-        int x_pos = GRAPH_LEFT_MARGIN + ((ch - CHANNEL_MIN) * GRAPH_WIDTH / (CHANNEL_MAX - CHANNEL_MIN));
-        
-        if ((ch >= 1 && ch <= 11) || ch == 13) {
-            label_dsc.color = lv_color_hex(0x888888);
-            int label_len = strlen(ch_label);
-            int estimated_text_width = label_len * 7;
-            if (estimated_text_width < 14) estimated_text_width = 14;
-            int text_x_start = x_pos - (estimated_text_width / 2);
-            lv_area_t label_area = {text_x_start, graph_y_offset + GRAPH_HEIGHT + 5, text_x_start + estimated_text_width - 1, graph_y_offset + GRAPH_HEIGHT + 20};
-            lv_draw_label(draw_ctx, &label_dsc, &label_area, ch_label, NULL);
-        }
-    }
-    
-    // Draw horizontal axis title "Wifi Channel"
-    label_dsc.color = lv_color_hex(0x888888);
-    label_dsc.font = &lv_font_montserrat_12;
-    const char* axis_title = "Wifi Channel";
-    int title_width = strlen(axis_title) * 8;
-    int horizontal_title_x = GRAPH_LEFT_MARGIN + (GRAPH_WIDTH / 2) - (title_width / 2);
-    lv_area_t title_area = {horizontal_title_x, graph_y_offset + GRAPH_HEIGHT + 18, horizontal_title_x + title_width - 1, graph_y_offset + GRAPH_HEIGHT + 35};
-    lv_draw_label(draw_ctx, &label_dsc, &title_area, axis_title, NULL);
-    
-    // Vertical axis title "RSSI (dB)" is now handled by a rotated label widget
-    // (created in main.cpp, no need to draw it here)
-    
-    // Draw gridlines using dashed lines (much more efficient!)
-    line_dsc.color = lv_color_hex(0x333333);
-    line_dsc.width = 1;
-    line_dsc.opa = LV_OPA_COVER;
-    line_dsc.dash_width = 2;  // 2 pixel dashes
-    line_dsc.dash_gap = 2;    // 2 pixel gaps
-    
-    // Draw vertical gridlines for channels 0-15
-    for (int ch = 0; ch <= 15; ch++) {
-        int x_pos = GRAPH_LEFT_MARGIN + ((ch - CHANNEL_MIN) * GRAPH_WIDTH / (CHANNEL_MAX - CHANNEL_MIN));
-        lv_point_t p1 = {x_pos, graph_y_offset};
-        lv_point_t p2 = {x_pos, graph_y_offset + GRAPH_HEIGHT};
-        lv_draw_line(draw_ctx, &line_dsc, &p1, &p2);
-    }
-    
-    // Draw horizontal gridlines every 10 dB
-    for (int rssi = RSSI_MIN; rssi <= RSSI_MAX; rssi += 10) {
-        int y_pos = graph_y_offset + GRAPH_HEIGHT - ((rssi - RSSI_MIN) * GRAPH_HEIGHT / (RSSI_MAX - RSSI_MIN));
-        lv_point_t p1 = {GRAPH_LEFT_MARGIN, y_pos};
-        lv_point_t p2 = {GRAPH_LEFT_MARGIN + GRAPH_WIDTH, y_pos};
-        lv_draw_line(draw_ctx, &line_dsc, &p1, &p2);
-    }
+    // Clip the ovals to the plot (plus the outline width) so zoomed-in shapes do not spill over the axes
+    lv_area_t plot_area = {(lv_coord_t)(GRAPH_LEFT_MARGIN - 1), (lv_coord_t)(graph_y_offset - 1),
+                           (lv_coord_t)(GRAPH_LEFT_MARGIN + GRAPH_WIDTH + 1), (lv_coord_t)(plot_bottom + 1)};
+    lv_area_t plot_clip;
+    const lv_area_t *saved_clip = draw_ctx->clip_area;
+    bool plot_visible = _lv_area_intersect(&plot_clip, saved_clip, &plot_area);
+    draw_ctx->clip_area = &plot_clip;
     
     // Draw WiFi networks as half-ovals using rectangles with transparency
     const lv_color_t network_palette[] = {
@@ -140,77 +106,101 @@ void graph_draw_cb(lv_event_t *e) {
     };
     const uint8_t palette_size = sizeof(network_palette) / sizeof(network_palette[0]);
     
-    for (uint16_t i = 0; i < wifi_network_count; i++) {
+    RenderQuality quality = renderQualityGet();
+    
+    for (uint16_t i = 0; plot_visible && i < wifi_network_count; i++) {
         WiFiNetworkData *net = &wifi_networks[i];
         
         int oval_height = net->y_bottom - net->y_top;
         if (oval_height <= 0) continue;
         
-        // Draw filled half-oval with transparency using rectangles with opacity
-        rect_dsc.bg_color = net->color;
-        rect_dsc.bg_opa = LV_OPA_10;  // 10% opacity (built-in support!)
-        rect_dsc.border_width = 0;
+        // Only walk the rows that fall inside the plot
+        int row_first = (net->y_top < graph_y_offset) ? graph_y_offset : net->y_top;
+        int row_last = (net->y_bottom > plot_bottom) ? plot_bottom : net->y_bottom;
+        if (row_last < row_first) continue;
         
-        // Draw the fill using horizontal rectangles (parabolic shape)
-        for (int y = net->y_top; y <= net->y_bottom; y++) {
-            float progress = (float)(y - net->y_top) / (float)oval_height;
-            float width_factor = sqrt(progress);
-            int width_at_y = (int)(net->width_pixels * width_factor);
-            int x_start = net->x_center - width_at_y / 2;
-            int x_end = net->x_center + width_at_y / 2;
-            
-            // Clamp to graph bounds
-            if (x_start < GRAPH_LEFT_MARGIN) x_start = GRAPH_LEFT_MARGIN;
-            if (x_end > GRAPH_LEFT_MARGIN + GRAPH_WIDTH) x_end = GRAPH_LEFT_MARGIN + GRAPH_WIDTH;
-            if (x_end <= x_start) continue;
+        // Cheapest tier: one solid bar at the channel centre
+        if (quality == QUALITY_BARS) {
+            rect_dsc.bg_color = net->color;
+            rect_dsc.bg_opa = LV_OPA_COVER;
+            rect_dsc.border_width = 0;
+            lv_area_t bar_area = {(lv_coord_t)(net->x_center - 1), (lv_coord_t)row_first,
+                                  (lv_coord_t)(net->x_center + 1), (lv_coord_t)row_last};
+            lv_draw_rect(draw_ctx, &rect_dsc, &bar_area);
+            continue;
+        }
+        
+        // Translucent fill, full quality only (invisible under dense overlap anyway)
+        if (quality == QUALITY_FULL) {
+            // Draw filled half-oval with transparency using rectangles with opacity
+            rect_dsc.bg_color = net->color;
+            rect_dsc.bg_opa = LV_OPA_10;  // 10% opacity (built-in support!)
+            rect_dsc.border_width = 0;
             
-            lv_area_t fill_area = {x_start, y, x_end - 1, y};
-            lv_draw_rect(draw_ctx, &rect_dsc, &fill_area);
+            // Draw the fill using horizontal rectangles (parabolic shape)
+            for (int y = row_first; y <= row_last; y++) {
+                float progress = (float)(y - net->y_top) / (float)oval_height;
+                float width_factor = sqrt(progress);
+                int width_at_y = (int)(net->width_pixels * width_factor);
+                int x_start = net->x_center - width_at_y / 2;
+                int x_end = net->x_center + width_at_y / 2;
+                
+                // Clamp to graph bounds
+                if (x_start < GRAPH_LEFT_MARGIN) x_start = GRAPH_LEFT_MARGIN;
+                if (x_end > GRAPH_LEFT_MARGIN + GRAPH_WIDTH) x_end = GRAPH_LEFT_MARGIN + GRAPH_WIDTH;
+                if (x_end <= x_start) continue;
+                
+                lv_area_t fill_area = {x_start, y, x_end - 1, y};
+                lv_draw_rect(draw_ctx, &rect_dsc, &fill_area);
+            }
         }
         
         // Draw outline with lines
         line_dsc.color = net->color;
-        line_dsc.width = 2;
+        line_dsc.width = (quality == QUALITY_FULL) ? 2 : 1;
         line_dsc.opa = LV_OPA_COVER;
         line_dsc.dash_width = 0;  // Solid line for outline
         line_dsc.dash_gap = 0;
         
         // Draw left edge (curved)
-        int prev_x = -1, prev_y = -1;
-        for (int y = net->y_top; y <= net->y_bottom; y++) {
+        int prev_x = 0, prev_y = 0;
+        bool have_prev = false;
+        for (int y = row_first; y <= row_last; y++) {
             float progress = (float)(y - net->y_top) / (float)oval_height;
             float width_factor = sqrt(progress);
             int width_at_y = (int)(net->width_pixels * width_factor);
             int x_edge = net->x_center - width_at_y / 2;
             
-            if (prev_x >= 0 && prev_y >= 0) {
+            if (have_prev) {
                 lv_point_t p1 = {prev_x, prev_y};
                 lv_point_t p2 = {x_edge, y};
                 lv_draw_line(draw_ctx, &line_dsc, &p1, &p2);
             }
             prev_x = x_edge;
             prev_y = y;
+            have_prev = true;
         }
         
         // Draw right edge (curved)
-        prev_x = -1;
-        prev_y = -1;
-        for (int y = net->y_top; y <= net->y_bottom; y++) {
+        have_prev = false;
+        for (int y = row_first; y <= row_last; y++) {
             float progress = (float)(y - net->y_top) / (float)oval_height;
             float width_factor = sqrt(progress);
             int width_at_y = (int)(net->width_pixels * width_factor);
             int x_edge = net->x_center + width_at_y / 2;
             
-            if (prev_x >= 0 && prev_y >= 0) {
+            if (have_prev) {
                 lv_point_t p1 = {prev_x, prev_y};
                 lv_point_t p2 = {x_edge, y};
                 lv_draw_line(draw_ctx, &line_dsc, &p1, &p2);
             }
             prev_x = x_edge;
             prev_y = y;
+            have_prev = true;
         }
         
-        // Draw bottom edge (straight line)
+        // Draw bottom edge (straight line, below the plot when zoomed in vertically)
+        if (net->y_bottom > plot_bottom) continue;
         int x_start = net->x_center - net->width_pixels / 2;
         int x_end = net->x_center + net->width_pixels / 2;
         if (x_start < GRAPH_LEFT_MARGIN) x_start = GRAPH_LEFT_MARGIN;
@@ -220,36 +210,70 @@ void graph_draw_cb(lv_event_t *e) {
             lv_point_t p2 = {x_end, net->y_bottom};
             lv_draw_line(draw_ctx, &line_dsc, &p1, &p2);
         }
+    }
+    
+    draw_ctx->clip_area = saved_clip;
+    
+    // Labels are dropped in the outline-only and bar tiers
+    if (quality <= QUALITY_OUTLINE_LABELS) {
+        // Place SSID labels without overlap (once per geometry change, not per draw area)
+        if (labels_dirty) {
+            // Only networks whose peak is inside the zoomed plot get a label
+            label_item_count = 0;
+            for (uint16_t i = 0; i < wifi_network_count; i++) {
+                WiFiNetworkData *net = &wifi_networks[i];
+                if (net->x_center < GRAPH_LEFT_MARGIN || net->x_center > GRAPH_LEFT_MARGIN + GRAPH_WIDTH) continue;
+                if (net->y_top >= plot_bottom) continue;
+                LabelLayoutItem *item = &label_items[label_item_count];
+                item->anchor_x = net->x_center;
+                item->anchor_y = (net->y_top < graph_y_offset) ? graph_y_offset : net->y_top;
+                item->width = net->label_width;
+                item->height = net->label_height;
+                label_network[label_item_count++] = i;
+            }
+            label_badge_count = layoutLabels(label_items, label_item_count, 0, 0, obj_width - 1,
+                                             plot_bottom, label_badges, LABEL_MAX_BADGES);
+            labels_dirty = false;
+        }
         
-        // Draw SSID label above the network
-        label_dsc.color = net->color;
+        // Draw placed SSID labels from the pre-rendered bitmap cache
+        for (uint16_t i = 0; i < label_item_count; i++) {
+            if (!label_items[i].placed) continue;
+            WiFiNetworkData *net = &wifi_networks[label_network[i]];
+            lv_area_t ssid_area = {(lv_coord_t)(obj_x + label_items[i].x), (lv_coord_t)(obj_y + label_items[i].y),
+                                   (lv_coord_t)(obj_x + label_items[i].x + label_items[i].width - 1),
+                                   (lv_coord_t)(obj_y + label_items[i].y + label_items[i].height - 1)};
+            labelCacheDraw(draw_ctx, &ssid_area, net->ssid, &lv_font_montserrat_10, net->color);
+        }
+        
+        // Labels that did not fit collapse into "+N" badges
         label_dsc.font = &lv_font_montserrat_10;
+        label_dsc.color = lv_color_hex(0xCCCCCC);
         label_dsc.opa = LV_OPA_COVER;
-        int text_len = strlen(net->ssid);
-        int estimated_text_width = text_len * 7;
-        if (estimated_text_width < 50) estimated_text_width = 50;
-        int text_x_start = net->x_center - (estimated_text_width / 2);
-        if (text_x_start < 0) text_x_start = 0;
-        if (text_x_start + estimated_text_width > obj_width) {
-            text_x_start = obj_width - estimated_text_width;
-            if (text_x_start < 0) {
-                text_x_start = 0;
-                estimated_text_width = obj_width;
-            }
+        for (uint16_t b = 0; b < label_badge_count; b++) {
+            char badge_text[8];
+            snprintf(badge_text, sizeof(badge_text), "+%u", label_badges[b].count);
+            lv_area_t badge_area = {(lv_coord_t)(obj_x + label_badges[b].x), (lv_coord_t)(obj_y + label_badges[b].y),
+                                    (lv_coord_t)(obj_x + label_badges[b].x + 30), (lv_coord_t)(obj_y + label_badges[b].y + 12)};
+            lv_draw_label(draw_ctx, &label_dsc, &badge_area, badge_text, NULL);
         }
-        lv_area_t ssid_area = {text_x_start, net->y_top - 15, text_x_start + estimated_text_width - 1, net->y_top};
-        lv_draw_label(draw_ctx, &label_dsc, &ssid_area, net->ssid, NULL);
     }
+    
+    // Feed the animation frame-budget and quality controllers
+    uint32_t draw_us = micros() - draw_start_us;
+    graphAnimAddDrawTime(draw_us);
+    renderQualityAddDrawTime(draw_us);
 }
 
-// Update the WiFi graph on screen - now just stores data and invalidates the widget
-void updateWiFiGraph(wifi_ap_record_t *ap_records, uint16_t ap_count) {
+// Update the WiFi graph on screen - now just stores data and invalidates the widget (LVGL task)
+void updateWiFiGraph(const ScanSnapshot *snapshot) {
     if (graph_obj == NULL) return;
     
-    lvgl_port_lock(-1);
+    // Remember what is on screen now so each network can morph from it
+    memcpy(previous_networks, wifi_networks, sizeof(WiFiNetworkData) * wifi_network_count);
+    previous_network_count = wifi_network_count;
     
-    // Limit to max 64 networks
-    if (ap_count > 64) ap_count = 64;
+    uint16_t ap_count = snapshot->count;
     wifi_network_count = ap_count;
     
     // Color palette for networks
@@ -259,123 +283,61 @@ void updateWiFiGraph(wifi_ap_record_t *ap_records, uint16_t ap_count) {
     };
     const uint8_t palette_size = sizeof(network_palette) / sizeof(network_palette[0]);
     
-    int graph_y_offset = GRAPH_TOP_OFFSET;
-    
-    // Store network data for draw callback
+    // Store network data for draw callback (span, SSID and label size come from the snapshot)
     for (uint16_t i = 0; i < ap_count; i++) {
+        const SnapshotNetwork *src = &snapshot->networks[i];
         WiFiNetworkData *net = &wifi_networks[i];
         
-        int rssi = ap_records[i].rssi;
-        uint8_t channel = ap_records[i].primary;
-        wifi_second_chan_t second = ap_records[i].second;
-        
         // Clamp RSSI to valid range
+        int rssi = src->rssi;
         if (rssi < RSSI_MIN) rssi = RSSI_MIN;
         if (rssi > RSSI_MAX) rssi = RSSI_MAX;
         
-        // Calculate center channel and width
-        float center_channel = channel;
-        int width_channels = 4;  // Default 20MHz = 4 channels
-        
-        if (second == WIFI_SECOND_CHAN_ABOVE) {
-            center_channel = channel + 2.0f;
-            width_channels = 8;
-        } else if (second == WIFI_SECOND_CHAN_BELOW) {
-            center_channel = channel - 2.0f;
-            width_channels = 8;
-        }
-        
-        // Calculate positions
-        net->x_center = GRAPH_LEFT_MARGIN + (int)((center_channel - CHANNEL_MIN) * GRAPH_WIDTH / (float)(CHANNEL_MAX - CHANNEL_MIN));
-        net->width_pixels = (width_channels * GRAPH_WIDTH / (CHANNEL_MAX - CHANNEL_MIN));
-        net->y_bottom = graph_y_offset + GRAPH_HEIGHT;
-        net->y_top = graph_y_offset + GRAPH_HEIGHT - ((rssi - RSSI_MIN) * GRAPH_HEIGHT / (RSSI_MAX - RSSI_MIN));
-        
         // Store network properties
         net->rssi = rssi;
-        net->channel = channel;
-        net->second = second;
-        net->center_channel = center_channel;
-        net->width_channels = width_channels;
+        net->channel = src->channel;
+        net->second = src->second;
+        net->center_channel = src->center_channel;
+        net->width_channels = src->width_channels;
         net->color = network_palette[i % palette_size];
+        memcpy(net->ssid, src->ssid, sizeof(net->ssid));
+        net->label_width = src->label_width;
+        net->label_height = src->label_height;
+        
+        // Rasterize the label now, outside refresh, so the draw callback only blits it
+        labelCachePrepare(net->ssid, &lv_font_montserrat_10, net->color);
         
-        // Store SSID
-        int ssidLen = strlen((char*)ap_records[i].ssid);
-        if (ssidLen == 0 || ssidLen > 32) {
-            strcpy(net->ssid, "(hidden)");
-        } else {
-            memcpy(net->ssid, ap_records[i].ssid, ssidLen);
-            net->ssid[ssidLen] = '\0';
+        // Calculate positions in the current viewport
+        computeGeometry(net);
+        
+        // Transition start: previous geometry of the same BSSID, or grow up from the baseline
+        memcpy(net->bssid, src->bssid, 6);
+        net->y_top_from = net->y_bottom;
+        net->width_from = net->width_target;
+        for (uint16_t j = 0; j < previous_network_count; j++) {
+            if (memcmp(previous_networks[j].bssid, net->bssid, 6) == 0) {
+                net->y_top_from = previous_networks[j].y_top;
+                net->width_from = previous_networks[j].width_pixels;
+                break;
+            }
         }
     }
+    geometry_version = graphViewportVersion();
+    labels_dirty = true;
     
-    // Invalidate the widget to trigger redraw
+    // Animate from the previous geometry and trigger redraw
+    graphAnimStart();
     lv_obj_invalidate(graph_obj);
-    
-    lvgl_port_unlock();
 }
 
-// Update the WiFi table view
-void updateWiFiTable(wifi_ap_record_t *ap_records, uint16_t ap_count) {
-    if (table_obj == NULL) return;
-    
-    lvgl_port_lock(-1);
-    
-    // Limit to max 64 networks
-    if (ap_count > 64) ap_count = 64;
-    
-    // Set row count: only data rows (no header row in table)
-    lv_table_set_row_cnt(table_obj, ap_count);
-    
-    // Set column count
-    lv_table_set_col_cnt(table_obj, 5);
-    
-    // Set column widths (in pixels) - maximize use of 640px width
-    // Total available: 640px - 10px padding = 630px
-    // "WPA2 Enterprise" needs ~140px, RSSI and Width need more space
-    lv_table_set_col_width(table_obj, 0, 220);  // SSID (slightly wider)
-    lv_table_set_col_width(table_obj, 1, 60);    // Channel
-    lv_table_set_col_width(table_obj, 2, 85);    // RSSI (wider)
-    lv_table_set_col_width(table_obj, 3, 95);    // Width (wider)
-    lv_table_set_col_width(table_obj, 4, 150);   // Security (wide enough for "WPA2 Enterprise")
-    // Total: 220 + 60 + 85 + 95 + 150 = 610px (leaves 20px for scrollbar/margins)
-    
-    // Populate data rows (no header row - it's fixed above)
-    for (uint16_t i = 0; i < ap_count; i++) {
-        // Extract SSID
-        char ssidBuf[33];
-        int ssidLen = strlen((char*)ap_records[i].ssid);
-        if (ssidLen == 0 || ssidLen > 32) {
-            strcpy(ssidBuf, "(hidden)");
-        } else {
-            memcpy(ssidBuf, ap_records[i].ssid, ssidLen);
-            ssidBuf[ssidLen] = '\0';
-        }
-        
-        // Truncate SSID if too long
-        if (strlen(ssidBuf) > 25) {
-            ssidBuf[25] = '\0';
-        }
-        
-        int rssi = ap_records[i].rssi;
-        uint8_t channel = ap_records[i].primary;
-        wifi_second_chan_t second = ap_records[i].second;
-        wifi_auth_mode_t encryption = ap_records[i].authmode;
-        
-        char rssiStr[8];
-        char chStr[4];
-        snprintf(rssiStr, sizeof(rssiStr), "%d", rssi);
-        snprintf(chStr, sizeof(chStr), "%d", channel);
-        
-        // Set table cell values (row i, no header row in table)
-        lv_table_set_cell_value(table_obj, i, 0, ssidBuf);
-        lv_table_set_cell_value(table_obj, i, 1, chStr);
-        lv_table_set_cell_value(table_obj, i, 2, rssiStr);
-        lv_table_set_cell_value(table_obj, i, 3, getChannelWidthString(second));
-        lv_table_set_cell_value(table_obj, i, 4, getEncryptionTypeString(encryption));
-    }
-    
-    lvgl_port_unlock();
+// Update the WiFi table model (and its widgets, if the view has been built; LVGL task)
+void updateWiFiTable(const ScanSnapshot *snapshot) {
+    tableViewUpdate(snapshot);
+}
+
+// Geometry changed outside updateWiFiGraph (e.g. during a transition)
+void markGraphLabelsDirty() {
+    labels_dirty = true;
 }
 
 // Helper function to compare BSSIDs (MAC addresses)
@@ -401,9 +363,8 @@ void clearPersistentNetworks() {
 // - Adds new networks to the persistent list
 // - Updates existing networks (keeps max RSSI)
 // - Keeps networks not found in current scan
-void mergeScanResultsWithPersistent(wifi_ap_record_t *ap_records, uint16_t ap_count, wifi_ap_record_t *merged_records, uint16_t *merged_count) {
-    extern bool persistence_enabled;
-    
+void mergeScanResultsWithPersistent(wifi_ap_record_t *ap_records, uint16_t ap_count, bool persistence_enabled,
+                                    wifi_ap_record_t *merged_records, uint16_t *merged_count) {
     // If persistence is disabled, just copy scan results directly
     if (!persistence_enabled) {
         if (ap_count > 64) ap_count = 64;
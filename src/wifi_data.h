@@ -7,6 +7,7 @@
 
 #include <lvgl.h>
 #include "esp_wifi.h"
+#include "scan_snapshot.h"
 
 // WiFi network data structure for draw callback
 struct WiFiNetworkData {
@@ -17,10 +18,18 @@ struct WiFiNetworkData {
     int width_channels;
     lv_color_t color;
     char ssid[33];
+    uint8_t bssid[6];
     int x_center;
-    int y_top;
+    int y_top;            // Displayed top (interpolated during transitions)
     int y_bottom;
-    int width_pixels;
+    int width_pixels;     // Displayed width (interpolated during transitions)
+    int y_top_from;       // Geometry at the start of the transition
+    int width_from;
+    int y_top_target;     // Geometry computed from the latest sweep
+    int width_target;
+    bool animating;       // false = snapped to target (far-away network or no change)
+    int label_width;      // SSID label size from the font metrics
+    int label_height;
 };
 
 // Global WiFi network data (extern declarations)
@@ -38,10 +47,12 @@ struct PersistentNetwork {
 
 // Functions
 void graph_draw_cb(lv_event_t *e);
-void updateWiFiGraph(wifi_ap_record_t *ap_records, uint16_t ap_count);
-void updateWiFiTable(wifi_ap_record_t *ap_records, uint16_t ap_count);
-void mergeScanResultsWithPersistent(wifi_ap_record_t *ap_records, uint16_t ap_count, wifi_ap_record_t *merged_records, uint16_t *merged_count);
+void updateWiFiGraph(const ScanSnapshot *snapshot);
+void updateWiFiTable(const ScanSnapshot *snapshot);
+void mergeScanResultsWithPersistent(wifi_ap_record_t *ap_records, uint16_t ap_count, bool persistence_enabled,
+                                    wifi_ap_record_t *merged_records, uint16_t *merged_count);
 void clearPersistentNetworks();
+void markGraphLabelsDirty();
 
 #endif // WIFI_DATA_H
 
@@ -1,9 +1,17 @@
 /*
  * WiFi scanning functionality implementation
+ *
+ * Runs in the Arduino loop task and owns the scan settings (pause,
+ * persistence, dwell time, AP detail target). The UI changes them only by
+ * sending commands over the UI bus, and results go back to the UI the same
+ * way, so the scanner never takes the LVGL lock.
  */
 
 #include "wifi_scanner.h"
 #include "wifi_data.h"
+#include "scan_snapshot.h"
+#include "ui_bus.h"
+#include "perf_monitor.h"
 #include "config.h"
 #include <Arduino.h>
 #include <WiFi.h>
@@ -13,8 +21,61 @@
 static wifi_ap_record_t scan_ap_records[64];
 static wifi_ap_record_t scan_merged_records[64];
 
-// WiFi scan time per channel in milliseconds (0.25s to 2s, default 1.125s)
-uint16_t scan_time_per_channel_ms = 1125;  // Default to middle value
+// Scanner-owned state, changed only by commands from the UI
+static uint16_t scan_time_per_channel_ms = 1125;  // WiFi scan time per channel in ms (default: middle value)
+static uint16_t scan_interval_ms = SCAN_INTERVAL_MS;  // Pause between sweeps (longer while the UI is idle)
+static bool scan_paused = false;
+static bool persistence_enabled = false;          // Persistence mode: maintain growing list of networks
+static bool detail_active = false;                // Focused scans of one AP instead of full sweeps
+static uint8_t detail_bssid[6];
+static uint8_t detail_channel = 0;
+
+// Apply queued UI commands, waiting up to wait_ms for the first one
+void processScanCommands(uint32_t wait_ms) {
+    ScanCommand command;
+    while (uiBusReceiveCommand(&command, wait_ms)) {
+        wait_ms = 0;
+        switch (command.type) {
+            case SCAN_CMD_PAUSE:
+                scan_paused = command.value != 0;
+                break;
+            case SCAN_CMD_PERSISTENCE:
+                // Start a fresh list either way: an off and on again may arrive coalesced as a single on
+                persistence_enabled = command.value != 0;
+                clearPersistentNetworks();
+                break;
+            case SCAN_CMD_SCAN_TIME:
+                scan_time_per_channel_ms = command.value;
+                break;
+            case SCAN_CMD_DETAIL_OPEN:
+                memcpy(detail_bssid, command.bssid, 6);
+                detail_channel = (uint8_t)command.value;
+                detail_active = true;
+                break;
+            case SCAN_CMD_DETAIL_CLOSE:
+                detail_active = false;
+                break;
+            case SCAN_CMD_INTERVAL:
+                scan_interval_ms = command.value;
+                break;
+            case SCAN_CMD_COUNT:
+                break;
+        }
+    }
+}
+
+bool scannerPaused() {
+    return scan_paused;
+}
+
+uint32_t scannerInterval() {
+    return scan_interval_ms;
+}
+
+// True while the AP detail screen wants focused scans (and the AP's channel is known)
+bool scannerDetailActive() {
+    return detail_active && detail_channel != 0;
+}
 
 // Helper function to get encryption type as string
 const char* getEncryptionTypeString(wifi_auth_mode_t encryptionType) {
@@ -120,12 +181,22 @@ void performWiFiScan()
         return;
     }
     
+    // The UI may still be reading the previous sweep out of these buffers
+    if (!uiBusAcquireRecords(UI_BUS_RECORDS_WAIT_MS)) {
+        Serial.println("UI busy, sweep dropped");
+        return;
+    }
+    UiEvent event = {UI_EVENT_SWEEP, scan_ap_records, 0, false};
+    
     // Retrieve scan results (use static buffer to avoid stack overflow)
     uint16_t ap_count = 64;
     esp_err_t err = esp_wifi_scan_get_ap_records(&ap_count, scan_ap_records);
     
     if (err != ESP_OK || ap_count == 0) {
         Serial.println("No networks found.");
+        // An empty sweep is still a row of the waterfall's time axis
+        uiBusPostEvent(&event);
+        perfMonitorScan(millis() - scan_start_time);
         return;
     }
     
@@ -145,13 +216,44 @@ void performWiFiScan()
     // Merge scan results with persistent list (if persistence mode is enabled)
     // Use static buffer to avoid stack overflow
     uint16_t merged_count = 0;
-    mergeScanResultsWithPersistent(scan_ap_records, ap_count, scan_merged_records, &merged_count);
+    mergeScanResultsWithPersistent(scan_ap_records, ap_count, persistence_enabled, scan_merged_records, &merged_count);
     
     // Print debug table to serial (use merged results)
     printWiFiTableDebug(scan_merged_records, merged_count);
     
-    // Update the display graph and table (use merged results)
-    updateWiFiGraph(scan_merged_records, merged_count);
-    updateWiFiTable(scan_merged_records, merged_count);
+    // Derive strings and geometry once for every view (no lock needed); the UI
+    // publishes the snapshot and updates the graph, table and dashboard from it together.
+    // The waterfall, history and AP detail use this sweep's records rather than the persistent list
+    scanSnapshotBuild(scan_merged_records, merged_count);
+    event.count = ap_count;
+    event.has_snapshot = true;
+    uiBusPostEvent(&event);
+    perfMonitorScan(millis() - scan_start_time);
 }
 
+// Sample the AP on the detail screen: one channel, filtered to its BSSID, so
+// it is observed several times a second instead of once per full sweep
+void performApDetailScan()
+{
+    if (!scannerDetailActive()) return;
+    
+    wifi_scan_config_t scan_config = {};
+    scan_config.ssid = NULL;
+    scan_config.bssid = detail_bssid;
+    scan_config.channel = detail_channel;
+    scan_config.show_hidden = true;
+    scan_config.scan_type = WIFI_SCAN_TYPE_ACTIVE;
+    scan_config.scan_time.active.min = AP_DETAIL_SCAN_TIME_MS;
+    scan_config.scan_time.active.max = AP_DETAIL_SCAN_TIME_MS;
+    scan_config.scan_time.passive = AP_DETAIL_SCAN_TIME_MS;
+    
+    if (esp_wifi_scan_start(&scan_config, true) != ESP_OK) return;
+    if (!uiBusAcquireRecords(UI_BUS_RECORDS_WAIT_MS)) return;
+    
+    // A filtered scan returns at most a handful of records
+    static wifi_ap_record_t detail_records[4];
+    uint16_t count = sizeof(detail_records) / sizeof(detail_records[0]);
+    if (esp_wifi_scan_get_ap_records(&count, detail_records) != ESP_OK) count = 0;
+    UiEvent event = {UI_EVENT_DETAIL_SCAN, detail_records, count, false};
+    uiBusPostEvent(&event);
+}
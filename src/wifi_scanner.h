@@ -14,9 +14,13 @@ void printWiFiTableDebug(wifi_ap_record_t *ap_records, uint16_t ap_count);
 
 // Main scanning function
 void performWiFiScan();
+void performApDetailScan();
 
-// Scan time configuration (extern)
-extern uint16_t scan_time_per_channel_ms;
+// Scanner state (set by UI commands)
+void processScanCommands(uint32_t wait_ms);
+bool scannerPaused();
+bool scannerDetailActive();
+uint32_t scannerInterval();
 
 #endif // WIFI_SCANNER_H
 